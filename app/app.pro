@@ -0,0 +1,43 @@
+TEMPLATE = app
+TARGET = SpriteEditor
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+include(../spritecore/spritecore.pri)
+
+SOURCES += \
+    commandlinetool.cpp \
+    editorwindow.cpp \
+    main.cpp \
+    mainwindow.cpp \
+    previewwindow.cpp \
+    selectionoverlay.cpp \
+    shapeoverlay.cpp \
+    spritecanvas.cpp
+
+HEADERS += \
+    commandlinetool.h \
+    editorwindow.h \
+    mainwindow.h \
+    previewwindow.h \
+    selectionoverlay.h \
+    shapeoverlay.h \
+    spritecanvas.h
+
+FORMS += \
+    editorwindow.ui \
+    mainwindow.ui \
+    previewwindow.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,282 @@
+/**
+ * @file commandlinetool.cpp
+ * @brief Implementation of the CommandLineTool class for headless batch processing of .ssp files.
+ *
+ * Each file gets its own FrameManager and SaveLoadManager, so files are processed independently on a
+ * dedicated thread pool. Results are collected first and printed in the order the files were given.
+ *
+ * @date 03/31/2025
+ */
+
+#include "commandlinetool.h"
+#include "framemanager.h"
+#include "gifexporter.h"
+#include "saveloadmanager.h"
+#include "spritesheetexporter.h"
+#include "tracer.h"
+
+#include <QtConcurrent>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QSet>
+#include <QTextStream>
+#include <QThreadPool>
+
+/**
+ * @brief Subcommands understood by the tool.
+ */
+static const QStringList commands = {"load", "validate", "convert", "export-sheet", "export-gif", "stats", "help"};
+
+/**
+ * @brief Settings shared by every file of one run.
+ */
+struct CommandOptions {
+    QString command;
+    QString outputDir;
+    int framesPerSecond = 10;
+    bool dither = false;
+    bool csv = false;
+};
+
+/**
+ * @brief Outcome of processing one file.
+ */
+struct FileResult {
+    QString filePath;
+    bool success = false;
+    QString message;
+};
+
+/**
+ * @brief Builds the path of an output file from the input name, a suffix and the output directory.
+ */
+static QString outputPath(const CommandOptions& options, const QString& filePath, const QString& suffix) {
+    QFileInfo info(filePath);
+    QString directory = options.outputDir.isEmpty() ? info.absolutePath() : options.outputDir;
+    return QDir(directory).filePath(info.completeBaseName() + suffix);
+}
+
+/**
+ * @brief Applies the command to a single file.
+ */
+static FileResult processFile(const CommandOptions& options, const QString& filePath) {
+    FileResult result;
+    result.filePath = filePath;
+
+    SaveLoadManager saveLoadManager;
+    FrameManager frameManager(0, 0);
+
+    if (options.command == "validate") {
+        QStringList problems;
+        result.success = saveLoadManager.validateFile(filePath, problems);
+        result.message = result.success ? "valid" : problems.join("; ");
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!saveLoadManager.loadFromFile(frameManager, filePath) || frameManager.frames.empty()) {
+
+        // Only failures pay for a second read, which names what is wrong with the file
+        QStringList problems;
+        saveLoadManager.validateFile(filePath, problems);
+        result.message = problems.isEmpty() ? "failed to load" : "failed to load: " + problems.join("; ");
+        return result;
+    }
+
+    qint64 loadTime = timer.elapsed();
+
+    if (options.command == "load") {
+        result.success = true;
+        result.message = QString("loaded %1 frames of %2x%3 in %4 ms (%5 bytes)")
+                             .arg(frameManager.frames.size())
+                             .arg(frameManager.width)
+                             .arg(frameManager.height)
+                             .arg(loadTime)
+                             .arg(frameManager.memoryUsage().totalBytes());
+    }
+
+    else if (options.command == "convert") {
+
+        // Keep the .ssp extension so the editor can open the result; avoid overwriting the input
+        QString target = outputPath(options, filePath, options.outputDir.isEmpty() ? ".bin.ssp" : ".ssp");
+        result.success = saveLoadManager.saveToBinaryFile(frameManager, target);
+        DedupStatistics dedup = saveLoadManager.lastSaveDedup();
+        result.message = result.success ? QString("wrote %1 (%2 frames, %3 unique, dedup %4:1)")
+                                              .arg(target)
+                                              .arg(dedup.frameCount)
+                                              .arg(dedup.uniqueFrameCount)
+                                              .arg(dedup.ratio(), 0, 'f', 2)
+                                        : "failed to write " + target;
+    }
+
+    else if (options.command == "export-sheet") {
+        QString imagePath = outputPath(options, filePath, ".png");
+        QString metadataPath = outputPath(options, filePath, options.csv ? ".csv" : ".json");
+        SpriteSheetExporter exporter;
+        result.success = exporter.exportToFile(frameManager, imagePath, metadataPath);
+        result.message = result.success ? "wrote " + imagePath : "failed to write " + imagePath;
+    }
+
+    else if (options.command == "export-gif") {
+        QString gifPath = outputPath(options, filePath, ".gif");
+        GifExporter exporter;
+        result.success = exporter.exportToFile(frameManager, gifPath, options.framesPerSecond, options.dither);
+        result.message = result.success ? "wrote " + gifPath : "failed to write " + gifPath;
+    }
+
+    else if (options.command == "stats") {
+        QSet<QRgb> colors;
+        qint64 opaquePixels = 0;
+
+        for (const Frame& frame : frameManager.frames) {
+            for (int y = 0; y < frame.getHeight(); ++y) {
+                const QRgb* row = frame.constScanLine(y);
+
+                for (int x = 0; x < frame.getWidth(); ++x) {
+                    colors.insert(row[x]);
+                    opaquePixels += (qAlpha(row[x]) != 0) ? 1 : 0;
+                }
+            }
+        }
+
+        vector<int> uniqueFrames;
+        frameManager.findDuplicateFrames(uniqueFrames);
+
+        result.success = true;
+        result.message = QString("frames=%1 size=%2x%3 colors=%4 opaquePixels=%5 fileBytes=%6 loadMs=%7 memoryBytes=%8 uniqueFrames=%9")
+                             .arg(frameManager.frames.size())
+                             .arg(frameManager.width)
+                             .arg(frameManager.height)
+                             .arg(colors.size())
+                             .arg(opaquePixels)
+                             .arg(QFileInfo(filePath).size())
+                             .arg(loadTime)
+                             .arg(frameManager.memoryUsage().totalBytes())
+                             .arg(uniqueFrames.size());
+    }
+
+    return result;
+}
+
+CommandLineTool::CommandLineTool(QObject* parent) : QObject{parent} {}
+
+bool CommandLineTool::isCommand(int argc, char* argv[]) {
+    return argc > 1 && commands.contains(QString::fromLocal8Bit(argv[1]));
+}
+
+int CommandLineTool::run(QStringList arguments) {
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Batch processing for Sprite Editor .ssp files.\n\n"
+        "Commands:\n"
+        "  load          Load each file and report its size\n"
+        "  validate      Check that each file is well formed\n"
+        "  convert       Convert each file to the binary .ssp format\n"
+        "  export-sheet  Export each file as a PNG sprite sheet plus JSON or CSV metadata\n"
+        "  export-gif    Export each file as an animated GIF\n"
+        "  stats         Print frame, color and size statistics\n\n"
+        "Exit codes: 0 success, 1 a file failed, 2 usage error.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "The command to run.");
+    parser.addPositionalArgument("files", "The .ssp files to process.", "<file>...");
+
+    QCommandLineOption jobsOption({"j", "jobs"}, "Number of files processed in parallel.", "count");
+    QCommandLineOption outputOption({"o", "output-dir"}, "Directory for written files.", "dir");
+    QCommandLineOption fpsOption("fps", "GIF playback speed (default 10).", "fps", "10");
+    QCommandLineOption ditherOption("dither", "Apply ordered dithering to GIFs with more than 255 colors.");
+    QCommandLineOption csvOption("csv", "Write sprite sheet metadata as CSV instead of JSON.");
+    QCommandLineOption traceOption("trace", "Write a Chrome trace of the run (tracing builds only).", "file");
+    parser.addOptions({jobsOption, outputOption, fpsOption, ditherOption, csvOption, traceOption});
+
+    if (!parser.parse(arguments)) {
+        err << parser.errorText() << Qt::endl;
+        return exitUsageError;
+    }
+
+    QStringList positional = parser.positionalArguments();
+
+    if (parser.isSet("help") || positional.isEmpty() || positional.first() == "help") {
+        out << parser.helpText();
+        return positional.isEmpty() ? exitUsageError : exitSuccess;
+    }
+
+    CommandOptions options;
+    options.command = positional.takeFirst();
+    options.outputDir = parser.value(outputOption);
+    options.dither = parser.isSet(ditherOption);
+    options.csv = parser.isSet(csvOption);
+
+    bool validFps = false;
+    options.framesPerSecond = parser.value(fpsOption).toInt(&validFps);
+
+    if (!commands.contains(options.command)) {
+        err << "Unknown command: " << options.command << Qt::endl;
+        return exitUsageError;
+    }
+
+    if (!validFps || options.framesPerSecond < 1 || options.framesPerSecond > 100) {
+        err << "--fps must be between 1 and 100." << Qt::endl;
+        return exitUsageError;
+    }
+
+    if (positional.isEmpty()) {
+        err << "No input files given." << Qt::endl;
+        return exitUsageError;
+    }
+
+    if (!options.outputDir.isEmpty() && !QDir().mkpath(options.outputDir)) {
+        err << "Cannot create output directory: " << options.outputDir << Qt::endl;
+        return exitUsageError;
+    }
+
+    QThreadPool pool;
+    if (parser.isSet(jobsOption)) {
+        int jobs = parser.value(jobsOption).toInt();
+
+        if (jobs < 1) {
+            err << "--jobs must be at least 1." << Qt::endl;
+            return exitUsageError;
+        }
+        pool.setMaxThreadCount(jobs);
+    }
+
+    QList<FileResult> results = QtConcurrent::blockingMapped<QList<FileResult>>(&pool, positional, [&options](const QString& filePath) {
+        return processFile(options, filePath);
+    });
+
+    if (parser.isSet(traceOption)) {
+        if (!Tracer::isEnabled()) {
+            err << "Tracing is not compiled into this build; rebuild with CONFIG+=tracing." << Qt::endl;
+        }
+
+        else if (!Tracer::exportChromeTrace(parser.value(traceOption))) {
+            err << "Failed to write trace: " << parser.value(traceOption) << Qt::endl;
+        }
+    }
+
+    int failures = 0;
+
+    for (const FileResult& result : results) {
+        if (result.success) {
+            out << result.filePath << ": " << result.message << Qt::endl;
+        }
+
+        else {
+            err << result.filePath << ": " << result.message << Qt::endl;
+            failures++;
+        }
+    }
+
+    if (failures > 0) {
+        err << failures << " of " << results.size() << " files failed." << Qt::endl;
+        return exitFileFailed;
+    }
+    return exitSuccess;
+}
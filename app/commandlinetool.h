@@ -0,0 +1,68 @@
+#ifndef COMMANDLINETOOL_H
+#define COMMANDLINETOOL_H
+
+/**
+ * @file commandlinetool.h
+ * @brief Declaration of the CommandLineTool class, which runs batch operations on .ssp files without a GUI.
+ *
+ * The tool is used by main() when the first argument is a known subcommand. It only needs a
+ * QCoreApplication, so it runs on build servers without a display.
+ *
+ * @date 03/31/2025
+ */
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @class CommandLineTool
+ *
+ * @brief Parses a subcommand and applies it to every listed file in parallel.
+ *
+ * Exit codes: 0 when every file succeeded, 1 when at least one file failed, 2 for usage errors.
+ */
+class CommandLineTool : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Exit code when every file was processed successfully.
+     */
+    static const int exitSuccess = 0;
+
+    /**
+     * @brief Exit code when at least one file failed to load, validate or export.
+     */
+    static const int exitFileFailed = 1;
+
+    /**
+     * @brief Exit code for unknown commands, bad options or missing files.
+     */
+    static const int exitUsageError = 2;
+
+    /**
+     * @brief Constructs a CommandLineTool instance.
+     * @param parent Optional parent QObject.
+     */
+    explicit CommandLineTool(QObject* parent = nullptr);
+
+    /**
+     * @brief Returns true if the arguments ask for headless mode.
+     * @param argc Command-line argument count.
+     * @param argv Command-line argument values.
+     * @return true if argv[1] is one of the supported subcommands.
+     */
+    static bool isCommand(int argc, char* argv[]);
+
+    /**
+     * @brief Runs the subcommand given in the arguments.
+     * @param arguments All command-line arguments, including the program name.
+     * @return One of the exit codes above.
+     */
+    int run(QStringList arguments);
+
+};
+
+#endif // COMMANDLINETOOL_H
@@ -0,0 +1,2065 @@
+/**
+ * @file editorwindow.cpp
+ * @brief This file contains the implementation of the EditorWindow class,
+ * which provides the main interface for drawing, editing, saving, and managing
+ * sprite frames in the sprite editor application.
+ *
+ * The EditorWindow is responsible for capturing user input (mouse events, button clicks),
+ * performing canvas operations (draw, erase, invert, etc.), and communicating with the
+ * FrameManager and SaveLoadManager to persist sprite state.
+ *
+ * @date 03/31/2025
+ */
+
+#include "editorwindow.h"
+#include "ui_editorwindow.h"
+#include "canvasrenderer.h"
+#include "floodfill.h"
+#include "pixelblit.h"
+#include "previewwindow.h"
+#include "selectionoverlay.h"
+#include "shapeoverlay.h"
+#include "spritecanvas.h"
+#include "gifexporter.h"
+#include "imageimporter.h"
+#include "inbetweengenerator.h"
+#include "spritesheetexporter.h"
+#include "tracer.h"
+
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QResizeEvent>
+#include <QScrollBar>
+#include <QWheelEvent>
+#include <QtConcurrent>
+#include <QFileDialog>
+#include <QFutureWatcher>
+#include <QBuffer>
+#include <QClipboard>
+#include <QGuiApplication>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QMimeData>
+#include <QPainter>
+#include <QLocale>
+#include <QProgressDialog>
+#include <QString>
+#include <QTimer>
+
+#include <cstring>
+#include <memory>
+
+using std::vector;
+
+EditorWindow::EditorWindow(SaveLoadManager* saveLoadManager, FrameManager* frameManager, int width, int height, QWidget* parent) :
+    QMainWindow(parent),
+    ui(new Ui::EditorWindow),
+    spriteWidth(width),
+    spriteHeight(height)
+{
+    ui->setupUi(this);
+    latencyClock.start();
+
+    // Shapes and selections are previewed on layers above the canvas while they are dragged
+    shapeOverlay = new ShapeOverlay(ui->spriteCanvas);
+    selectionOverlay = new SelectionOverlay(ui->spriteCanvas);
+
+    // Let a click on the canvas give it focus, so arrow keys can nudge the selection
+    ui->spriteCanvas->setFocusPolicy(Qt::ClickFocus);
+
+    // Remember the form's layout; the canvas grows from it as the window is resized
+    for (QWidget* widget : ui->centralwidget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+        designGeometry.insert(widget, widget->geometry());
+        designSize = designSize.expandedTo(QSize(widget->geometry().right() + 1, widget->geometry().bottom() + 1));
+    }
+    designSize += QSize(ui->spriteCanvas->x(), ui->spriteCanvas->y());
+
+    this->saveLoadManager = saveLoadManager;
+    this->frameManager = frameManager;
+
+    // The frame stack shows the frame manager's frames through a model, so rows are only laid out when seen
+    frameModel = new FrameListModel(frameManager, this);
+    ui->frameStackWidget->setModel(frameModel);
+
+    // Create the logical pixel grid (sprite image) using ARGB (supports transparency)
+    sprite = QImage(spriteWidth, spriteHeight, QImage::Format_ARGB32);
+
+    // Set background color to dark gray
+    sprite.fill(QColor(100, 100, 100, 50));
+
+    // Draw initial sprite image on the canvas, and again whenever the canvas changes size
+    updateCanvas();
+
+    connect(ui->spriteCanvas,
+            &SpriteCanvas::resized,
+            this,
+            &EditorWindow::onCanvasResized
+    );
+
+    // Set up the canvas to handle mouse clicks
+    ui->spriteCanvas->installEventFilter(this);
+
+    color = QColor::fromRgb(0, 0, 0, 255);
+
+    // Connect "Invert" button to inverting all pixel colors on the canvas
+    connect(ui->invertButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::invertColor
+    );
+
+    // Connect "Copy Color" button to enable color picking mode
+    connect(ui->copyButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableCopyColor
+    );
+
+    // Connect "Eraser" button to enable eraser mode
+    connect(ui->eraserButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableEraser
+    );
+
+    // Connect "Draw" button to enable drawing mode
+    connect(ui->drawButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableDrawing
+    );
+
+    // Connect "Fill" button to enable bucket fill mode
+    connect(ui->fillButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableFill
+    );
+
+    // Connect brush size changes to rebuilding the brush mask
+    connect(ui->brushSizeSpinBox,
+            &QSpinBox::valueChanged,
+            this,
+            &EditorWindow::updateBrush
+    );
+
+    // Connect the round brush toggle to rebuilding the brush mask
+    connect(ui->roundBrushCheckBox,
+            &QCheckBox::toggled,
+            this,
+            &EditorWindow::updateBrush
+    );
+
+    // Connect "Select" button to enable the rectangular selection tool
+    connect(ui->selectButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableSelect
+    );
+
+    // Connect "Cut" menu action to cut the selection to the clipboard
+    connect(ui->actionCut,
+            &QAction::triggered,
+            this,
+            &EditorWindow::cutSelection
+    );
+
+    // Connect "Copy" menu action to copy the selection to the clipboard
+    connect(ui->actionCopy,
+            &QAction::triggered,
+            this,
+            &EditorWindow::copySelection
+    );
+
+    // Connect "Paste" menu action to paste the clipboard as a floating selection
+    connect(ui->actionPaste,
+            &QAction::triggered,
+            this,
+            &EditorWindow::pasteSelection
+    );
+
+    // Connect "Delete Selection" menu action to clear the selected pixels
+    connect(ui->actionDeleteSelection,
+            &QAction::triggered,
+            this,
+            &EditorWindow::deleteSelection
+    );
+
+    // Connect "Select All" menu action to select the whole sprite
+    connect(ui->actionSelectAll,
+            &QAction::triggered,
+            this,
+            &EditorWindow::selectAll
+    );
+
+    // Connect "Deselect" menu action to commit and drop the selection
+    connect(ui->actionDeselect,
+            &QAction::triggered,
+            this,
+            &EditorWindow::deselect
+    );
+
+    // Connect "Line" button to enable the line tool
+    connect(ui->lineButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableLine
+    );
+
+    // Connect "Rectangle" button to enable the rectangle tool
+    connect(ui->rectangleButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableRectangle
+    );
+
+    // Connect "Ellipse" button to enable the ellipse tool
+    connect(ui->ellipseButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::enableEllipse
+    );
+
+    // Connect red spinbox changes to update the current color's red component
+    connect(ui->redSpinBox,
+            &QSpinBox::valueChanged,
+            this,
+            &EditorWindow::redChanged
+    );
+
+    // Connect blue spinbox changes to update the current color's blue component
+    connect(ui->blueSpinBox,
+            &QSpinBox::valueChanged,
+            this,
+            &EditorWindow::blueChanged
+    );
+
+    // Connect green spinbox changes to update the current color's green component
+    connect(ui->greenSpinBox,
+            &QSpinBox::valueChanged,
+            this,
+            &EditorWindow::greenChanged
+    );
+
+    // Connect alpha spinbox changes to update the current color's transparency
+    connect(ui->alphaSpinBox,
+            &QSpinBox::valueChanged,
+            this,
+            &EditorWindow::alphaChanged
+    );
+
+    // Connect color picker mode to update red spinbox value
+    connect(this,
+            &EditorWindow::changeRedValue,
+            ui->redSpinBox,
+            &QSpinBox::setValue
+    );
+
+    // Connect color picker mode to update green spinbox value
+    connect(this,
+            &EditorWindow::changeGreenValue,
+            ui->greenSpinBox,
+            &QSpinBox::setValue
+    );
+
+    // Connect color picker mode to update blue spinbox value
+    connect(this,
+            &EditorWindow::changeBlueValue,
+            ui->blueSpinBox,
+            &QSpinBox::setValue
+    );
+
+    // Connect color picker mode to update alpha spinbox value
+    connect(this,
+            &EditorWindow::changeAlphaValue,
+            ui->alphaSpinBox,
+            &QSpinBox::setValue
+    );
+
+    // Connect startup signal to add one blank frame to match canvas
+    connect(this,
+            &EditorWindow::addOneFrame,
+            frameManager,
+            &FrameManager::addFrame
+    );
+
+    // Connect "Add Frame" button to appending a blank frame to the stack
+    connect(ui->addFrameButton,
+            &QPushButton::clicked,
+            frameManager,
+            &FrameManager::addFrame
+    );
+
+    // Connect frames dragged within the frame stack to committing the floating selection while its frame is still in place
+    connect(frameModel,
+            &FrameListModel::framesAboutToMove,
+            this,
+            &EditorWindow::commitSelection
+    );
+
+    // Connect "Delete Frame" button to delete the selected frame from UI
+    connect(ui->deleteFrameButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::deleteFrameFromStack
+    );
+
+    // Connect delete frame signal to frame manager to delete model data
+    connect(this,
+            &EditorWindow::deleteFrame,
+            frameManager,
+            &FrameManager::deleteFrame
+    );
+
+    // Connect pixel update signal to update the selected frame in the model
+    connect(this,
+            &EditorWindow::updatePixelInFrame,
+            frameManager,
+            &FrameManager::updateFrame
+    );
+
+    // Connect batched region update signal to copy changed areas into the selected frame
+    connect(this,
+            &EditorWindow::updateRegionInFrame,
+            frameManager,
+            &FrameManager::updateFrameRegion
+    );
+
+    // Connect the same updates to keeping the zoomed-out mipmaps current
+    connect(this,
+            &EditorWindow::updateRegionInFrame,
+            this,
+            &EditorWindow::onSpriteRegionChanged
+    );
+
+    // Connect frame selection change to reloading that frame on the canvas
+    connect(ui->frameStackWidget->selectionModel(),
+            &QItemSelectionModel::currentChanged,
+            this,
+            &EditorWindow::getSelectedFrame
+    );
+
+    // Connect a frame changed by the manager itself to repaint the canvas
+    connect(frameManager,
+            &FrameManager::foundFrame,
+            this,
+            &EditorWindow::switchCanvas
+    );
+
+    // Connect "Duplicate Frame" button to emit copy request
+    connect(ui->duplicateFrameButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::getSelectedFrameToCopy
+    );
+
+    // Connect copy request signal to frame manager's copy function
+    connect(this,
+            &EditorWindow::selectedFrameToCopy,
+            frameManager,
+            &FrameManager::copyFrameTo
+    );
+
+    // Connect "Rotate" button to rotating the selected frames
+    connect(ui->rotateButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::rotateFrames
+    );
+
+    // Connect "Save" button to trigger file save dialog and operation
+    connect(ui->saveButton,
+            &QPushButton::clicked,
+            this,
+            &EditorWindow::onSaveButtonClicked
+    );
+
+    // Connect "Import Image" menu action to the image import dialog
+    connect(ui->actionImportImage,
+            &QAction::triggered,
+            this,
+            &EditorWindow::onImportImageClicked
+    );
+
+    // Connect "Export Sprite Sheet" menu action to the atlas export dialog
+    connect(ui->actionExportSpriteSheet,
+            &QAction::triggered,
+            this,
+            &EditorWindow::onExportSpriteSheetClicked
+    );
+
+    // Connect "Export Animated GIF" menu action to the GIF export dialog
+    connect(ui->actionExportGif,
+            &QAction::triggered,
+            this,
+            &EditorWindow::onExportGifClicked
+    );
+
+    // Connect "Export Performance Trace" menu action; only useful when tracing is compiled in
+    connect(ui->actionExportTrace,
+            &QAction::triggered,
+            this,
+            &EditorWindow::onExportTraceClicked
+    );
+    ui->actionExportTrace->setEnabled(Tracer::isEnabled());
+
+    // Connect the View menu zoom actions
+    connect(ui->actionZoomIn,
+            &QAction::triggered,
+            this,
+            &EditorWindow::zoomIn
+    );
+
+    connect(ui->actionZoomOut,
+            &QAction::triggered,
+            this,
+            &EditorWindow::zoomOut
+    );
+
+    connect(ui->actionZoomToFit,
+            &QAction::triggered,
+            this,
+            &EditorWindow::zoomToFit
+    );
+
+    // Connect "Show Latency HUD" menu action to redraw the canvas with or without the overlay
+    connect(ui->actionShowLatencyHud,
+            &QAction::toggled,
+            this,
+            &EditorWindow::updateCanvas
+    );
+
+    // Connect the Frames menu actions to running them over the selected frames
+    connect(ui->actionInvertFrames,
+            &QAction::triggered,
+            this,
+            &EditorWindow::invertColor
+    );
+
+    connect(ui->actionRotateFrames,
+            &QAction::triggered,
+            this,
+            &EditorWindow::rotateFrames
+    );
+
+    connect(ui->actionFlipHorizontal,
+            &QAction::triggered,
+            this,
+            &EditorWindow::flipFramesHorizontal
+    );
+
+    connect(ui->actionFlipVertical,
+            &QAction::triggered,
+            this,
+            &EditorWindow::flipFramesVertical
+    );
+
+    // Connect the size actions, which always apply to the whole sprite
+    connect(ui->actionResizeCanvas,
+            &QAction::triggered,
+            this,
+            &EditorWindow::resizeCanvas
+    );
+
+    connect(ui->actionScaleSprite,
+            &QAction::triggered,
+            this,
+            &EditorWindow::scaleSprite
+    );
+
+    // Connect "Generate In-Betweens" menu action to filling in motion between the selected frames
+    connect(ui->actionGenerateInbetweens,
+            &QAction::triggered,
+            this,
+            &EditorWindow::generateInbetweens
+    );
+
+    // Connect "Set Frame Duration" menu action to changing how long the selected frames are shown
+    connect(ui->actionSetFrameDuration,
+            &QAction::triggered,
+            this,
+            &EditorWindow::setFrameDuration
+    );
+
+    // Connect "Undo" and "Redo" menu actions to the frame manager's history
+    connect(ui->actionUndo,
+            &QAction::triggered,
+            this,
+            &EditorWindow::undo
+    );
+
+    connect(ui->actionRedo,
+            &QAction::triggered,
+            this,
+            &EditorWindow::redo
+    );
+
+    // Keep the Undo and Redo actions named after the steps they would apply
+    connect(frameManager,
+            &FrameManager::undoHistoryChanged,
+            this,
+            &EditorWindow::updateUndoActions
+    );
+    updateUndoActions();
+
+    // Connect resizing to recreating the canvas image before the frames are reloaded into it
+    connect(frameManager,
+            &FrameManager::framesResized,
+            this,
+            &EditorWindow::onFramesResized
+    );
+
+    // Connect batch changes, undo and redo to reloading the canvas when the current frame changed
+    connect(frameManager,
+            &FrameManager::framesChanged,
+            this,
+            &EditorWindow::onFramesChanged
+    );
+
+    batchRunner = new FrameBatchRunner(frameManager, this);
+
+    // Show a thumbnail per frame in the frame stack, rendered in the background
+    ui->frameStackWidget->setIconSize(QSize(48, 48));
+    thumbnails = new ThumbnailCache(frameManager, ui->frameStackWidget->iconSize(), this);
+
+    connect(thumbnails,
+            &ThumbnailCache::thumbnailReady,
+            frameModel,
+            &FrameListModel::setThumbnail
+    );
+
+    // Refresh thumbnails once frame changes settle, rather than on every added frame or stroke
+    thumbnailTimer = new QTimer(this);
+    thumbnailTimer->setSingleShot(true);
+    thumbnailTimer->setInterval(100);
+
+    connect(thumbnailTimer,
+            &QTimer::timeout,
+            this,
+            &EditorWindow::refreshThumbnails
+    );
+
+    // Connect committed edits, undo and redo, which all change the undo history, to a refresh
+    connect(frameManager,
+            &FrameManager::undoHistoryChanged,
+            thumbnailTimer,
+            [this]() { thumbnailTimer->start(); }
+    );
+
+    // Connect added frames, such as while a file loads, to a refresh
+    connect(frameManager,
+            &FrameManager::frameAdded,
+            thumbnailTimer,
+            [this]() { thumbnailTimer->start(); }
+    );
+
+    // Connect scrolling the frame stack to rendering the rows that came into view
+    connect(ui->frameStackWidget->verticalScrollBar(),
+            &QScrollBar::valueChanged,
+            thumbnailTimer,
+            [this]() { thumbnailTimer->start(); }
+    );
+
+    // Connect "Memory Budget" menu action to the budget dialog
+    connect(ui->actionMemoryBudget,
+            &QAction::triggered,
+            this,
+            &EditorWindow::onMemoryBudgetClicked
+    );
+
+    // Show memory use in the status bar, refreshed once a second
+    memoryLabel = new QLabel(this);
+    ui->statusbar->addPermanentWidget(memoryLabel);
+
+    QTimer* memoryTimer = new QTimer(this);
+    connect(memoryTimer,
+            &QTimer::timeout,
+            this,
+            &EditorWindow::updateMemoryUsage
+    );
+    memoryTimer->start(1000);
+    updateMemoryUsage();
+
+}
+
+EditorWindow::~EditorWindow() {
+    delete ui;
+}
+
+void EditorWindow::invertColor() {
+    runFrameOperation(FrameBatchRunner::invertColors, "Invert Colors");
+}
+
+void EditorWindow::rotateFrames() {
+    if (spriteWidth != spriteHeight) {
+        QMessageBox::warning(this, "Rotate", "Only square sprites can be rotated.");
+        return;
+    }
+    runFrameOperation(FrameBatchRunner::rotate90Clockwise, "Rotate");
+}
+
+void EditorWindow::flipFramesHorizontal() {
+    runFrameOperation(FrameBatchRunner::flipHorizontal, "Flip Horizontal");
+}
+
+void EditorWindow::flipFramesVertical() {
+    runFrameOperation(FrameBatchRunner::flipVertical, "Flip Vertical");
+}
+
+void EditorWindow::resizeCanvas() {
+    if (batchRunner->isRunning()) {
+        return;
+    }
+
+    bool ok = false;
+    int width = QInputDialog::getInt(this, "Resize Canvas", "Width:", spriteWidth, 1, 4096, 1, &ok);
+    int height = ok ? QInputDialog::getInt(this, "Resize Canvas", "Height:", spriteHeight, 1, 4096, 1, &ok) : 0;
+
+    if (!ok) {
+        return;
+    }
+
+    // Listed in the same order as SpriteResampler::Anchor
+    QStringList anchors = {"Top left", "Top", "Top right", "Left", "Center", "Right", "Bottom left", "Bottom", "Bottom right"};
+    QString anchor = QInputDialog::getItem(this, "Resize Canvas", "Keep in place:", anchors, SpriteResampler::Center, false, &ok);
+
+    if (!ok) {
+        return;
+    }
+
+    // Floating pixels must be part of the frames before they are resized
+    commitSelection();
+    frameManager->resizeCanvas(height, width, static_cast<SpriteResampler::Anchor>(anchors.indexOf(anchor)));
+}
+
+void EditorWindow::scaleSprite() {
+    if (batchRunner->isRunning()) {
+        return;
+    }
+
+    bool ok = false;
+    int width = QInputDialog::getInt(this, "Scale Sprite", "Width:", spriteWidth * 2, 1, 4096, 1, &ok);
+    int height = ok ? QInputDialog::getInt(this, "Scale Sprite", "Height:", spriteHeight * 2, 1, 4096, 1, &ok) : 0;
+
+    if (!ok) {
+        return;
+    }
+
+    // Listed in the same order as SpriteResampler::Method
+    QStringList methods = {"Nearest neighbor", "Scale2x (EPX)", "Scale3x", "Box (for shrinking)"};
+    int suggested = (width < spriteWidth || height < spriteHeight) ? SpriteResampler::Box : SpriteResampler::Nearest;
+    QString method = QInputDialog::getItem(this, "Scale Sprite", "Resampling:", methods, suggested, false, &ok);
+
+    if (!ok) {
+        return;
+    }
+
+    commitSelection();
+    frameManager->scaleFrames(height, width, static_cast<SpriteResampler::Method>(methods.indexOf(method)));
+}
+
+void EditorWindow::generateInbetweens() {
+    if (batchRunner->isRunning()) {
+        return;
+    }
+
+    QModelIndexList selected = ui->frameStackWidget->selectionModel()->selectedIndexes();
+
+    if (selected.size() < 2) {
+        QMessageBox::information(this, "Generate In-Betweens", "Select the two key frames to generate frames between.");
+        return;
+    }
+
+    // The first and last selected frames are the key frames
+    int first = selected.first().row();
+    int last = first;
+
+    for (const QModelIndex& index : selected) {
+        first = qMin(first, index.row());
+        last = qMax(last, index.row());
+    }
+
+    bool ok = false;
+    int count = QInputDialog::getInt(this, "Generate In-Betweens", "Number of in-between frames:", 3, 1, 64, 1, &ok);
+
+    if (!ok) {
+        return;
+    }
+
+    // Listed in the same order as InbetweenGenerator::Mode
+    QStringList modes = {"Cross-fade", "Dithered blend", "Translate first frame by offset"};
+    QString choice = QInputDialog::getItem(this, "Generate In-Betweens", "Mode:", modes, 0, false, &ok);
+
+    if (!ok) {
+        return;
+    }
+
+    InbetweenGenerator::Mode mode = static_cast<InbetweenGenerator::Mode>(modes.indexOf(choice));
+    QPoint offset;
+
+    if (mode == InbetweenGenerator::Translate) {
+        offset.setX(QInputDialog::getInt(this, "Generate In-Betweens", "Horizontal offset:", 0, -spriteWidth, spriteWidth, 1, &ok));
+
+        if (ok) {
+            offset.setY(QInputDialog::getInt(this, "Generate In-Betweens", "Vertical offset:", 0, -spriteHeight, spriteHeight, 1, &ok));
+        }
+
+        if (!ok) {
+            return;
+        }
+    }
+
+    // Floating pixels must be part of the key frames before they are read
+    commitSelection();
+
+    vector<Frame> inbetweens = InbetweenGenerator::generate(frameManager->frames[first], frameManager->frames[last], count, mode, offset);
+
+    // The in-betweens go right in front of the second key frame
+    if (frameManager->insertFrames(last, std::move(inbetweens))) {
+        ui->frameStackWidget->setCurrentIndex(frameModel->index(last));
+    }
+}
+
+void EditorWindow::setFrameDuration() {
+    int first, last;
+    getSelectedFrameRange(first, last);
+
+    if (first < 0) {
+        return;
+    }
+
+    bool ok = false;
+    int duration = QInputDialog::getInt(this, "Set Frame Duration", "Duration in milliseconds (0 follows the playback speed):",
+                                        frameManager->frameDuration(first), 0, FrameManager::maximumFrameDuration, 10, &ok);
+
+    if (!ok) {
+        return;
+    }
+
+    for (int frameIndex = first; frameIndex <= last; ++frameIndex) {
+        frameManager->setFrameDuration(frameIndex, duration);
+    }
+}
+
+void EditorWindow::runFrameOperation(FrameBatchRunner::Operation operation, const QString& description) {
+    if (batchRunner->isRunning()) {
+        return;
+    }
+
+    // Floating pixels must be part of the frames before they are copied
+    commitSelection();
+
+    int first, last;
+    getSelectedFrameRange(first, last);
+
+    // The dialog is modal, so the frames cannot be edited while the batch runs
+    QProgressDialog* progress = new QProgressDialog(description + "...", "Cancel", 0, last - first + 1, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+
+    // Connect the runner's progress to the progress bar
+    connect(batchRunner,
+            &FrameBatchRunner::progressChanged,
+            progress,
+            [progress](int completed, int total) {
+                progress->setMaximum(total);
+                progress->setValue(completed);
+            }
+    );
+
+    // Connect the dialog's "Cancel" button to dropping the batch
+    connect(progress,
+            &QProgressDialog::canceled,
+            batchRunner,
+            &FrameBatchRunner::cancel
+    );
+
+    // Close the dialog when the batch is committed or cancelled
+    connect(batchRunner,
+            &FrameBatchRunner::finished,
+            progress,
+            &QProgressDialog::deleteLater
+    );
+
+    if (!batchRunner->start(first, last, std::move(operation), description)) {
+        progress->deleteLater();
+    }
+}
+
+void EditorWindow::getSelectedFrameRange(int& first, int& last) {
+    int count = static_cast<int>(frameManager->frames.size());
+
+    if (ui->actionApplyToAllFrames->isChecked()) {
+        first = 0;
+        last = count - 1;
+        return;
+    }
+
+    first = last = getCurrentFrameIndex();
+
+    for (const QModelIndex& index : ui->frameStackWidget->selectionModel()->selectedIndexes()) {
+        first = qMin(first, index.row());
+        last = qMax(last, index.row());
+    }
+
+    last = qMin(last, count - 1);
+}
+
+void EditorWindow::undo() {
+    if (mousePressed || batchRunner->isRunning()) {
+        return;
+    }
+
+    commitSelection();
+    frameManager->undo();
+}
+
+void EditorWindow::redo() {
+    if (mousePressed || batchRunner->isRunning()) {
+        return;
+    }
+
+    commitSelection();
+    frameManager->redo();
+}
+
+void EditorWindow::updateUndoActions() {
+    ui->actionUndo->setEnabled(frameManager->canUndo());
+    ui->actionUndo->setText(frameManager->canUndo() ? "Undo " + frameManager->undoText() : "Undo");
+    ui->actionRedo->setEnabled(frameManager->canRedo());
+    ui->actionRedo->setText(frameManager->canRedo() ? "Redo " + frameManager->redoText() : "Redo");
+}
+
+void EditorWindow::refreshThumbnails() {
+    QRect viewport = ui->frameStackWidget->viewport()->rect();
+    QModelIndex firstVisible = ui->frameStackWidget->indexAt(viewport.topLeft());
+    QModelIndex lastVisible = ui->frameStackWidget->indexAt(viewport.bottomLeft());
+
+    // Only the rows on screen are rendered; scrolling refreshes the rows that come into view
+    int first = firstVisible.isValid() ? firstVisible.row() : 0;
+    int last = lastVisible.isValid() ? lastVisible.row() : frameModel->rowCount() - 1;
+    thumbnails->refresh(first, qMax(first, last));
+}
+
+void EditorWindow::onFramesChanged(int first, int last) {
+    int frameIndex = getCurrentFrameIndex();
+
+    if (frameIndex >= first && frameIndex <= last) {
+        showFrame(frameIndex);
+    }
+}
+
+void EditorWindow::onFramesResized(int height, int width) {
+    discardSelection();
+    spriteWidth = width;
+    spriteHeight = height;
+
+    // The frames are reloaded into the new image by the framesChanged() that follows
+    sprite = QImage(spriteWidth, spriteHeight, QImage::Format_ARGB32);
+    sprite.fill(QColor(255, 255, 255, 0));
+    fitToWindow = true;
+    redrawAll = true;
+    markSpriteChanged(sprite.rect());
+    updateCanvas();
+}
+
+void EditorWindow::redChanged(int value) {
+    color.setRed(value);
+    ui->colorPreview->setStyleSheet("QLabel { background-color: " + color.name(QColor::HexArgb) + "; }");
+}
+
+void EditorWindow::blueChanged(int value) {
+    color.setBlue(value);
+    ui->colorPreview->setStyleSheet("QLabel { background-color: " + color.name(QColor::HexArgb) + "; }");
+}
+
+void EditorWindow::greenChanged(int value) {
+    color.setGreen(value);
+    ui->colorPreview->setStyleSheet("QLabel { background-color: " + color.name(QColor::HexArgb) + "; }");
+}
+
+void EditorWindow::alphaChanged(int value) {
+    color.setAlpha(value);
+    ui->colorPreview->setStyleSheet("QLabel { background-color: " + color.name(QColor::HexArgb) + "; }");
+}
+
+void EditorWindow::enableDrawing() {
+    isDrawing = true;
+    isErasing = false;
+    isGettingColor = false;
+    isFilling = false;
+    isDrawingShape = false;
+    isSelecting = false;
+}
+
+void EditorWindow::enableEraser() {
+    isErasing = true;
+    isDrawing = false;
+    isGettingColor = false;
+    isFilling = false;
+    isDrawingShape = false;
+    isSelecting = false;
+}
+
+void EditorWindow::enableCopyColor() {
+    isGettingColor = true;
+    isDrawing = false;
+    isErasing = false;
+    isFilling = false;
+    isDrawingShape = false;
+    isSelecting = false;
+}
+
+void EditorWindow::enableFill() {
+    isFilling = true;
+    isDrawing = false;
+    isErasing = false;
+    isGettingColor = false;
+    isDrawingShape = false;
+    isSelecting = false;
+}
+
+void EditorWindow::enableLine() {
+    enableShape(ShapeRasterizer::Line);
+}
+
+void EditorWindow::enableRectangle() {
+    enableShape(ShapeRasterizer::Rectangle);
+}
+
+void EditorWindow::enableEllipse() {
+    enableShape(ShapeRasterizer::Ellipse);
+}
+
+void EditorWindow::enableShape(ShapeRasterizer::Shape shape) {
+    isDrawingShape = true;
+    isDrawing = false;
+    isErasing = false;
+    isGettingColor = false;
+    isFilling = false;
+    isSelecting = false;
+    currentShape = shape;
+}
+
+void EditorWindow::enableSelect() {
+    isSelecting = true;
+    isDrawing = false;
+    isErasing = false;
+    isGettingColor = false;
+    isFilling = false;
+    isDrawingShape = false;
+}
+
+void EditorWindow::animateClicked() {
+    commitSelection();
+
+    PreviewWindow *preview = new PreviewWindow(frameManager, spriteHeight, spriteWidth, this);
+
+    // Remember the preview speed so exported GIFs play at the same rate
+    connect(preview,
+            &PreviewWindow::fpsChanged,
+            this,
+            &EditorWindow::setPreviewFps
+    );
+
+    preview->show();
+}
+
+void EditorWindow::deleteFrameFromStack() {
+    commitSelection();
+
+    QModelIndex selectedIndex = ui->frameStackWidget->currentIndex();
+
+    if (selectedIndex.isValid()) {
+
+        // There should always be at least 1 frame; the model removes the row
+        if (frameModel->rowCount() > 1) {
+            emit deleteFrame(selectedIndex.row());
+        }
+    }
+}
+
+void EditorWindow::switchCanvas(const Frame& frame) {
+    TRACE_SCOPE("EditorWindow::switchCanvas");
+
+    // Floating pixels belong to the frame being left
+    commitSelection();
+
+    if (frame.getHeight() != sprite.height() || frame.getWidth() != sprite.width()) {
+        qWarning() << "EditorWindow::switchCanvas: frame size does not match the canvas";
+        return;
+    }
+
+    // The frame and the sprite are both ARGB32, so each row is one copy
+    size_t rowBytes = static_cast<size_t>(sprite.width()) * sizeof(QRgb);
+
+    for (int y = 0; y < sprite.height(); ++y) {
+        memcpy(sprite.scanLine(y), frame.constScanLine(y), rowBytes);
+    }
+
+    markSpriteChanged(sprite.rect());
+    updateCanvas();
+}
+
+void EditorWindow::showFrame(int frameIndex) {
+    switchCanvas(frameManager->frames.at(frameIndex));
+    frameManager->setActiveFrame(frameIndex);
+}
+
+void EditorWindow::getSelectedFrame() {
+    QModelIndex selectedIndex = ui->frameStackWidget->currentIndex();
+
+    if (selectedIndex.isValid()) {
+        showFrame(selectedIndex.row());
+    }
+}
+
+void EditorWindow::getSelectedFrameToCopy() {
+    commitSelection();
+
+    QModelIndex selectedIndex = ui->frameStackWidget->currentIndex();
+
+    if (selectedIndex.isValid()) {
+        emit selectedFrameToCopy(selectedIndex.row(), selectedIndex.row() + 1);
+    }
+}
+
+void EditorWindow::setSpriteWidth(int width) {
+    spriteWidth = width;
+}
+
+void EditorWindow::setSpriteHeight(int height) {
+    spriteHeight = height;
+}
+
+void EditorWindow::initializeFromLoadedFile(int width, int height) {
+    discardSelection();
+    frameManager->clearUndoHistory();
+    spriteWidth = width;
+    spriteHeight = height;
+
+    // Create and clear canvas image, fitted to the window again
+    sprite = QImage(spriteWidth, spriteHeight, QImage::Format_ARGB32);
+    sprite.fill(QColor(255, 255, 255, 0));
+    fitToWindow = true;
+    redrawAll = true;
+    markSpriteChanged(sprite.rect());
+
+    // The model already has the loaded frames' rows; they have no thumbnails yet
+    thumbnails->forgetShown();
+
+    // Trigger canvas to draw first frame
+    ui->frameStackWidget->setCurrentIndex(frameModel->index(0));
+    showFrame(0);
+}
+
+void EditorWindow::reinitializeEditor(int newWidth, int newHeight) {
+    discardSelection();
+    frameManager->clearUndoHistory();
+    spriteWidth = newWidth;
+    spriteHeight = newHeight;
+
+    // Resize sprite image, fitted to the window again
+    sprite = QImage(spriteWidth, spriteHeight, QImage::Format_ARGB32);
+    sprite.fill(QColor(255, 255, 255, 0));
+    fitToWindow = true;
+    redrawAll = true;
+    markSpriteChanged(sprite.rect());
+
+    frameManager->clearFrames();
+    frameManager->height = newHeight;
+    frameManager->width = newWidth;
+    thumbnails->forgetShown();
+    emit addOneFrame(); // Add 1 new blank frame
+
+    updateCanvas();
+}
+
+void EditorWindow::updateCanvas() {
+    TRACE_SCOPE("EditorWindow::updateCanvas");
+    qint64 repaintStart = latencyClock.nsecsElapsed();
+    QImage& canvas = ui->spriteCanvas->image();
+
+    // The backing image only exists once the canvas has been laid out
+    if (canvas.isNull()) {
+        return;
+    }
+
+    if (fitToWindow) {
+        view = CanvasView::fit(canvas.size(), sprite.size());
+    }
+
+    // The mipmaps are only read zoomed out, so edits made zoomed in are folded in on the way out
+    if (view.scale() < 1.0 && (!mipmapDirty.isEmpty() || mipmaps.spriteSize() != sprite.size())) {
+        mipmaps.update(sprite, mipmapDirty);
+        mipmapDirty = QRect();
+    }
+
+    // Redraw only the edited cells, grown by a pixel for zoomed-out sampling and the closing grid line
+    QRect area = canvasDirty.isEmpty() ? QRect() : view.cellRect(canvasDirty).adjusted(-1, -1, 1, 1);
+
+    if (redrawAll || view != drawnView) {
+        area = canvas.rect();
+    }
+
+    // Clear the old HUD; outside that area the canvas is already current, so the new one can go on top
+    area |= hudArea;
+    hudArea = QRect();
+
+    CanvasRenderer::render(canvas, sprite, view, true, &mipmaps, area);
+    redrawAll = false;
+    drawnView = view;
+    canvasDirty = QRect();
+
+    if (ui->actionShowLatencyHud->isChecked()) {
+        hudArea = drawLatencyHud(canvas);
+        area |= hudArea;
+    }
+
+    ui->spriteCanvas->update(area);
+    repaintTimes.addSample(repaintStart, latencyClock.nsecsElapsed() - repaintStart);
+}
+
+void EditorWindow::onCanvasResized() {
+    redrawAll = true;
+    updateCanvas();
+    updateSelectionOverlay();
+
+    if (shapeInProgress) {
+        updateShapePreview();
+    }
+}
+
+void EditorWindow::resizeEvent(QResizeEvent* event) {
+    QMainWindow::resizeEvent(event);
+
+    // Extra room goes to the canvas; controls right of or below it keep their distance to the edge
+    QRect canvasDesign = designGeometry.value(ui->spriteCanvas);
+    QSize extra = (ui->centralwidget->size() - designSize).expandedTo(QSize(0, 0));
+
+    for (auto it = designGeometry.cbegin(); it != designGeometry.cend(); ++it) {
+        QRect geometry = it.value();
+
+        if (it.key() == ui->spriteCanvas) {
+            geometry.adjust(0, 0, extra.width(), extra.height());
+        }
+
+        else {
+            geometry.translate(geometry.left() > canvasDesign.right() ? extra.width() : 0,
+                               geometry.top() > canvasDesign.bottom() ? extra.height() : 0);
+        }
+        it.key()->setGeometry(geometry);
+    }
+}
+
+void EditorWindow::markSpriteChanged(const QRect& area) {
+    mipmapDirty |= area;
+    canvasDirty |= area;
+}
+
+void EditorWindow::onSpriteRegionChanged(int, const QImage&, const QRegion& region) {
+    markSpriteChanged(region.boundingRect());
+}
+
+void EditorWindow::setView(const CanvasView& newView) {
+    fitToWindow = false;
+    view = newView;
+    updateCanvas();
+    updateSelectionOverlay();
+
+    if (shapeInProgress) {
+        updateShapePreview();
+    }
+}
+
+void EditorWindow::zoomAt(QPoint anchor, int steps) {
+    setView(view.zoomedAt(anchor, steps));
+}
+
+void EditorWindow::zoomIn() {
+    zoomAt(ui->spriteCanvas->rect().center(), 1);
+}
+
+void EditorWindow::zoomOut() {
+    zoomAt(ui->spriteCanvas->rect().center(), -1);
+}
+
+void EditorWindow::zoomToFit() {
+    fitToWindow = true;
+    updateCanvas();
+    updateSelectionOverlay();
+
+    if (shapeInProgress) {
+        updateShapePreview();
+    }
+}
+
+QRect EditorWindow::drawLatencyHud(QImage& canvas) {
+    auto toMs = [](qint64 nanoseconds) {
+        return QString::number(nanoseconds / 1.0e6, 'f', 2);
+    };
+
+    // Events handled during the last second, counted from the latency samples themselves
+    qint64 oneSecondAgo = latencyClock.nsecsElapsed() - 1000000000;
+
+    QStringList lines;
+    lines << QString("input  p50 %1  p95 %2  p99 %3  max %4 ms")
+                 .arg(toMs(inputLatency.percentile(0.50)),
+                      toMs(inputLatency.percentile(0.95)),
+                      toMs(inputLatency.percentile(0.99)),
+                      toMs(inputLatency.maximum()));
+    lines << QString("repaint  last %1  p95 %2 ms")
+                 .arg(toMs(repaintTimes.latest()), toMs(repaintTimes.percentile(0.95)));
+    lines << QString("events/s %1  samples %2")
+                 .arg(inputLatency.samplesSince(oneSecondAgo))
+                 .arg(inputLatency.sampleCount());
+
+    QPainter painter(&canvas);
+    QFont font = painter.font();
+    font.setFamily("monospace");
+    font.setStyleHint(QFont::Monospace);
+    font.setPixelSize(11);
+    painter.setFont(font);
+
+    QFontMetrics metrics(font);
+    int lineHeight = metrics.height();
+    int boxWidth = 0;
+
+    for (const QString& line : lines) {
+        boxWidth = qMax(boxWidth, metrics.horizontalAdvance(line));
+    }
+
+    QRect hudBox(4, 4, boxWidth + 8, lineHeight * lines.size() + 6);
+    painter.fillRect(hudBox, QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+
+    for (int i = 0; i < lines.size(); ++i) {
+        painter.drawText(8, 7 + metrics.ascent() + i * lineHeight, lines[i]);
+    }
+    return hudBox;
+}
+
+bool EditorWindow::eventFilter(QObject* watched, QEvent* event) {
+
+    // Only handle events for the spriteCanvas (the drawing area)
+    if (watched == ui->spriteCanvas) {
+        TRACE_SCOPE("EditorWindow::eventFilter");
+
+        // Lambda to convert screen coordinates to logical (x, y) in the sprite grid
+        auto getXY = [&](const QPoint& pos, int& x, int& y) {
+            QPoint cell = view.cellAt(pos);
+            x = cell.x();
+            y = cell.y();
+        };
+
+        // The wheel zooms around the cursor; high-resolution wheels add up to whole steps
+        if (event->type() == QEvent::Wheel) {
+            QWheelEvent* wheelEvent = static_cast<QWheelEvent *>(event);
+            wheelRemainder += wheelEvent->angleDelta().y();
+            int steps = wheelRemainder / QWheelEvent::DefaultDeltasPerStep;
+            wheelRemainder -= steps * QWheelEvent::DefaultDeltasPerStep;
+
+            if (steps != 0) {
+                zoomAt(wheelEvent->position().toPoint(), steps);
+            }
+            return true;
+        }
+
+        // The middle button drags the view without touching the tools
+        else if (event->type() == QEvent::MouseButtonPress && static_cast<QMouseEvent *>(event)->button() == Qt::MiddleButton) {
+            panning = true;
+            panLast = static_cast<QMouseEvent *>(event)->pos();
+            return true;
+        }
+
+        else if (event->type() == QEvent::MouseMove && panning) {
+            QPoint position = static_cast<QMouseEvent *>(event)->pos();
+            setView(view.pannedBy(position - panLast));
+            panLast = position;
+            return true;
+        }
+
+        else if (event->type() == QEvent::MouseButtonRelease && static_cast<QMouseEvent *>(event)->button() == Qt::MiddleButton) {
+            panning = false;
+            return true;
+        }
+
+        // Handle mouse button press (begin drawing or interaction)
+        else if (event->type() == QEvent::MouseButtonPress) {
+            qint64 eventStart = latencyClock.nsecsElapsed();
+            QMouseEvent* mouseEvent = static_cast<QMouseEvent *>(event);
+            int x, y;
+            getXY(mouseEvent->pos(), x, y);
+
+            // Everything one press changes, up to the release, is undone together
+            if (!mousePressed) {
+                frameManager->beginUndoStep(isSelecting ? "Move Selection"
+                                            : isDrawingShape ? "Shape"
+                                            : isFilling ? "Fill"
+                                            : isErasing ? "Erase"
+                                            : "Draw");
+            }
+
+            // Start tracking mouse drag
+            mousePressed = true;
+            strokeInProgress = false;
+
+            // Every other tool commits a floating selection before changing the sprite
+            if (!isSelecting) {
+                commitSelection();
+            }
+
+            // Only process if (x, y) is within bounds
+            if (x >= 0 && x < spriteWidth && y >= 0 && y < spriteHeight) {
+                QPoint cell(x, y);
+
+                // Grab the selection to move it, or start a new marquee
+                if (isSelecting && selection.contains(cell)) {
+                    liftSelection();
+                    movingSelection = true;
+                    selectionAnchor = cell - selection.topLeft();
+                }
+
+                else if (isSelecting) {
+                    commitSelection();
+                    drawingMarquee = true;
+                    selectionAnchor = cell;
+                    selection = QRect(cell, cell);
+                    updateSelectionOverlay();
+                }
+
+                // Shapes are only previewed until the button is released
+                else if (isDrawingShape) {
+                    shapeInProgress = true;
+                    shapeStart = QPoint(x, y);
+                    shapeEnd = shapeStart;
+                    updateShapePreview();
+                }
+
+                else {
+                    handleDrawingAction(x, y);
+                    updateCanvas();
+                }
+                inputLatency.addSample(eventStart, latencyClock.nsecsElapsed() - eventStart);
+            }
+            return true;
+        }
+
+        // Handle mouse movement (continue drawing while dragging)
+        else if (event->type() == QEvent::MouseMove && mousePressed) {
+            qint64 eventStart = latencyClock.nsecsElapsed();
+            QMouseEvent* mouseEvent = static_cast<QMouseEvent *>(event);
+            int x, y;
+            getXY(mouseEvent->pos(), x, y);
+
+            // A moved selection follows the cursor, even partly off the canvas
+            if (movingSelection) {
+                QPoint offset = QPoint(x, y) - selectionAnchor - selection.topLeft();
+
+                if (!offset.isNull()) {
+                    moveSelection(offset);
+                    inputLatency.addSample(eventStart, latencyClock.nsecsElapsed() - eventStart);
+                }
+            }
+
+            else if (drawingMarquee) {
+                QPoint corner(qBound(0, x, spriteWidth - 1), qBound(0, y, spriteHeight - 1));
+                selection = QRect(selectionAnchor, corner).normalized();
+                updateSelectionOverlay();
+                inputLatency.addSample(eventStart, latencyClock.nsecsElapsed() - eventStart);
+            }
+
+            // Shapes follow the cursor even outside the canvas, clamped to its edge
+            else if (shapeInProgress) {
+                QPoint end(qBound(0, x, spriteWidth - 1), qBound(0, y, spriteHeight - 1));
+
+                if (end != shapeEnd) {
+                    shapeEnd = end;
+                    updateShapePreview();
+                    inputLatency.addSample(eventStart, latencyClock.nsecsElapsed() - eventStart);
+                }
+            }
+
+            // Only process if (x, y) is within bounds
+            else if (x >= 0 && x < spriteWidth && y >= 0 && y < spriteHeight) {
+                handleDrawingAction(x, y);
+                updateCanvas();
+                inputLatency.addSample(eventStart, latencyClock.nsecsElapsed() - eventStart);
+            }
+            return true;
+        }
+
+        // Handle mouse release (end drawing or dragging)
+        else if (event->type() == QEvent::MouseButtonRelease) {
+            bool endsStep = mousePressed;
+            mousePressed = false;
+            movingSelection = false;
+            strokeInProgress = false;
+
+            if (shapeInProgress) {
+                commitShape();
+            }
+
+            if (endsStep) {
+                frameManager->endUndoStep();
+            }
+
+            // A click without a drag removes the selection
+            if (drawingMarquee) {
+                drawingMarquee = false;
+
+                if (selection.width() == 1 && selection.height() == 1) {
+                    selection = QRect();
+                    updateSelectionOverlay();
+                }
+            }
+            return true;
+        }
+
+        // Arrow keys nudge the selection one cell, or ten with Shift held
+        else if (event->type() == QEvent::KeyPress && !selection.isEmpty()) {
+            QKeyEvent* keyEvent = static_cast<QKeyEvent *>(event);
+            int step = (keyEvent->modifiers() & Qt::ShiftModifier) ? 10 : 1;
+
+            switch (keyEvent->key()) {
+            case Qt::Key_Left:
+                moveSelection(QPoint(-step, 0));
+                return true;
+            case Qt::Key_Right:
+                moveSelection(QPoint(step, 0));
+                return true;
+            case Qt::Key_Up:
+                moveSelection(QPoint(0, -step));
+                return true;
+            case Qt::Key_Down:
+                moveSelection(QPoint(0, step));
+                return true;
+            case Qt::Key_Return:
+            case Qt::Key_Enter:
+                commitSelection();
+                return true;
+            case Qt::Key_Escape:
+                deselect();
+                return true;
+            default:
+                break;
+            }
+        }
+    }
+
+    // Pass unhandled events to the default implementation
+    return QMainWindow::eventFilter(watched, event);
+}
+
+void EditorWindow::liftSelection() {
+    if (selectionFloating || selection.isEmpty()) {
+        return;
+    }
+
+    floatingPixels = PixelBlit::copy(sprite, selection);
+    liftedFrom = PixelBlit::fill(sprite, selection, qRgba(255, 255, 255, 0));
+    floatingFrameId = frameManager->frameId(getCurrentFrameIndex());
+    selectionFloating = true;
+    markSpriteChanged(liftedFrom);
+
+    updateCanvas();
+    updateSelectionOverlay();
+}
+
+void EditorWindow::commitSelection() {
+    if (!selectionFloating) {
+        return;
+    }
+
+    TRACE_SCOPE("EditorWindow::commitSelection");
+    QRect changed = liftedFrom | PixelBlit::paste(sprite, floatingPixels, selection.topLeft());
+    markSpriteChanged(changed);
+
+    selectionFloating = false;
+    floatingPixels = QImage();
+    liftedFrom = QRect();
+
+    // Commit the lifted area and the drop area to the frame at once, unless that frame was deleted
+    int frameIndex = frameManager->indexOfFrame(floatingFrameId);
+
+    if (!changed.isEmpty() && frameIndex >= 0) {
+        frameManager->beginUndoStep("Move Selection");
+        emit updateRegionInFrame(frameIndex, sprite, changed);
+        frameManager->endUndoStep();
+    }
+
+    selection &= sprite.rect();
+    updateCanvas();
+    updateSelectionOverlay();
+}
+
+void EditorWindow::discardSelection() {
+    selection = QRect();
+    selectionFloating = false;
+    floatingPixels = QImage();
+    liftedFrom = QRect();
+    drawingMarquee = false;
+    movingSelection = false;
+    updateSelectionOverlay();
+}
+
+void EditorWindow::moveSelection(QPoint offset) {
+    liftSelection();
+    selection.translate(offset);
+    updateSelectionOverlay();
+}
+
+void EditorWindow::updateSelectionOverlay() {
+    selectionOverlay->setSelection(selection, selectionFloating ? floatingPixels : QImage(), sprite.size(), view);
+}
+
+void EditorWindow::copySelection() {
+    if (selection.isEmpty()) {
+        return;
+    }
+
+    QImage pixels = selectionFloating ? floatingPixels : PixelBlit::copy(sprite, selection);
+
+    // PNG keeps the alpha channel intact between projects; the plain image is for other applications
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    pixels.save(&buffer, "PNG");
+
+    QMimeData* mimeData = new QMimeData();
+    mimeData->setData("image/png", png);
+    mimeData->setImageData(pixels);
+    QGuiApplication::clipboard()->setMimeData(mimeData);
+}
+
+void EditorWindow::cutSelection() {
+    copySelection();
+    deleteSelection();
+}
+
+void EditorWindow::deleteSelection() {
+    if (selection.isEmpty()) {
+        return;
+    }
+
+    QRect changed;
+    int frameIndex = getCurrentFrameIndex();
+
+    // Floating pixels are simply dropped; the area they came from is already clear
+    if (selectionFloating) {
+        changed = liftedFrom;
+        frameIndex = frameManager->indexOfFrame(floatingFrameId);
+        selectionFloating = false;
+        floatingPixels = QImage();
+        liftedFrom = QRect();
+    }
+
+    else {
+        changed = PixelBlit::fill(sprite, selection, qRgba(255, 255, 255, 0));
+    }
+
+    if (!changed.isEmpty() && frameIndex >= 0) {
+        frameManager->beginUndoStep("Delete Selection");
+        emit updateRegionInFrame(frameIndex, sprite, changed);
+        frameManager->endUndoStep();
+    }
+
+    updateCanvas();
+    updateSelectionOverlay();
+}
+
+void EditorWindow::pasteSelection() {
+    const QMimeData* mimeData = QGuiApplication::clipboard()->mimeData();
+    QImage pixels;
+
+    if (mimeData && mimeData->hasFormat("image/png")) {
+        pixels = QImage::fromData(mimeData->data("image/png"), "PNG");
+    }
+
+    else if (mimeData && mimeData->hasImage()) {
+        pixels = qvariant_cast<QImage>(mimeData->imageData());
+    }
+
+    if (pixels.isNull()) {
+        return;
+    }
+
+    commitSelection();
+
+    // Paste over the current selection, or the top-left corner if there is none
+    QPoint position = selection.isEmpty() ? QPoint(0, 0) : selection.topLeft();
+    floatingPixels = pixels.convertToFormat(QImage::Format_ARGB32);
+    selection = QRect(position, floatingPixels.size());
+    liftedFrom = QRect();
+    floatingFrameId = frameManager->frameId(getCurrentFrameIndex());
+    selectionFloating = true;
+
+    enableSelect();
+    updateSelectionOverlay();
+}
+
+void EditorWindow::selectAll() {
+    commitSelection();
+    selection = sprite.rect();
+    updateSelectionOverlay();
+}
+
+void EditorWindow::deselect() {
+    commitSelection();
+    selection = QRect();
+    updateSelectionOverlay();
+}
+
+void EditorWindow::updateShapePreview() {
+    bool filled = ui->filledShapeCheckBox->isChecked();
+    vector<PixelSpan> spans = ShapeRasterizer::rasterize(currentShape, shapeStart, shapeEnd, filled);
+    shapeOverlay->setShape(spans, color, view);
+}
+
+void EditorWindow::commitShape() {
+    TRACE_SCOPE("EditorWindow::commitShape");
+    shapeInProgress = false;
+    shapeOverlay->clear();
+
+    bool filled = ui->filledShapeCheckBox->isChecked();
+    vector<PixelSpan> spans = ShapeRasterizer::rasterize(currentShape, shapeStart, shapeEnd, filled);
+    QRect changed = ShapeRasterizer::paint(sprite, spans, color.rgba(), currentBlendMode());
+
+    // Commit the whole shape to the frame at once
+    if (!changed.isEmpty()) {
+        emit updateRegionInFrame(getCurrentFrameIndex(), sprite, changed);
+    }
+    updateCanvas();
+}
+
+void EditorWindow::updateBrush() {
+    BrushStamp::Shape shape = ui->roundBrushCheckBox->isChecked() ? BrushStamp::Round : BrushStamp::Square;
+    brush = BrushStamp(shape, ui->brushSizeSpinBox->value());
+}
+
+PixelBlend::Mode EditorWindow::currentBlendMode() const {
+
+    // The blend choices are listed in the same order as PixelBlend::Mode, starting after Replace
+    return static_cast<PixelBlend::Mode>(PixelBlend::Normal + ui->blendModeComboBox->currentIndex());
+}
+
+void EditorWindow::paintStroke(QPoint cell, QRgb paint, PixelBlend::Mode mode) {
+    TRACE_SCOPE("EditorWindow::paintStroke");
+
+    // The symmetry choices are listed in the same order as the BrushStamp::Symmetry flags
+    BrushStamp::Symmetry symmetry = static_cast<BrushStamp::Symmetry>(ui->symmetryComboBox->currentIndex());
+    QPoint from = strokeInProgress ? lastStrokeCell : cell;
+
+    // A new stroke may blend over everything again
+    if (!strokeInProgress) {
+        strokeCoverage.assign(static_cast<size_t>(sprite.width()) * sprite.height(), 0);
+    }
+
+    QRegion changed = brush.stroke(sprite, from, cell, paint, symmetry, mode, &strokeCoverage);
+
+    strokeInProgress = true;
+    lastStrokeCell = cell;
+
+    // Commit everything this event painted to the frame at once
+    if (!changed.isEmpty()) {
+        emit updateRegionInFrame(getCurrentFrameIndex(), sprite, changed);
+    }
+}
+
+void EditorWindow::handleDrawingAction(int x, int y) {
+    TRACE_SCOPE("EditorWindow::handleDrawingAction");
+
+    // If drawing or eraser mode is active, paint with the brush (erasing paints transparent)
+    if (isDrawing || isErasing) {
+        if (isDrawing) {
+            paintStroke(QPoint(x, y), color.rgba(), currentBlendMode());
+        }
+
+        else {
+            paintStroke(QPoint(x, y), qRgba(255, 255, 255, 0), PixelBlend::Replace);
+        }
+    }
+
+    // If color picker mode is active
+    else if (isGettingColor) {
+        color = sprite.pixelColor(x, y);
+        emit changeRedValue(color.red());
+        emit changeGreenValue(color.green());
+        emit changeBlueValue(color.blue());
+        emit changeAlphaValue(color.alpha());
+    }
+
+    // If bucket fill mode is active
+    else if (isFilling) {
+        FloodFill::Mode mode = ui->fillAllCheckBox->isChecked() ? FloodFill::Global : FloodFill::Contiguous;
+        QRect changed = FloodFill::fill(sprite, QPoint(x, y), color.rgba(), ui->toleranceSpinBox->value(), mode, currentBlendMode());
+
+        // Commit the whole filled area to the frame at once
+        if (!changed.isEmpty()) {
+            emit updateRegionInFrame(getCurrentFrameIndex(), sprite, changed);
+        }
+    }
+}
+
+int EditorWindow::getCurrentFrameIndex() {
+    QModelIndex selectedIndex = ui->frameStackWidget->currentIndex();
+
+    // If an item is selected, return its index (row number) in the list.
+    // If no item is selected (e.g., at startup), default to frame index 0.
+    return selectedIndex.isValid() ? selectedIndex.row() : 0;
+}
+
+void EditorWindow::onSaveButtonClicked() {
+    commitSelection();
+
+
+    QString filePath = QFileDialog::getSaveFileName(
+        this,                           // Parent widget (EditorWindow)
+        "Save Sprite File",             // Title of the dialog
+        "",                             // Default directory (empty = current)
+        "Sprite Save Files (*.ssp)"     // File filter
+        );
+
+    // Check if the user selected a file (didn't cancel the dialog)
+    if (!filePath.isEmpty()) {
+
+        // Ensure the file has a .ssp extension
+        if (!filePath.endsWith(".ssp", Qt::CaseInsensitive)) {
+            filePath += ".ssp";
+        }
+
+        bool success = saveLoadManager->saveToFile(*frameManager, filePath);
+
+        if (success) {
+            DedupStatistics dedup = saveLoadManager->lastSaveDedup();
+
+            QMessageBox::information(
+                this,                       // Parent widget
+                "Success",                  // Dialog title
+                QString("File saved successfully!\n%1 frames stored as %2 unique frames (%3:1 deduplication).")
+                    .arg(dedup.frameCount)
+                    .arg(dedup.uniqueFrameCount)
+                    .arg(dedup.ratio(), 0, 'f', 2)
+                );
+        }
+
+        else {
+            QMessageBox::warning(
+                this,                       // Parent widget
+                "Error",                    // Dialog title
+                "Failed to save the file."  // Message
+                );
+        }
+    }
+}
+
+void EditorWindow::onExportSpriteSheetClicked() {
+    commitSelection();
+
+    QString jsonFilter = "Sprite Sheet with JSON (*.png)";
+    QString csvFilter = "Sprite Sheet with CSV (*.png)";
+    QString selectedFilter = jsonFilter;
+
+    QString imagePath = QFileDialog::getSaveFileName(
+        this,                               // Parent widget (EditorWindow)
+        "Export Sprite Sheet",              // Title of the dialog
+        "",                                 // Default directory (empty = current)
+        jsonFilter + ";;" + csvFilter,      // File filters
+        &selectedFilter                     // Which metadata format was chosen
+        );
+
+    // Check if the user selected a file (didn't cancel the dialog)
+    if (imagePath.isEmpty()) {
+        return;
+    }
+
+    // Ensure the image has a .png extension
+    if (!imagePath.endsWith(".png", Qt::CaseInsensitive)) {
+        imagePath += ".png";
+    }
+
+    // The metadata file sits next to the image with the same base name
+    QString metadataPath = imagePath.left(imagePath.length() - 4);
+    metadataPath += (selectedFilter == csvFilter) ? ".csv" : ".json";
+
+    // Pack and encode on a worker thread; the modal dialog keeps the frames from changing meanwhile
+    QProgressDialog* progress = new QProgressDialog("Exporting...", QString(), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+
+    // Report the result once the export finishes
+    connect(watcher,
+            &QFutureWatcher<bool>::finished,
+            this,
+            [this, progress, watcher]() {
+                progress->deleteLater();
+                watcher->deleteLater();
+
+                if (watcher->result()) {
+                    QMessageBox::information(this, "Success", "Sprite sheet exported successfully!");
+                }
+
+                else {
+                    QMessageBox::warning(this, "Error", "Failed to export the sprite sheet.");
+                }
+            }
+    );
+
+    watcher->setFuture(QtConcurrent::run([this, imagePath, metadataPath]() {
+        SpriteSheetExporter exporter;
+        return exporter.exportToFile(*frameManager, imagePath, metadataPath);
+    }));
+}
+
+void EditorWindow::onExportGifClicked() {
+    commitSelection();
+
+
+    QString filePath = QFileDialog::getSaveFileName(
+        this,                           // Parent widget (EditorWindow)
+        "Export Animated GIF",          // Title of the dialog
+        "",                             // Default directory (empty = current)
+        "GIF Images (*.gif)"            // File filter
+        );
+
+    // Check if the user selected a file (didn't cancel the dialog)
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    // Ensure the file has a .gif extension
+    if (!filePath.endsWith(".gif", Qt::CaseInsensitive)) {
+        filePath += ".gif";
+    }
+
+    int fps = previewFps;
+    bool dither = ui->actionDitherGif->isChecked();
+
+    // Quantize and encode on a worker thread; the modal dialog keeps the frames from changing meanwhile
+    QProgressDialog* progress = new QProgressDialog("Exporting...", QString(), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+
+    // Report the result once the export finishes
+    connect(watcher,
+            &QFutureWatcher<bool>::finished,
+            this,
+            [this, progress, watcher]() {
+                progress->deleteLater();
+                watcher->deleteLater();
+
+                if (watcher->result()) {
+                    QMessageBox::information(this, "Success", "GIF exported successfully!");
+                }
+
+                else {
+                    QMessageBox::warning(this, "Error", "Failed to export the GIF.");
+                }
+            }
+    );
+
+    watcher->setFuture(QtConcurrent::run([this, filePath, fps, dither]() {
+        GifExporter exporter;
+        return exporter.exportToFile(*frameManager, filePath, fps, dither);
+    }));
+}
+
+void EditorWindow::setPreviewFps(int fps) {
+    previewFps = fps;
+}
+
+void EditorWindow::onMemoryBudgetClicked() {
+    const qint64 megabyte = 1024 * 1024;
+    bool ok = false;
+
+    int budget = QInputDialog::getInt(
+        this,
+        "Memory Budget",
+        "Soft memory budget in MB (0 for none).\nInactive frames are compressed when it is exceeded.",
+        static_cast<int>(frameManager->memoryBudget() / megabyte),
+        0,
+        1024 * 1024,
+        64,
+        &ok
+        );
+
+    if (ok) {
+        frameManager->setMemoryBudget(budget * megabyte);
+        updateMemoryUsage();
+    }
+}
+
+void EditorWindow::updateMemoryUsage() {
+    MemoryUsage usage = frameManager->memoryUsage();
+    QLocale locale;
+
+    QString text = QString("Memory: %1 (%2 shared, %3 frames compressed)")
+                       .arg(locale.formattedDataSize(usage.totalBytes()),
+                            locale.formattedDataSize(usage.sharedBytes))
+                       .arg(usage.compressedFrames);
+
+    if (frameManager->memoryBudget() > 0) {
+        text += " / " + locale.formattedDataSize(frameManager->memoryBudget());
+    }
+
+    memoryLabel->setText(text);
+    memoryLabel->setToolTip(QString("Unique frames: %1\nShared frames: %2\nCompressed: %3\nUndo: %4\nCaches: %5")
+                                .arg(locale.formattedDataSize(usage.uniqueBytes),
+                                     locale.formattedDataSize(usage.sharedBytes),
+                                     locale.formattedDataSize(usage.compressedBytes),
+                                     locale.formattedDataSize(usage.undoBytes),
+                                     locale.formattedDataSize(usage.cacheBytes)));
+}
+
+void EditorWindow::onImportImageClicked() {
+
+    QStringList filePaths = QFileDialog::getOpenFileNames(
+        this,                                       // Parent widget (EditorWindow)
+        "Import Images",                            // Title of the dialog
+        QDir::homePath(),                           // Default directory
+        "Images (*.png *.bmp *.gif *.jpg *.jpeg)"   // File filter
+        );
+
+    // Check if the user selected any files (didn't cancel the dialog)
+    if (filePaths.isEmpty()) {
+        return;
+    }
+
+    ImageImporter::SliceMode mode = ImageImporter::SingleFrame;
+    int cellWidth = spriteWidth;
+    int cellHeight = spriteHeight;
+
+    // A single image may be a sprite sheet, so ask how to slice it
+    if (filePaths.size() == 1) {
+        QStringList modes = {"Single frame", "Grid", "Auto-detect (transparent gutters)"};
+        bool ok = false;
+        QString choice = QInputDialog::getItem(this, "Import Image", "Slice image into frames:", modes, 0, false, &ok);
+
+        if (!ok) {
+            return;
+        }
+
+        if (choice == modes[1]) {
+            mode = ImageImporter::Grid;
+            cellWidth = QInputDialog::getInt(this, "Import Image", "Cell width:", spriteWidth, 1, 4096, 1, &ok);
+
+            if (ok) {
+                cellHeight = QInputDialog::getInt(this, "Import Image", "Cell height:", spriteHeight, 1, 4096, 1, &ok);
+            }
+
+            if (!ok) {
+                return;
+            }
+        }
+
+        else if (choice == modes[2]) {
+            mode = ImageImporter::Gutters;
+        }
+    }
+
+    // Decode and slice on a worker thread so the editor stays responsive
+    QProgressDialog* progress = new QProgressDialog("Importing...", QString(), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+
+    ImageImporter* importer = new ImageImporter(this);
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    std::shared_ptr<vector<Frame>> frames = std::make_shared<vector<Frame>>();
+
+    // Update the progress bar as cells are sliced (delivered on the GUI thread)
+    connect(importer,
+            &ImageImporter::progressChanged,
+            progress,
+            [progress](int completed, int total) {
+                progress->setMaximum(total);
+                progress->setValue(completed);
+            }
+    );
+
+    // Hand the frames to the sprite once the import finishes
+    connect(watcher,
+            &QFutureWatcher<bool>::finished,
+            this,
+            [this, progress, importer, watcher, frames]() {
+                progress->deleteLater();
+                importer->deleteLater();
+                watcher->deleteLater();
+
+                if (watcher->result()) {
+                    addImportedFrames(*frames);
+                }
+
+                else {
+                    QMessageBox::warning(this, "Error", "Failed to import the image.");
+                }
+            }
+    );
+
+    watcher->setFuture(QtConcurrent::run([=]() {
+        if (filePaths.size() == 1) {
+            return importer->importSheet(filePaths.first(), mode, cellWidth, cellHeight, *frames);
+        }
+        return importer->importImages(filePaths, *frames);
+    }));
+}
+
+void EditorWindow::addImportedFrames(const vector<Frame>& frames) {
+    int importedWidth = frames.front().getWidth();
+    int importedHeight = frames.front().getHeight();
+
+    // Frames of the same size are simply appended to the stack
+    if (importedWidth == spriteWidth && importedHeight == spriteHeight) {
+        frameManager->insertFrames(static_cast<int>(frameManager->frames.size()), frames);
+        return;
+    }
+
+    QMessageBox::StandardButton answer = QMessageBox::question(
+        this,
+        "Import Image",
+        QString("The imported frames are %1x%2 but the sprite is %3x%4. Replace the current sprite?")
+            .arg(importedWidth).arg(importedHeight).arg(spriteWidth).arg(spriteHeight)
+        );
+
+    if (answer != QMessageBox::Yes) {
+        return;
+    }
+
+    frameManager->clearFrames();
+    frameManager->height = importedHeight;
+    frameManager->width = importedWidth;
+    frameManager->insertFrames(0, frames);
+
+    initializeFromLoadedFile(importedWidth, importedHeight);
+}
+
+void EditorWindow::onExportTraceClicked() {
+
+    QString filePath = QFileDialog::getSaveFileName(
+        this,                           // Parent widget (EditorWindow)
+        "Export Performance Trace",     // Title of the dialog
+        "",                             // Default directory (empty = current)
+        "Chrome Trace Files (*.json)"   // File filter
+        );
+
+    // Check if the user selected a file (didn't cancel the dialog)
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    // Ensure the file has a .json extension
+    if (!filePath.endsWith(".json", Qt::CaseInsensitive)) {
+        filePath += ".json";
+    }
+
+    if (Tracer::exportChromeTrace(filePath)) {
+        QMessageBox::information(this, "Success", "Trace exported successfully!");
+    }
+
+    else {
+        QMessageBox::warning(this, "Error", "Failed to export the trace.");
+    }
+}
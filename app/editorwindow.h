@@ -0,0 +1,848 @@
+#ifndef EDITORWINDOW_H
+#define EDITORWINDOW_H
+
+/**
+ * @file editorwindow.h
+ * @brief Declares the EditorWindow class for the main sprite editing interface.
+ *
+ * The EditorWindow is responsible for drawing, editing, coloring, and managing frames
+ * in the sprite editor. It connects the UI with the underlying models and handles
+ * real-time user interactions like mouse drawing, erasing, and color picking.
+ *
+ * @date 03/31/2025
+ */
+
+#include "brushstamp.h"
+#include "canvasview.h"
+#include "framebatchrunner.h"
+#include "framelistmodel.h"
+#include "framemanager.h"
+#include "latencyhistogram.h"
+#include "saveloadmanager.h"
+#include "shaperasterizer.h"
+#include "spritemipmaps.h"
+#include "thumbnailcache.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QLabel>
+#include <QMainWindow>
+#include <QTimer>
+
+using std::vector;
+
+QT_BEGIN_NAMESPACE
+class SelectionOverlay;
+class ShapeOverlay;
+
+namespace Ui { class EditorWindow; }
+QT_END_NAMESPACE
+
+/**
+ * @class EditorWindow
+ *
+ * @brief The main editor window where users draw, modify, animate, and manage sprite frames.
+ */
+class EditorWindow : public QMainWindow {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructs the EditorWindow with references to model managers.
+     * @param saveLoadManager Handles save/load operations for frames.
+     * @param frameManager Manages all sprite frames.
+     * @param width Initial width of the sprite.
+     * @param height Initial height of the sprite.
+     * @param parent Optional parent widget.
+     */
+    explicit EditorWindow(SaveLoadManager* saveLoadManager, FrameManager* frameManager, int width, int height, QWidget* parent = nullptr);
+
+    /**
+     * @brief Destructor.
+     */
+    ~EditorWindow();
+
+    /**
+     * @brief Sets the logical width of the sprite.
+     * @param width Width in pixels.
+     */
+    void setSpriteWidth(int width);
+
+    /**
+     * @brief Sets the logical height of the sprite.
+     * @param height Height in pixels.
+     */
+    void setSpriteHeight(int height);
+
+    /**
+     * @brief Reinitializes the editor from scratch with new dimensions (used when creating a new sprite).
+     * @param newWidth New sprite width.
+     * @param newHeight New sprite height.
+     */
+    void reinitializeEditor(int newWidth, int newHeight);
+
+    /**
+     * @brief Initializes the editor window using data from a loaded file.
+     * @param width Width from the loaded file.
+     * @param height Height from the loaded file.
+     */
+    void initializeFromLoadedFile(int width, int height);
+
+protected:
+
+    /**
+     * @brief Filters mouse events for the drawing canvas (spriteCanvas).
+     * @param watched The object receiving the event.
+     * @param event The event to filter.
+     * @return true if the event was handled; false otherwise.
+     */
+    virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+    /**
+     * @brief Grows the canvas with the window, moving the controls beside and below it along.
+     * @param event The resize event.
+     */
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+
+    /**
+     * @brief Pointer to the UI layout.
+     */
+    Ui::EditorWindow* ui;
+
+    /**
+     * @brief Pointer to the frame manager model.
+     */
+    FrameManager* frameManager;
+
+    /**
+     * @brief Pointer to the save/load manager.
+     */
+    SaveLoadManager* saveLoadManager;
+
+    /**
+     * @brief Currently selected drawing color.
+     */
+    QColor color;
+
+    /**
+     * @brief Internal representation of the canvas image.
+     */
+    QImage sprite;
+
+    /**
+     * @brief Logical width of the sprite grid.
+     */
+    int spriteWidth;
+
+    /**
+     * @brief Logical height of the sprite grid.
+     */
+    int spriteHeight;
+
+    /**
+     * @brief Whether drawing mode is active.
+     */
+    bool isDrawing = false;
+
+    /**
+     * @brief Whether eraser mode is active.
+     */
+    bool isErasing = false;
+
+    /**
+     * @brief Whether color picker mode is active.
+     */
+    bool isGettingColor = false;
+
+    /**
+     * @brief Precomputed mask of the brush used for drawing and erasing.
+     */
+    BrushStamp brush;
+
+    /**
+     * @brief Whether a draw or erase stroke has been started by a press.
+     */
+    bool strokeInProgress = false;
+
+    /**
+     * @brief Sprite cell the current stroke last painted, where the next segment starts.
+     */
+    QPoint lastStrokeCell;
+
+    /**
+     * @brief One flag per sprite pixel the current stroke has blended, so overlapping stamps blend it only once.
+     */
+    vector<quint8> strokeCoverage;
+
+    /**
+     * @brief Whether bucket fill mode is active.
+     */
+    bool isFilling = false;
+
+    /**
+     * @brief Whether a shape tool is active.
+     */
+    bool isDrawingShape = false;
+
+    /**
+     * @brief The shape drawn by the shape tool.
+     */
+    ShapeRasterizer::Shape currentShape = ShapeRasterizer::Line;
+
+    /**
+     * @brief Whether a shape is being dragged out.
+     */
+    bool shapeInProgress = false;
+
+    /**
+     * @brief Sprite cell where the current shape drag started.
+     */
+    QPoint shapeStart;
+
+    /**
+     * @brief Sprite cell the current shape drag is at.
+     */
+    QPoint shapeEnd;
+
+    /**
+     * @brief Layer over the canvas that previews the shape being dragged.
+     */
+    ShapeOverlay* shapeOverlay;
+
+    /**
+     * @brief Whether the selection tool is active.
+     */
+    bool isSelecting = false;
+
+    /**
+     * @brief Selected cells in sprite coordinates; empty when nothing is selected.
+     */
+    QRect selection;
+
+    /**
+     * @brief Whether the selection's pixels have been lifted off the sprite or pasted and not yet committed.
+     */
+    bool selectionFloating = false;
+
+    /**
+     * @brief Pixels floating at the selection while it is lifted or pasted.
+     */
+    QImage floatingPixels;
+
+    /**
+     * @brief Where the floating pixels were lifted from, cleared in the sprite; empty for pasted pixels.
+     */
+    QRect liftedFrom;
+
+    /**
+     * @brief ID of the frame the floating pixels will be committed to, which stays valid if frames move.
+     */
+    FrameManager::FrameId floatingFrameId = 0;
+
+    /**
+     * @brief Whether a marquee is being dragged out.
+     */
+    bool drawingMarquee = false;
+
+    /**
+     * @brief Whether the selection is being dragged to a new position.
+     */
+    bool movingSelection = false;
+
+    /**
+     * @brief Marquee corner the drag started from, or the grab offset inside a moved selection.
+     */
+    QPoint selectionAnchor;
+
+    /**
+     * @brief Layer over the canvas that shows the marquee and floating pixels.
+     */
+    SelectionOverlay* selectionOverlay;
+
+    /**
+     * @brief Whether the mouse is currently pressed (for drawing).
+     */
+    bool mousePressed = false;
+
+    /**
+     * @brief Playback speed last chosen in the preview window, used for GIF frame delays.
+     */
+    int previewFps = 1;
+
+    /**
+     * @brief Monotonic clock used for latency measurements.
+     */
+    QElapsedTimer latencyClock;
+
+    /**
+     * @brief Time from a mouse event reaching eventFilter to the changed cells being queued for repaint.
+     */
+    LatencyHistogram inputLatency;
+
+    /**
+     * @brief Time spent redrawing the changed part of the canvas.
+     */
+    LatencyHistogram repaintTimes;
+
+    /**
+     * @brief Permanent status bar label showing the project's memory use.
+     */
+    QLabel* memoryLabel;
+
+    /**
+     * @brief Applies the Frames menu operations to ranges of frames in the background.
+     */
+    FrameBatchRunner* batchRunner;
+
+    /**
+     * @brief The frame stack's model, one row per frame.
+     */
+    FrameListModel* frameModel;
+
+    /**
+     * @brief Renders the frame stack thumbnails in the background.
+     */
+    ThumbnailCache* thumbnails;
+
+    /**
+     * @brief Coalesces bursts of frame changes into one thumbnail refresh.
+     */
+    QTimer* thumbnailTimer;
+
+    /**
+     * @brief Zoom and pan of the canvas.
+     */
+    CanvasView view;
+
+    /**
+     * @brief Whether the view follows the canvas size, as before any zoom or pan.
+     */
+    bool fitToWindow = true;
+
+    /**
+     * @brief Downsampled copies of the sprite, used while zoomed out.
+     */
+    SpriteMipmaps mipmaps;
+
+    /**
+     * @brief Sprite pixels changed since the mipmaps were last updated.
+     */
+    QRect mipmapDirty;
+
+    /**
+     * @brief Sprite pixels changed since the canvas was last redrawn.
+     */
+    QRect canvasDirty;
+
+    /**
+     * @brief The view the canvas was last drawn with; any other view redraws all of it.
+     */
+    CanvasView drawnView;
+
+    /**
+     * @brief Whether the next redraw must cover the whole canvas, after a resize or a new sprite.
+     */
+    bool redrawAll = true;
+
+    /**
+     * @brief Canvas area covered by the latency HUD when it was last drawn.
+     */
+    QRect hudArea;
+
+    /**
+     * @brief Geometry of each control in the central widget as laid out in the form.
+     */
+    QHash<QWidget*, QRect> designGeometry;
+
+    /**
+     * @brief Size the form's controls were laid out for, including the margin around them.
+     */
+    QSize designSize;
+
+    /**
+     * @brief Whether the middle mouse button is dragging the view.
+     */
+    bool panning = false;
+
+    /**
+     * @brief Mouse position at the last pan step.
+     */
+    QPoint panLast;
+
+    /**
+     * @brief Wheel rotation not yet turned into a whole zoom step.
+     */
+    int wheelRemainder = 0;
+
+    /**
+     * @brief Updates the canvas display to reflect the current sprite image.
+     *
+     * Only the cells changed since the last call are redrawn and repainted, unless the view, the
+     * canvas size or the sprite size changed.
+     */
+    void updateCanvas();
+
+    /**
+     * @brief Redraws the whole canvas after it was resized.
+     */
+    void onCanvasResized();
+
+    /**
+     * @brief Records sprite pixels that the mipmaps have not seen yet.
+     * @param area The changed pixels.
+     */
+    void markSpriteChanged(const QRect& area);
+
+    /**
+     * @brief Shows a frame on the canvas and marks it as the frame being edited.
+     * @param frameIndex The index of the frame.
+     */
+    void showFrame(int frameIndex);
+
+    /**
+     * @brief Switches to a new zoom and pan and redraws the canvas and overlays.
+     * @param newView The view to show.
+     */
+    void setView(const CanvasView& newView);
+
+    /**
+     * @brief Zooms by whole steps, keeping the point under the anchor in place.
+     * @param anchor Position in canvas coordinates.
+     * @param steps Positive to zoom in, negative to zoom out.
+     */
+    void zoomAt(QPoint anchor, int steps);
+
+    /**
+     * @brief Draws input latency percentiles, repaint time and event rate onto the canvas.
+     * @param canvas The rendered canvas, drawn over in place.
+     * @return The area of the canvas covered by the HUD.
+     */
+    QRect drawLatencyHud(QImage& canvas);
+
+    /**
+     * @brief Handles drawing, erasing, or color picking at a given coordinate.
+     * @param x The X-coordinate in the sprite grid.
+     * @param y The Y-coordinate in the sprite grid.
+     */
+    void handleDrawingAction(int x, int y);
+
+    /**
+     * @brief Returns the index of the currently selected frame.
+     * @return The current frame index, or 0 if none is selected.
+     */
+    int getCurrentFrameIndex();
+
+    /**
+     * @brief Finds the frames a Frames menu operation applies to.
+     *
+     * That is every frame if "Apply to All Frames" is checked, otherwise the run from the first to the
+     * last frame selected in the frame stack.
+     *
+     * @param first Receives the index of the first frame.
+     * @param last Receives the index of the last frame.
+     */
+    void getSelectedFrameRange(int& first, int& last);
+
+    /**
+     * @brief Applies an operation to the selected frames in parallel, with a cancellable progress dialog.
+     * @param operation The operation to apply to each frame.
+     * @param description A short name for the undo step.
+     */
+    void runFrameOperation(FrameBatchRunner::Operation operation, const QString& description);
+
+    /**
+     * @brief Adds frames produced by an import to the sprite.
+     *
+     * Frames matching the sprite size are appended. Otherwise the user is asked whether to replace
+     * the sprite with the imported frames.
+     *
+     * @param frames The imported frames, all of the same size.
+     */
+    void addImportedFrames(const vector<Frame>& frames);
+
+    /**
+     * @brief Paints the brush from the last stroke position to a cell and commits it in one batch.
+     * @param cell The sprite cell under the cursor.
+     * @param paint The color to paint; transparent for the eraser.
+     * @param mode How the color combines with the sprite; the eraser replaces pixels.
+     */
+    void paintStroke(QPoint cell, QRgb paint, PixelBlend::Mode mode);
+
+    /**
+     * @brief Returns the blend mode chosen for brushes, fills and shapes.
+     * @return The selected mode.
+     */
+    PixelBlend::Mode currentBlendMode() const;
+
+    /**
+     * @brief Switches to a shape tool.
+     * @param shape The shape to draw.
+     */
+    void enableShape(ShapeRasterizer::Shape shape);
+
+    /**
+     * @brief Rasterizes the shape being dragged and shows it in the overlay.
+     */
+    void updateShapePreview();
+
+    /**
+     * @brief Paints the dragged shape into the sprite and commits it to the frame in one batch.
+     */
+    void commitShape();
+
+    /**
+     * @brief Lifts the selected pixels off the sprite so they float above it.
+     */
+    void liftSelection();
+
+    /**
+     * @brief Pastes the floating pixels back into the sprite and commits them to their frame as one undo step.
+     */
+    void commitSelection();
+
+    /**
+     * @brief Drops the selection and any floating pixels without committing them.
+     */
+    void discardSelection();
+
+    /**
+     * @brief Lifts the selection if needed and moves it.
+     * @param offset How far to move, in sprite cells.
+     */
+    void moveSelection(QPoint offset);
+
+    /**
+     * @brief Shows the current selection and floating pixels in the selection overlay.
+     */
+    void updateSelectionOverlay();
+
+public slots:
+
+    /**
+     * @brief Opens the animation preview window.
+     */
+    void animateClicked();
+
+    /**
+     * @brief Enables drawing mode.
+     */
+    void enableDrawing();
+
+    /**
+     * @brief Enables erasing mode.
+     */
+    void enableEraser();
+
+    /**
+     * @brief Enables color picking mode.
+     */
+    void enableCopyColor();
+
+    /**
+     * @brief Enables bucket fill mode.
+     */
+    void enableFill();
+
+    /**
+     * @brief Rebuilds the brush mask from the brush size and shape controls.
+     */
+    void updateBrush();
+
+    /**
+     * @brief Enables the rectangular selection tool.
+     */
+    void enableSelect();
+
+    /**
+     * @brief Copies the selection to the clipboard and clears it.
+     */
+    void cutSelection();
+
+    /**
+     * @brief Copies the selection to the clipboard.
+     *
+     * The clipboard is shared with every open project and with other applications.
+     */
+    void copySelection();
+
+    /**
+     * @brief Pastes the clipboard as a floating selection on the current frame.
+     */
+    void pasteSelection();
+
+    /**
+     * @brief Clears the selected pixels to transparent.
+     */
+    void deleteSelection();
+
+    /**
+     * @brief Selects the whole sprite.
+     */
+    void selectAll();
+
+    /**
+     * @brief Commits any floating pixels and removes the selection.
+     */
+    void deselect();
+
+    /**
+     * @brief Enables the line tool.
+     */
+    void enableLine();
+
+    /**
+     * @brief Enables the rectangle tool.
+     */
+    void enableRectangle();
+
+    /**
+     * @brief Enables the ellipse tool.
+     */
+    void enableEllipse();
+
+    /**
+     * @brief Updates the red channel of the selected color.
+     * @param value Red component value.
+     */
+    void redChanged(int value);
+
+    /**
+     * @brief Updates the green channel of the selected color.
+     * @param value Green component value.
+     */
+    void greenChanged(int value);
+
+    /**
+     * @brief Updates the blue channel of the selected color.
+     * @param value Blue component value.
+     */
+    void blueChanged(int value);
+
+    /**
+     * @brief Updates the alpha channel (opacity) of the selected color.
+     * @param value Alpha component value.
+     */
+    void alphaChanged(int value);
+
+    /**
+     * @brief Deletes the currently selected frame from the frame stack.
+     */
+    void deleteFrameFromStack();
+
+    /**
+     * @brief Copies a frame onto the canvas, one row at a time, and redraws it.
+     * @param frame The frame to show; it must be the size of the sprite.
+     */
+    void switchCanvas(const Frame& frame);
+
+    /**
+     * @brief Emits a request to retrieve the currently selected frame's pixel data.
+     */
+    void getSelectedFrame();
+
+    /**
+     * @brief Emits a request to copy the currently selected frame.
+     */
+    void getSelectedFrameToCopy();
+
+    /**
+     * @brief Rotates the selected frames 90° clockwise.
+     */
+    void rotateFrames();
+
+    /**
+     * @brief Inverts the pixel colors of the selected frames.
+     */
+    void invertColor();
+
+    /**
+     * @brief Mirrors the selected frames left to right.
+     */
+    void flipFramesHorizontal();
+
+    /**
+     * @brief Mirrors the selected frames top to bottom.
+     */
+    void flipFramesVertical();
+
+    /**
+     * @brief Asks for a new canvas size and anchor, then resizes every frame without scaling it.
+     */
+    void resizeCanvas();
+
+    /**
+     * @brief Asks for a new size and resampling method, then scales every frame.
+     */
+    void scaleSprite();
+
+    /**
+     * @brief Asks for a count and mode, then inserts generated frames between the first and last selected frames.
+     */
+    void generateInbetweens();
+
+    /**
+     * @brief Asks for a duration in milliseconds and gives it to the selected frames.
+     */
+    void setFrameDuration();
+
+    /**
+     * @brief Reverts the most recent change to the frames.
+     */
+    void undo();
+
+    /**
+     * @brief Reapplies the most recently undone change.
+     */
+    void redo();
+
+    /**
+     * @brief Updates the Undo and Redo menu actions from the frame manager's history.
+     */
+    void updateUndoActions();
+
+    /**
+     * @brief Starts bringing the thumbnails of the visible frame stack rows up to date.
+     */
+    void refreshThumbnails();
+
+    /**
+     * @brief Reloads the canvas if the frame being edited is among the changed frames.
+     * @param first Index of the first changed frame.
+     * @param last Index of the last changed frame.
+     */
+    void onFramesChanged(int first, int last);
+
+    /**
+     * @brief Recreates the canvas image at the frames' new size and fits it to the window.
+     * @param height The new sprite height.
+     * @param width The new sprite width.
+     */
+    void onFramesResized(int height, int width);
+
+    /**
+     * @brief Marks the region committed to a frame as changed for the mipmaps.
+     * @param frameIndex The index of the frame.
+     * @param image The sprite the region was copied from.
+     * @param region The changed pixels.
+     */
+    void onSpriteRegionChanged(int frameIndex, const QImage& image, const QRegion& region);
+
+    /**
+     * @brief Triggered from the View menu. Zooms in around the center of the canvas.
+     */
+    void zoomIn();
+
+    /**
+     * @brief Triggered from the View menu. Zooms out around the center of the canvas.
+     */
+    void zoomOut();
+
+    /**
+     * @brief Triggered from the View menu. Fits the whole sprite into the canvas again.
+     */
+    void zoomToFit();
+
+    /**
+     * @brief Triggered when the save button is clicked. Opens save dialog and writes to file.
+     */
+    void onSaveButtonClicked();
+
+    /**
+     * @brief Triggered from the File menu. Imports images or slices a sprite sheet into frames in the background.
+     */
+    void onImportImageClicked();
+
+    /**
+     * @brief Triggered from the File menu. Exports all frames as a packed PNG atlas plus JSON or CSV metadata.
+     */
+    void onExportSpriteSheetClicked();
+
+    /**
+     * @brief Triggered from the File menu. Exports all frames as an animated GIF at the preview FPS.
+     */
+    void onExportGifClicked();
+
+    /**
+     * @brief Triggered from the File menu. Writes the recorded trace spans as Chrome trace JSON.
+     */
+    void onExportTraceClicked();
+
+    /**
+     * @brief Remembers the playback speed chosen in the preview window.
+     * @param fps Frames per second.
+     */
+    void setPreviewFps(int fps);
+
+    /**
+     * @brief Triggered from the View menu. Asks for the soft memory budget and applies it.
+     */
+    void onMemoryBudgetClicked();
+
+    /**
+     * @brief Refreshes the memory use shown in the status bar.
+     */
+    void updateMemoryUsage();
+
+signals:
+
+    /**
+     * @brief Signal to add a new blank frame (used after initializing a new sprite).
+     */
+    void addOneFrame();
+
+    /**
+     * @brief Signal to update the red spinbox to a new value.
+     * @param value Red component.
+     */
+    void changeRedValue(int value);
+
+    /**
+     * @brief Signal to update the green spinbox to a new value.
+     * @param value Green component.
+     */
+    void changeGreenValue(int value);
+
+    /**
+     * @brief Signal to update the blue spinbox to a new value.
+     * @param value Blue component.
+     */
+    void changeBlueValue(int value);
+
+    /**
+     * @brief Signal to update the alpha spinbox to a new value.
+     * @param value Alpha component.
+     */
+    void changeAlphaValue(int value);
+
+    /**
+     * @brief Signal to delete a frame by its index.
+     * @param frameIndex Index of the frame to delete.
+     */
+    void deleteFrame(int frameIndex);
+
+    /**
+     * @brief Signal to update a pixel in a specific frame.
+     */
+    void updatePixelInFrame(int frameIndex, int rowIndex, int columnIndex, int red, int green, int blue, int alpha);
+
+    /**
+     * @brief Signal to copy a changed area of the canvas into a specific frame in one batch.
+     * @param frameIndex Index of the frame.
+     * @param image The canvas image holding the new pixels.
+     * @param region The changed area.
+     */
+    void updateRegionInFrame(int frameIndex, const QImage& image, const QRegion& region);
+
+    /**
+     * @brief Signal to request that a frame be copied.
+     * @param frameIndex Index of the frame to copy.
+     * @param position Where the copy goes.
+     */
+    void selectedFrameToCopy(int frameIndex, int position);
+
+};
+
+#endif // EDITORWINDOW_H
@@ -1,20 +1,34 @@
 /**
  * @file main.cpp
  * @brief Entry point for the Sprite Editor application. Initializes Qt application and main UI components.
+ *
+ * When the first argument is a subcommand (see CommandLineTool), the application runs headless with a
+ * QCoreApplication instead of opening any windows.
+ *
  * @date 03/31/2025
  */
 
+#include "commandlinetool.h"
 #include "mainwindow.h"
 
 #include <QApplication>
+#include <QCoreApplication>
 
 /**
  * @brief The main function initializes the Qt application and shows the MainWindow.
  * @param argc Command-line argument count.
  * @param argv Command-line argument values.
- * @return Exit code returned by the Qt application event loop.
+ * @return Exit code returned by the Qt application event loop, or by the command-line tool in headless mode.
  */
 int main(int argc, char *argv[]) {
+
+    // Batch commands never touch a display
+    if (CommandLineTool::isCommand(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        CommandLineTool tool;
+        return tool.run(app.arguments());
+    }
+
     QApplication a(argc, argv);
     QApplication::setStyle("Fusion");
     SaveLoadManager saveLoadManager;
@@ -0,0 +1,184 @@
+/**
+ * @file previewwindow.cpp
+ * @brief Implements the logic for the PreviewWindow class which renders animated previews
+ * of sprite frames at user-defined speed and resolution.
+ *
+ * @date 03/31/2025
+ */
+
+#include "previewwindow.h"
+#include "ui_previewwindow.h"
+#include "canvasrenderer.h"
+#include "tracer.h"
+
+#include <QSignalBlocker>
+
+#include <algorithm>
+
+using std::vector;
+
+PreviewWindow::PreviewWindow(FrameManager* frameManager, int height, int width, QWidget* parent) :
+    QMainWindow(parent),
+    ui(new Ui::previewwindow),
+    actualHeight(height),
+    actualWidth(width),
+    sprite(QImage(actualWidth, actualHeight, QImage::Format_ARGB32)),
+    frameManager(frameManager)
+{
+    ui->setupUi(this);
+
+    // A precise single-shot timer is restarted for each frame, so it can wake up at the frame's own end
+    playbackTimer.setSingleShot(true);
+    playbackTimer.setTimerType(Qt::PreciseTimer);
+
+    // Connect signal to fetch all frames from FrameManager when animation starts
+    connect(this,
+            &PreviewWindow::getFrames,
+            frameManager,
+            &FrameManager::sendFrames
+    );
+
+    // Forward FPS slider changes so the editor can reuse the playback speed
+    connect(ui->fpsSlider,
+            &QSlider::valueChanged,
+            this,
+            &PreviewWindow::fpsChanged
+    );
+
+    // Rebuild the timeline when the playback speed or a frame's duration changes
+    connect(ui->fpsSlider,
+            &QSlider::valueChanged,
+            this,
+            [this]() { reloadFrames(); }
+    );
+
+    connect(frameManager,
+            &FrameManager::frameDurationChanged,
+            this,
+            [this]() { reloadFrames(); }
+    );
+
+    // Connect the timer to showing the next frame when the one on screen ends
+    connect(&playbackTimer,
+            &QTimer::timeout,
+            this,
+            &PreviewWindow::advancePlayback
+    );
+
+    // Connect the timeline slider to scrubbing through the animation
+    connect(ui->timelineSlider,
+            &QSlider::valueChanged,
+            this,
+            &PreviewWindow::seek
+    );
+
+    reloadFrames();
+    showFrameAt(0);
+}
+
+PreviewWindow::~PreviewWindow() {
+    delete ui;
+}
+
+void PreviewWindow::animation() {
+    if (!ui->animateButton->isChecked()) {
+        playbackTimer.stop();
+        return;
+    }
+
+    // Playback starts from the frame on screen
+    reloadFrames();
+    playbackOrigin = timeline.frameStart(shownFrame);
+    playbackClock.start();
+    advancePlayback();
+}
+
+void PreviewWindow::seek(int frameIndex) {
+    if (frameIndex < 0 || frameIndex >= timeline.frameCount()) {
+        return;
+    }
+
+    if (!playbackTimer.isActive()) {
+        showFrameAt(frameIndex);
+        return;
+    }
+
+    playbackOrigin = timeline.frameStart(frameIndex);
+    playbackClock.restart();
+    advancePlayback();
+}
+
+int PreviewWindow::defaultDuration() const {
+    return 1000 / std::max(ui->fpsSlider->value(), 1);
+}
+
+void PreviewWindow::reloadFrames() {
+    frames = emit getFrames();
+    timeline = frameManager->timeline(defaultDuration());
+    int lastFrame = std::max(timeline.frameCount() - 1, 0);
+    shownFrame = std::min(shownFrame, lastFrame);
+
+    {
+        QSignalBlocker blocker(ui->timelineSlider);
+        ui->timelineSlider->setRange(0, lastFrame);
+        ui->timelineSlider->setValue(shownFrame);
+    }
+
+    // A running animation continues from the start of the frame on screen
+    if (playbackTimer.isActive()) {
+        playbackOrigin = timeline.frameStart(shownFrame);
+        playbackClock.restart();
+        advancePlayback();
+    }
+}
+
+void PreviewWindow::showFrameAt(int frameIndex) {
+    if (frameIndex < 0 || frameIndex >= static_cast<int>(frames.size())) {
+        return;
+    }
+
+    shownFrame = frameIndex;
+
+    // Following playback with the slider must not seek again
+    {
+        QSignalBlocker blocker(ui->timelineSlider);
+        ui->timelineSlider->setValue(frameIndex);
+    }
+
+    showFrame(frames[frameIndex]);
+}
+
+void PreviewWindow::advancePlayback() {
+    if (!ui->animateButton->isChecked() || !this->isVisible() || timeline.frameCount() == 0) {
+        playbackTimer.stop();
+        return;
+    }
+
+    // The frame comes from the total time played, so late timer wake-ups never add up to drift
+    qint64 time = playbackOrigin + playbackClock.elapsed();
+    int frameIndex = timeline.frameAtLooped(time);
+    showFrameAt(frameIndex);
+
+    qint64 remaining = timeline.frameEnd(frameIndex) - time % timeline.totalDuration();
+    playbackTimer.start(static_cast<int>(remaining));
+}
+
+void PreviewWindow::showFrame(Frame frame) {
+
+    // Dimensions of the QLabel display area
+    QSize labelSize = ui->spriteLabel->size();
+
+    // Sets the size to pixel size of the radio button is checked.
+    bool actualSize = ui->actualSizeRadio->isChecked();
+
+    if (actualSize) {
+        labelSize = QSize(actualWidth, actualHeight);
+    }
+
+    {
+        TRACE_SCOPE("PreviewWindow::showFrame render");
+        sprite = frame.toImage();
+        QImage canvas = CanvasRenderer::render(sprite, labelSize, false);
+        ui->spriteLabel->setPixmap(QPixmap::fromImage(canvas));
+    }
+}
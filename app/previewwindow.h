@@ -6,15 +6,17 @@
  * @brief Declares the PreviewWindow class, which displays animated previews of sprite frames.
  *
  * The PreviewWindow connects to the FrameManager to retrieve all current frames and
- * animates them at a configurable FPS. It also supports toggling between scaled preview
- * and actual pixel size.
+ * animates them, holding each for its own duration or 1/FPS seconds. It also supports
+ * scrubbing through the animation and toggling between scaled preview and actual pixel size.
  *
  * @date 03/31/2025
  */
 
 #include "frame.h"
 #include "framemanager.h"
+#include "playbacktimeline.h"
 
+#include <QElapsedTimer>
 #include <QMainWindow>
 #include <QTimer>
 #include <QImage>
@@ -31,6 +33,9 @@ namespace Ui { class previewwindow; }
  *
  * This class is responsible for retrieving frames from FrameManager and displaying them
  * in a looped animation using QLabel and QPainter. It supports resolution scaling and FPS control.
+ *
+ * The frame on screen is always looked up in a PlaybackTimeline from the time played so far, and a
+ * single-shot timer wakes up when that frame ends, so playback stays on time however long it runs.
  */
 class PreviewWindow : public QMainWindow {
     Q_OBJECT
@@ -73,16 +78,79 @@ private:
      */
     QImage sprite;
 
+    /**
+     * @brief The FrameManager whose frames are previewed.
+     */
+    FrameManager* frameManager;
+
+    /**
+     * @brief The frames being played, fetched when playback starts.
+     */
+    vector<Frame> frames;
+
+    /**
+     * @brief When each frame of frames starts and ends.
+     */
+    PlaybackTimeline timeline;
+
+    /**
+     * @brief Fires when the frame on screen ends.
+     */
+    QTimer playbackTimer;
+
+    /**
+     * @brief Measures the time played since playbackOrigin.
+     */
+    QElapsedTimer playbackClock;
+
+    /**
+     * @brief The timeline position, in milliseconds, where playbackClock was started.
+     */
+    qint64 playbackOrigin = 0;
+
+    /**
+     * @brief The index of the frame on screen.
+     */
+    int shownFrame = 0;
+
+    /**
+     * @brief Returns how long frames without their own duration are shown, from the FPS slider.
+     * @return The duration in milliseconds.
+     */
+    int defaultDuration() const;
+
+    /**
+     * @brief Fetches the frames and rebuilds the timeline from their durations and the FPS, staying on the frame on screen.
+     */
+    void reloadFrames();
+
+    /**
+     * @brief Shows a frame of frames and moves the timeline slider to it.
+     * @param frameIndex The frame to show.
+     */
+    void showFrameAt(int frameIndex);
+
+    /**
+     * @brief Shows the frame due at the current playback time and waits for it to end.
+     */
+    void advancePlayback();
+
 public slots:
 
     /**
      * @brief Starts or stops the animation based on user interaction.
      *
-     * Continuously cycles through all frames while the animate toggle is active
+     * Loops through all frames from the one on screen while the animate toggle is active
      * and the preview window remains visible.
      */
     void animation();
 
+    /**
+     * @brief Jumps to a frame, continuing playback from its start if the animation is running.
+     * @param frameIndex The frame to jump to.
+     */
+    void seek(int frameIndex);
+
     /**
      * @brief Renders a single frame in the preview display.
      * @param frame The Frame object to be rendered.
@@ -97,6 +165,12 @@ signals:
      * @return A vector of all current frames in the project.
      */
     vector<Frame> getFrames();
+
+    /**
+     * @brief Emitted when the user changes the playback speed.
+     * @param fps The new frames per second.
+     */
+    void fpsChanged(int fps);
 };
 
 #endif // PREVIEWWINDOW_H
@@ -0,0 +1,59 @@
+/**
+ * @file selectionoverlay.cpp
+ * @brief Implementation of the SelectionOverlay class.
+ * @date 03/31/2025
+ */
+
+#include "selectionoverlay.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+
+SelectionOverlay::SelectionOverlay(QWidget* canvas) : QWidget(canvas) {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setGeometry(canvas->rect());
+    show();
+}
+
+void SelectionOverlay::setSelection(const QRect& newSelection, const QImage& newFloating, QSize newSpriteSize, const CanvasView& newView) {
+    setGeometry(parentWidget()->rect());
+
+    selection = newSelection;
+    floating = newFloating;
+    spriteSize = newSpriteSize;
+    view = newView;
+
+    // The marquee is drawn just outside the cells, so grow the dirty area by its width
+    QRect area = view.cellRect(selection);
+    area = area.isEmpty() ? QRect() : area.adjusted(-2, -2, 2, 2);
+
+    update(shownArea | area);
+    shownArea = area;
+}
+
+void SelectionOverlay::paintEvent(QPaintEvent* event) {
+    if (selection.isEmpty()) {
+        return;
+    }
+
+    QPainter painter(this);
+    painter.setClipRect(event->rect());
+    QRect area = view.cellRect(selection);
+
+    // Scale the floating pixels up to whole cells without smoothing
+    if (!floating.isNull()) {
+        QRect spriteArea = view.cellRect(QRect(QPoint(0, 0), spriteSize));
+        painter.save();
+        painter.setClipRect(spriteArea & event->rect());
+        painter.drawImage(area, floating);
+        painter.restore();
+    }
+
+    // Black and white dashes stay visible on any color
+    QRect marquee = area.adjusted(-1, -1, 0, 0);
+    painter.setPen(QPen(Qt::black, 1));
+    painter.drawRect(marquee);
+    painter.setPen(QPen(Qt::white, 1, Qt::DashLine));
+    painter.drawRect(marquee);
+}
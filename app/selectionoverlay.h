@@ -0,0 +1,84 @@
+#ifndef SELECTIONOVERLAY_H
+#define SELECTIONOVERLAY_H
+
+/**
+ * @file selectionoverlay.h
+ * @brief Declares the SelectionOverlay class, which draws the selection marquee and floating pixels.
+ *
+ * A lifted or pasted selection floats above the canvas until it is committed. The overlay composites
+ * it over the canvas label, repainting only the area the selection covered and now covers, so moving
+ * it does not touch the sprite, the frame or the rendered canvas.
+ *
+ * @date 03/31/2025
+ */
+
+#include "canvasview.h"
+
+#include <QImage>
+#include <QWidget>
+
+/**
+ * @class SelectionOverlay
+ *
+ * @brief Transparent layer over the canvas showing the selection.
+ *
+ * The overlay covers its parent and ignores mouse events, so the canvas keeps receiving them.
+ */
+class SelectionOverlay : public QWidget {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Creates an empty overlay covering the given canvas widget.
+     * @param canvas The widget showing the canvas.
+     */
+    explicit SelectionOverlay(QWidget* canvas);
+
+    /**
+     * @brief Shows a selection, repainting the area it used to cover and now covers.
+     * @param selection The selected cells in sprite coordinates; empty for no selection.
+     * @param floating Pixels floating above the canvas at the selection, or a null image.
+     * @param spriteSize Size of the sprite, which clips the floating pixels.
+     * @param view The canvas zoom and pan, to lay the cells out like the canvas does.
+     */
+    void setSelection(const QRect& selection, const QImage& floating, QSize spriteSize, const CanvasView& view);
+
+protected:
+
+    /**
+     * @brief Paints the floating pixels and the marquee within the dirty area.
+     * @param event The paint event.
+     */
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+
+    /**
+     * @brief The selected cells.
+     */
+    QRect selection;
+
+    /**
+     * @brief Pixels floating at the selection, if any.
+     */
+    QImage floating;
+
+    /**
+     * @brief Size of the sprite the selection is on.
+     */
+    QSize spriteSize;
+
+    /**
+     * @brief Zoom and pan of the canvas the selection is on.
+     */
+    CanvasView view;
+
+    /**
+     * @brief Area of the widget covered by the selection and its marquee.
+     */
+    QRect shownArea;
+
+};
+
+#endif // SELECTIONOVERLAY_H
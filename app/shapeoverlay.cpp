@@ -0,0 +1,55 @@
+/**
+ * @file shapeoverlay.cpp
+ * @brief Implementation of the ShapeOverlay class.
+ * @date 03/31/2025
+ */
+
+#include "shapeoverlay.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+
+ShapeOverlay::ShapeOverlay(QWidget* canvas) : QWidget(canvas) {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setGeometry(canvas->rect());
+    show();
+}
+
+void ShapeOverlay::setShape(const vector<PixelSpan>& newSpans, QColor newColor, const CanvasView& newView) {
+    setGeometry(parentWidget()->rect());
+
+    spans = newSpans;
+    color = newColor;
+    view = newView;
+
+    QRect area = view.cellRect(ShapeRasterizer::bounds(spans));
+
+    // Repaint where the shape was and where it is now; the rest of the canvas is untouched
+    update(shownArea | area);
+    shownArea = area;
+}
+
+void ShapeOverlay::clear() {
+    spans.clear();
+    update(shownArea);
+    shownArea = QRect();
+}
+
+void ShapeOverlay::paintEvent(QPaintEvent* event) {
+    if (spans.empty()) {
+        return;
+    }
+
+    QPainter painter(this);
+    painter.setClipRect(event->rect());
+
+    for (const PixelSpan& span : spans) {
+        QRect cells(span.left, span.y, span.right - span.left + 1, 1);
+        QRect area = view.cellRect(cells);
+
+        if (area.intersects(event->rect())) {
+            painter.fillRect(area, color);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef SHAPEOVERLAY_H
+#define SHAPEOVERLAY_H
+
+/**
+ * @file shapeoverlay.h
+ * @brief Declares the ShapeOverlay class, a transparent layer that previews a shape over the canvas.
+ *
+ * While a shape is dragged, only the overlay is repainted, and only the area covered by the old and
+ * new shape. The sprite, its frame and the rendered canvas are left alone until the shape is committed.
+ *
+ * @date 03/31/2025
+ */
+
+#include "canvasview.h"
+#include "shaperasterizer.h"
+
+#include <QColor>
+#include <QWidget>
+
+using std::vector;
+
+/**
+ * @class ShapeOverlay
+ *
+ * @brief Draws the candidate shape's cells on top of the canvas label.
+ *
+ * The overlay covers its parent and ignores mouse events, so the canvas keeps receiving them.
+ */
+class ShapeOverlay : public QWidget {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Creates an empty overlay covering the given canvas widget.
+     * @param canvas The widget showing the canvas.
+     */
+    explicit ShapeOverlay(QWidget* canvas);
+
+    /**
+     * @brief Replaces the previewed shape and repaints the area it used to cover and now covers.
+     * @param spans The shape's pixels in sprite coordinates.
+     * @param color The color to preview the shape in.
+     * @param view The canvas zoom and pan, to lay the cells out like the canvas does.
+     */
+    void setShape(const vector<PixelSpan>& spans, QColor color, const CanvasView& view);
+
+    /**
+     * @brief Removes the previewed shape.
+     */
+    void clear();
+
+protected:
+
+    /**
+     * @brief Paints the shape's cells within the dirty area.
+     * @param event The paint event.
+     */
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+
+    /**
+     * @brief The previewed shape's pixels.
+     */
+    vector<PixelSpan> spans;
+
+    /**
+     * @brief The previewed shape's color.
+     */
+    QColor color;
+
+    /**
+     * @brief Zoom and pan of the canvas the shape is drawn on.
+     */
+    CanvasView view;
+
+    /**
+     * @brief Area of the widget covered by the previewed shape.
+     */
+    QRect shownArea;
+
+};
+
+#endif // SHAPEOVERLAY_H
@@ -0,0 +1,35 @@
+/**
+ * @file spritecanvas.cpp
+ * @brief Implementation of the SpriteCanvas class.
+ * @date 03/31/2025
+ */
+
+#include "spritecanvas.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+#include <QResizeEvent>
+
+SpriteCanvas::SpriteCanvas(QWidget* parent) : QWidget(parent) {}
+
+QImage& SpriteCanvas::image() {
+    return backing;
+}
+
+void SpriteCanvas::paintEvent(QPaintEvent* event) {
+    if (backing.isNull()) {
+        return;
+    }
+
+    // The background is translucent, so the image is blended over the window like the old label's pixmap
+    QPainter painter(this);
+
+    for (const QRect& rect : event->region()) {
+        painter.drawImage(rect.topLeft(), backing, rect);
+    }
+}
+
+void SpriteCanvas::resizeEvent(QResizeEvent* event) {
+    backing = QImage(event->size(), QImage::Format_ARGB32_Premultiplied);
+    emit resized();
+}
@@ -0,0 +1,75 @@
+#ifndef SPRITECANVAS_H
+#define SPRITECANVAS_H
+
+/**
+ * @file spritecanvas.h
+ * @brief Declares the SpriteCanvas class, the editor's drawing surface.
+ *
+ * The canvas keeps the rendered sprite in a backing image the size of the widget. The editor redraws
+ * only the changed cells into that image and asks for a repaint of just their area, and paintEvent
+ * copies only the exposed part to the screen, so a brush dab costs a few cells instead of a full
+ * pixmap upload.
+ *
+ * @date 03/31/2025
+ */
+
+#include <QImage>
+#include <QWidget>
+
+/**
+ * @class SpriteCanvas
+ *
+ * @brief Widget that shows a backing image and repaints only what is exposed.
+ */
+class SpriteCanvas : public QWidget {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Creates a canvas with an empty backing image.
+     * @param parent The parent widget.
+     */
+    explicit SpriteCanvas(QWidget* parent = nullptr);
+
+    /**
+     * @brief Returns the backing image to draw into.
+     *
+     * The image is ARGB32_Premultiplied and always the size of the widget. Call update() with the
+     * changed area after drawing into it.
+     *
+     * @return The backing image.
+     */
+    QImage& image();
+
+signals:
+
+    /**
+     * @brief Emitted after a resize, once the backing image has the new size and needs redrawing.
+     */
+    void resized();
+
+protected:
+
+    /**
+     * @brief Copies the exposed part of the backing image to the screen.
+     * @param event The paint event.
+     */
+    void paintEvent(QPaintEvent* event) override;
+
+    /**
+     * @brief Resizes the backing image to the widget.
+     * @param event The resize event.
+     */
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+
+    /**
+     * @brief The rendered canvas, the size of the widget.
+     */
+    QImage backing;
+
+};
+
+#endif // SPRITECANVAS_H
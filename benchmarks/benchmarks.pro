@@ -0,0 +1,12 @@
+TEMPLATE = app
+TARGET = spritebenchmarks
+
+QT       += testlib
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../spritecore/spritecore.pri)
+
+SOURCES += \
+    spritebenchmarks.cpp
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Compare two spritebenchmarks CSV result files.
+
+Produce the files with:
+    spritebenchmarks -o results.csv,csv
+
+No baseline is checked in, since timings only compare on the same machine. Make one
+from the commit to compare against, built the same way, before building the change:
+    git stash && make && benchmarks/spritebenchmarks -o baseline.csv,csv && git stash pop
+
+Usage:
+    compare_baseline.py baseline.csv results.csv [--threshold PERCENT]
+
+Prints the change of every benchmark found in both files and exits with status 1
+if any benchmark got slower than the threshold (default 10%).
+"""
+
+import argparse
+import csv
+import sys
+
+
+def read_results(path):
+    results = {}
+    with open(path, newline="") as handle:
+        for row in csv.reader(handle):
+            if len(row) < 4:
+                continue
+            try:
+                value = float(row[3])
+            except ValueError:
+                continue
+            results[(row[0], row[1], row[2])] = value
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare benchmark results against a baseline.")
+    parser.add_argument("baseline")
+    parser.add_argument("results")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent before failing")
+    args = parser.parse_args()
+
+    baseline = read_results(args.baseline)
+    results = read_results(args.results)
+    regressions = 0
+
+    for key in sorted(baseline.keys() & results.keys()):
+        before = baseline[key]
+        after = results[key]
+        # Allocation counts are often zero, where any increase is a regression
+        if before > 0:
+            change = (after - before) / before * 100.0
+        else:
+            change = float("inf") if after > 0 else 0.0
+        marker = ""
+
+        if change > args.threshold:
+            marker = "  REGRESSION"
+            regressions += 1
+
+        print("%-24s %-22s %-22s %14.6g -> %14.6g  %+7.1f%%%s"
+              % (key[0], key[1], key[2], before, after, change, marker))
+
+    for key in sorted(baseline.keys() - results.keys()):
+        print("%-24s %-22s missing from results" % (key[0], key[1]))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,699 @@
+/**
+ * @file spritebenchmarks.cpp
+ * @brief QTest benchmarks for the frame, rendering and file I/O hot paths of spritecore.
+ *
+ * Every benchmark is data driven over sprite sizes (16, 64, 512 and 2048 pixels square) and, for
+ * save/load and frame batches, over project lengths (1, 50 and 500 frames). Combinations that would not fit in memory
+ * or would take minutes per iteration are skipped.
+ *
+ * Write machine-readable results with QTest's own output options, for example
+ *     spritebenchmarks -o results.csv,csv
+ * and compare them against a stored baseline with compare_baseline.py.
+ *
+ * @date 03/31/2025
+ */
+
+#include "brushstamp.h"
+#include "canvasrenderer.h"
+#include "canvasview.h"
+#include "floodfill.h"
+#include "frame.h"
+#include "framebufferpool.h"
+#include "framebatchrunner.h"
+#include "framelistmodel.h"
+#include "framemanager.h"
+#include "inbetweengenerator.h"
+#include "pixelblend.h"
+#include "pixelblit.h"
+#include "playbacktimeline.h"
+#include "saveloadmanager.h"
+#include "shaperasterizer.h"
+#include "spritemipmaps.h"
+#include "thumbnailcache.h"
+
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <cstring>
+#include <functional>
+
+/**
+ * @brief Largest project, in total pixels, written and read in the binary format.
+ */
+static const qint64 maxBinaryProjectPixels = qint64(1) << 25;
+
+/**
+ * @brief Largest project, in total pixels, written and read in the JSON format.
+ */
+static const qint64 maxJsonProjectPixels = qint64(1) << 20;
+
+/**
+ * @brief Canvas size used by the editor and preview windows.
+ */
+static const QSize canvasSize(500, 500);
+
+/**
+ * @brief Fills a frame with reproducible random colors.
+ */
+static void fillRandom(Frame& frame, quint32 seed) {
+    QRandomGenerator generator(seed);
+
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        generator.fillRange(frame.scanLine(y), frame.getWidth());
+    }
+}
+
+/**
+ * @class SpriteBenchmarks
+ *
+ * @brief Benchmarks for Frame, FrameManager, canvas rendering and SaveLoadManager.
+ */
+class SpriteBenchmarks : public QObject {
+    Q_OBJECT
+
+private:
+
+    void addSizeRows() {
+        QTest::addColumn<int>("size");
+
+        for (int size : {16, 64, 512, 2048}) {
+            QTest::newRow(qPrintable(QString("%1px").arg(size))) << size;
+        }
+    }
+
+    void addProjectRows() {
+        QTest::addColumn<int>("size");
+        QTest::addColumn<int>("frameCount");
+
+        for (int size : {16, 64, 512, 2048}) {
+            for (int frameCount : {1, 50, 500}) {
+                QTest::newRow(qPrintable(QString("%1px/%2frames").arg(size).arg(frameCount))) << size << frameCount;
+            }
+        }
+    }
+
+    /**
+     * @brief Reports the pixel buffers an operation allocates per run as the test's benchmark result.
+     *
+     * The operation runs once to fill the buffer pool, then its allocations are counted over a few more
+     * runs. The result is recorded as events, so it lands in the same result files as the timings and
+     * compare_baseline.py flags an operation that stops reusing buffers.
+     */
+    void reportAllocations(const std::function<void()>& operation) {
+        const int runs = 4;
+        operation();
+        FrameBufferPool::instance().resetStatistics();
+
+        for (int i = 0; i < runs; ++i) {
+            operation();
+        }
+        QTest::setBenchmarkResult(FrameBufferPool::instance().statistics().allocations / double(runs), QTest::Events);
+    }
+
+    void fillProject(FrameManager& manager, int frameCount) {
+
+        // Keep every frame expanded, so results do not depend on the memory budget
+        manager.setMemoryBudget(0);
+
+        for (int i = 0; i < frameCount; ++i) {
+            Frame frame(manager.height, manager.width);
+            fillRandom(frame, i + 1);
+            manager.addFrameJson(frame);
+        }
+    }
+
+private slots:
+
+    void frameConstruction_data() { addSizeRows(); }
+    void frameConstruction() {
+        QFETCH(int, size);
+
+        // Each frame reuses the buffer the previous iteration gave back
+        QBENCHMARK {
+            Frame frame(size, size);
+            Q_UNUSED(frame);
+        }
+    }
+
+    void frameConstructionAllocations_data() { addSizeRows(); }
+    void frameConstructionAllocations() {
+        QFETCH(int, size);
+
+        reportAllocations([size]() {
+            Frame frame(size, size);
+            Q_UNUSED(frame);
+        });
+    }
+
+    void frameRecycling_data() { addSizeRows(); }
+    void frameRecycling() {
+        QFETCH(int, size);
+        FrameManager manager(size, size);
+        fillProject(manager, 1);
+
+        // Adding a frame after deleting one should take the deleted frame's buffer, not new memory
+        QBENCHMARK {
+            manager.addFrame();
+            manager.deleteFrame(static_cast<int>(manager.frames.size()) - 1);
+        }
+    }
+
+    void frameRecyclingAllocations_data() { addSizeRows(); }
+    void frameRecyclingAllocations() {
+        QFETCH(int, size);
+        FrameManager manager(size, size);
+        fillProject(manager, 1);
+
+        reportAllocations([&manager]() {
+            manager.addFrame();
+            manager.deleteFrame(static_cast<int>(manager.frames.size()) - 1);
+        });
+    }
+
+    void updateFrame_data() { addSizeRows(); }
+    void updateFrame() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+
+        // One full pass of single-pixel updates, as a drag across every cell would produce
+        QBENCHMARK {
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    frame.updateFrame(y, x, x & 0xff, y & 0xff, 128, 255);
+                }
+            }
+        }
+    }
+
+    void rotateFrame_data() { addSizeRows(); }
+    void rotateFrame() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+
+        QBENCHMARK {
+            frame.rotateFrame();
+        }
+    }
+
+    void contentHash_data() { addSizeRows(); }
+    void contentHash() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+
+        // Writing a row drops the cached hash, so every iteration hashes the whole frame
+        QBENCHMARK {
+            frame.scanLine(0)[0] ^= 1;
+            Q_UNUSED(frame.contentHash());
+        }
+    }
+
+    void renderThumbnail_data() { addSizeRows(); }
+    void renderThumbnail() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+
+        QBENCHMARK {
+            QImage thumbnail = ThumbnailCache::render(frame, QSize(48, 48));
+            Q_UNUSED(thumbnail);
+        }
+    }
+
+    void getPixels_data() { addSizeRows(); }
+    void getPixels() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+
+        QBENCHMARK {
+            vector<vector<QColor>> pixels = frame.getPixels();
+            Q_UNUSED(pixels);
+        }
+    }
+
+    void copyFrame_data() { addSizeRows(); }
+    void copyFrame() {
+        QFETCH(int, size);
+        FrameManager manager(size, size);
+        fillProject(manager, 1);
+
+        // Drop the copy again so long runs do not exhaust memory
+        QBENCHMARK {
+            manager.copyFrame(0);
+            manager.deleteFrame(static_cast<int>(manager.frames.size()) - 1);
+        }
+    }
+
+    void moveFrame_data() { addProjectRows(); }
+    void moveFrame() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+        FrameManager manager(size, size);
+        fillProject(manager, 1);
+
+        // Copies share the first frame's pixels, so even the largest projects fit in memory
+        for (int i = 1; i < frameCount; ++i) {
+            manager.copyFrame(0);
+        }
+
+        // Moving the first frame to the end and back only rotates handles, whatever the frame size
+        QBENCHMARK {
+            manager.moveFrames(0, 0, frameCount);
+            manager.moveFrames(frameCount - 1, frameCount - 1, 0);
+        }
+    }
+
+    void frameListModel_data() {
+        QTest::addColumn<int>("frameCount");
+
+        for (int frameCount : {500, 10000}) {
+            QTest::newRow(qPrintable(QString("%1frames").arg(frameCount))) << frameCount;
+        }
+    }
+
+    void frameListModel() {
+        QFETCH(int, frameCount);
+        FrameManager manager(16, 16);
+        fillProject(manager, 1);
+
+        for (int i = 1; i < frameCount; ++i) {
+            manager.copyFrame(0);
+        }
+
+        // Opening the frame stack costs one screen of rows, however long the animation is
+        QBENCHMARK {
+            FrameListModel model(&manager);
+
+            for (int row = 0; row < 30; ++row) {
+                QModelIndex index = model.index(row);
+                model.data(index, Qt::DisplayRole);
+                model.data(index, Qt::DecorationRole);
+            }
+        }
+    }
+
+    void updateCanvas_data() { addSizeRows(); }
+    void updateCanvas() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+        QImage sprite = frame.toImage();
+
+        QBENCHMARK {
+            QImage canvas = CanvasRenderer::render(sprite, canvasSize, true);
+            Q_UNUSED(canvas);
+        }
+    }
+
+    void renderZoomed_data() {
+        QTest::addColumn<int>("size");
+        QTest::addColumn<double>("scale");
+
+        for (int size : {64, 2048}) {
+            for (double scale : {1.0 / 8, 1.0, 8.0}) {
+                QTest::newRow(qPrintable(QString("%1px x%2").arg(size).arg(scale))) << size << scale;
+            }
+        }
+    }
+    void renderZoomed() {
+        QFETCH(int, size);
+        QFETCH(double, scale);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+        QImage sprite = frame.toImage();
+
+        SpriteMipmaps mipmaps;
+        mipmaps.update(sprite, sprite.rect());
+
+        // Zoom around the sprite's center, so zoomed-in views are culled to a part of it
+        QPoint center(canvasSize.width() / 2, canvasSize.height() / 2);
+        CanvasView view(scale, center - QPoint(qRound(size * scale / 2), qRound(size * scale / 2)));
+
+        QBENCHMARK {
+            QImage canvas = CanvasRenderer::render(sprite, canvasSize, view, true, &mipmaps);
+            Q_UNUSED(canvas);
+        }
+    }
+
+    void redrawDab_data() { addSizeRows(); }
+    void redrawDab() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+        QImage sprite = frame.toImage();
+
+        CanvasView view = CanvasView::fit(canvasSize, sprite.size());
+        QImage canvas = CanvasRenderer::render(sprite, canvasSize, view, true);
+
+        // The editor redraws only the cells a brush dab changed, plus a pixel of margin
+        QRect dab(size / 2, size / 2, qMin(size / 2, 4), qMin(size / 2, 4));
+        QRect area = view.cellRect(dab).adjusted(-1, -1, 1, 1);
+
+        QBENCHMARK {
+            CanvasRenderer::render(canvas, sprite, view, true, nullptr, area);
+        }
+    }
+
+    void updateMipmaps_data() { addSizeRows(); }
+    void updateMipmaps() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+        QImage sprite = frame.toImage();
+
+        SpriteMipmaps mipmaps;
+        mipmaps.update(sprite, sprite.rect());
+
+        // A brush dab only refreshes the levels above it
+        QRect dab(size / 2, size / 2, qMin(size / 2, 16), qMin(size / 2, 16));
+
+        QBENCHMARK {
+            mipmaps.update(sprite, dab);
+        }
+    }
+
+    void switchCanvas_data() { addSizeRows(); }
+    void switchCanvas() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+        QImage sprite(size, size, QImage::Format_ARGB32);
+
+        // The editor copies the frame into its sprite image a row at a time, then redraws
+        QBENCHMARK {
+            for (int y = 0; y < size; ++y) {
+                memcpy(sprite.scanLine(y), frame.constScanLine(y), static_cast<size_t>(size) * sizeof(QRgb));
+            }
+
+            QImage canvas = CanvasRenderer::render(sprite, canvasSize, true);
+            Q_UNUSED(canvas);
+        }
+    }
+
+    void previewShowFrame_data() { addSizeRows(); }
+    void previewShowFrame() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+
+        QBENCHMARK {
+            QImage canvas = CanvasRenderer::render(frame.toImage(), canvasSize, false);
+            Q_UNUSED(canvas);
+        }
+    }
+
+    void floodFill_data() { addSizeRows(); }
+    void floodFill() {
+        QFETCH(int, size);
+        QImage sprite(size, size, QImage::Format_ARGB32);
+        sprite.fill(Qt::transparent);
+        QRgb colors[] = {qRgba(255, 0, 0, 255), qRgba(0, 0, 255, 255)};
+        int pass = 0;
+
+        // Alternate colors so every iteration refills the whole canvas
+        QBENCHMARK {
+            FloodFill::fill(sprite, QPoint(size / 2, size / 2), colors[pass++ % 2], 0, FloodFill::Contiguous);
+        }
+    }
+
+    void replaceColor_data() { addSizeRows(); }
+    void replaceColor() {
+        QFETCH(int, size);
+        Frame frame(size, size);
+        fillRandom(frame, 1);
+        QImage sprite = frame.toImage();
+        QRgb colors[] = {qRgba(255, 0, 0, 255), qRgba(0, 0, 255, 255)};
+        int pass = 0;
+
+        QBENCHMARK {
+            FloodFill::fill(sprite, QPoint(0, 0), colors[pass++ % 2], 64, FloodFill::Global);
+        }
+    }
+
+    void drawEllipse_data() { addSizeRows(); }
+    void drawEllipse() {
+        QFETCH(int, size);
+        QImage sprite(size, size, QImage::Format_ARGB32);
+        sprite.fill(Qt::transparent);
+
+        // One drag step of the ellipse tool followed by its commit
+        QBENCHMARK {
+            vector<PixelSpan> spans = ShapeRasterizer::ellipse(QPoint(0, 0), QPoint(size - 1, size - 1), false);
+            ShapeRasterizer::paint(sprite, spans, qRgba(255, 0, 0, 255));
+        }
+    }
+
+    void brushStroke_data() { addSizeRows(); }
+    void brushStroke() {
+        QFETCH(int, size);
+        FrameManager manager(size, size);
+        fillProject(manager, 1);
+        QImage sprite = manager.frames[0].toImage();
+        BrushStamp brush(BrushStamp::Round, BrushStamp::maximumSize);
+
+        // One mouse move's worth of a large, four-way symmetric stroke, then its commit, inside the
+        // undo step the editor opens for the whole drag
+        manager.beginUndoStep("Draw");
+
+        QBENCHMARK {
+            QRegion changed = brush.stroke(sprite, QPoint(0, 0), QPoint(size / 8, size / 8), qRgba(255, 0, 0, 255), BrushStamp::BothAxes);
+            manager.updateFrameRegion(0, sprite, changed);
+        }
+    }
+
+    void blendSpan_data() {
+        QTest::addColumn<int>("mode");
+
+        const char* names[] = {"Replace", "Normal", "Multiply", "Screen", "Add", "AlphaLock"};
+
+        for (int mode = PixelBlend::Replace; mode <= PixelBlend::AlphaLock; ++mode) {
+            QTest::newRow(names[mode]) << mode;
+        }
+    }
+    void blendSpan() {
+        QFETCH(int, mode);
+        PixelBlend::Mode blendMode = static_cast<PixelBlend::Mode>(mode);
+        const int length = 2048;
+        QRgb paint = qRgba(200, 120, 40, 160);
+        vector<QRgb> pixels(length);
+        QRandomGenerator(1).fillRange(pixels.data(), length);
+
+        // One row of a large brush stamp or fill
+        QBENCHMARK {
+            vector<QRgb> row = pixels;
+            PixelBlend::blendSpan(row.data(), length, paint, blendMode);
+        }
+    }
+
+    void moveSelection_data() { addSizeRows(); }
+    void moveSelection() {
+        QFETCH(int, size);
+        FrameManager manager(size, size);
+        fillProject(manager, 1);
+        QImage sprite = manager.frames[0].toImage();
+        QRect selection(size / 4, size / 4, size / 2, size / 2);
+
+        // Lift half the sprite, drop it one cell over, and commit the union to the frame
+        QBENCHMARK {
+            QImage floating = PixelBlit::copy(sprite, selection);
+            QRect changed = PixelBlit::fill(sprite, selection, qRgba(255, 255, 255, 0));
+            changed |= PixelBlit::paste(sprite, floating, selection.topLeft() + QPoint(1, 1));
+            manager.updateFrameRegion(0, sprite, changed);
+        }
+    }
+
+    void invertFrames_data() { addProjectRows(); }
+    void invertFrames() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+
+        if (qint64(size) * size * frameCount > maxBinaryProjectPixels) {
+            QSKIP("Project too large for the batch benchmark");
+        }
+
+        FrameManager manager(size, size);
+        fillProject(manager, frameCount);
+        FrameBatchRunner runner(&manager);
+        QSignalSpy finished(&runner, &FrameBatchRunner::finished);
+
+        // Clearing the history first frees the frames the previous iteration replaced
+        QBENCHMARK {
+            manager.clearUndoHistory();
+            QVERIFY(runner.start(0, frameCount - 1, FrameBatchRunner::invertColors, "Invert Colors"));
+            QVERIFY(finished.wait(60000));
+        }
+    }
+
+    void scaleFrames_data() { addProjectRows(); }
+    void scaleFrames() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+
+        // The doubled frames hold four times the pixels
+        if (qint64(size) * size * frameCount * 4 > maxBinaryProjectPixels) {
+            QSKIP("Project too large for the scaling benchmark");
+        }
+
+        FrameManager manager(size, size);
+        fillProject(manager, frameCount);
+
+        // Enlarge with the pixel-art upscaler and shrink back with the box filter, so every iteration starts alike
+        QBENCHMARK {
+            QVERIFY(manager.scaleFrames(size * 2, size * 2, SpriteResampler::Scale2x));
+            QVERIFY(manager.scaleFrames(size, size, SpriteResampler::Box));
+        }
+    }
+
+    void generateInbetweens_data() { addSizeRows(); }
+    void generateInbetweens() {
+        QFETCH(int, size);
+        Frame first(size, size);
+        Frame second(size, size);
+        fillRandom(first, 1);
+        fillRandom(second, 2);
+
+        // A typical request: a handful of cross-faded frames between two keys
+        QBENCHMARK {
+            vector<Frame> inbetweens = InbetweenGenerator::generate(first, second, 8, InbetweenGenerator::CrossFade);
+            QCOMPARE(static_cast<int>(inbetweens.size()), 8);
+        }
+    }
+
+    void playbackTimeline_data() {
+        QTest::addColumn<int>("frameCount");
+
+        for (int frameCount : {500, 10000}) {
+            QTest::newRow(qPrintable(QString("%1frames").arg(frameCount))) << frameCount;
+        }
+    }
+
+    void playbackTimeline() {
+        QFETCH(int, frameCount);
+        vector<int> durations(frameCount);
+
+        for (int i = 0; i < frameCount; ++i) {
+            durations[i] = (i % 3 == 0) ? 0 : 40 + i % 7;
+        }
+
+        PlaybackTimeline timeline(durations, 83);
+
+        // Scrubbing: a thousand seeks spread over an hour of looped playback
+        QBENCHMARK {
+            int checksum = 0;
+
+            for (qint64 time = 0; time < 3600000; time += 3600) {
+                checksum += timeline.frameAtLooped(time);
+            }
+            QVERIFY(checksum >= 0);
+        }
+    }
+
+    void saveBinary_data() { addProjectRows(); }
+    void saveBinary() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+
+        if (qint64(size) * size * frameCount > maxBinaryProjectPixels) {
+            QSKIP("Project too large for the binary benchmark");
+        }
+
+        QTemporaryDir directory;
+        FrameManager manager(size, size);
+        fillProject(manager, frameCount);
+        SaveLoadManager saveLoadManager;
+
+        QBENCHMARK {
+            QVERIFY(saveLoadManager.saveToBinaryFile(manager, directory.filePath("project.ssp")));
+        }
+    }
+
+    void loadBinary_data() { addProjectRows(); }
+    void loadBinary() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+
+        if (qint64(size) * size * frameCount > maxBinaryProjectPixels) {
+            QSKIP("Project too large for the binary benchmark");
+        }
+
+        QTemporaryDir directory;
+        FrameManager manager(size, size);
+        fillProject(manager, frameCount);
+        SaveLoadManager saveLoadManager;
+        QVERIFY(saveLoadManager.saveToBinaryFile(manager, directory.filePath("project.ssp")));
+
+        QBENCHMARK {
+            QVERIFY(saveLoadManager.loadFromFile(manager, directory.filePath("project.ssp")));
+        }
+    }
+
+    void loadBinaryAllocations_data() { addProjectRows(); }
+    void loadBinaryAllocations() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+
+        if (qint64(size) * size * frameCount > maxBinaryProjectPixels) {
+            QSKIP("Project too large for the binary benchmark");
+        }
+
+        QTemporaryDir directory;
+        FrameManager manager(size, size);
+        fillProject(manager, frameCount);
+        SaveLoadManager saveLoadManager;
+        QVERIFY(saveLoadManager.saveToBinaryFile(manager, directory.filePath("project.ssp")));
+
+        // Loading over a project should refill the buffers the replaced frames gave back
+        bool loaded = true;
+        reportAllocations([&]() {
+            loaded = saveLoadManager.loadFromFile(manager, directory.filePath("project.ssp")) && loaded;
+        });
+        QVERIFY(loaded);
+    }
+
+    void saveJson_data() { addProjectRows(); }
+    void saveJson() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+
+        if (qint64(size) * size * frameCount > maxJsonProjectPixels) {
+            QSKIP("Project too large for the JSON benchmark");
+        }
+
+        QTemporaryDir directory;
+        FrameManager manager(size, size);
+        fillProject(manager, frameCount);
+        SaveLoadManager saveLoadManager;
+
+        QBENCHMARK {
+            QVERIFY(saveLoadManager.saveToFile(manager, directory.filePath("project.ssp")));
+        }
+    }
+
+    void loadJson_data() { addProjectRows(); }
+    void loadJson() {
+        QFETCH(int, size);
+        QFETCH(int, frameCount);
+
+        if (qint64(size) * size * frameCount > maxJsonProjectPixels) {
+            QSKIP("Project too large for the JSON benchmark");
+        }
+
+        QTemporaryDir directory;
+        FrameManager manager(size, size);
+        fillProject(manager, frameCount);
+        SaveLoadManager saveLoadManager;
+        QVERIFY(saveLoadManager.saveToFile(manager, directory.filePath("project.ssp")));
+
+        QBENCHMARK {
+            QVERIFY(saveLoadManager.loadFromFile(manager, directory.filePath("project.ssp")));
+        }
+    }
+
+};
+
+QTEST_GUILESS_MAIN(SpriteBenchmarks)
+
+#include "spritebenchmarks.moc"
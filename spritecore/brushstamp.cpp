@@ -0,0 +1,172 @@
+/**
+ * @file brushstamp.cpp
+ * @brief Implementation of the BrushStamp class.
+ * @date 03/31/2025
+ */
+
+#include "brushstamp.h"
+
+#include <QtDebug>
+
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+BrushStamp::BrushStamp() : BrushStamp(Square, 1) {}
+
+BrushStamp::BrushStamp(Shape shape, int size) :
+    brushShape(shape),
+    brushSize(qBound(minimumSize, size, maximumSize))
+{
+    // Even sizes reach one pixel further right and down than left and up
+    int offset = (brushSize - 1) / 2;
+
+    for (int row = 0; row < brushSize; ++row) {
+        int left = 0, right = brushSize - 1;
+
+        // A round brush keeps the cells whose centers lie inside the circle, in doubled integer
+        // coordinates so no fractions are needed: (2i - (d - 1))^2 + (2j - (d - 1))^2 <= d^2
+        if (brushShape == Round) {
+            int dy = 2 * row - (brushSize - 1);
+            left = brushSize;
+
+            for (int column = 0; column < brushSize; ++column) {
+                int dx = 2 * column - (brushSize - 1);
+
+                if (dx * dx + dy * dy <= brushSize * brushSize) {
+                    left = min(left, column);
+                    right = column;
+                }
+            }
+
+            if (left > right) {
+                continue;
+            }
+        }
+
+        maskSpans.push_back({row - offset, left - offset, right - offset});
+    }
+}
+
+BrushStamp::Shape BrushStamp::shape() const {
+    return brushShape;
+}
+
+int BrushStamp::size() const {
+    return brushSize;
+}
+
+const vector<PixelSpan>& BrushStamp::spans() const {
+    return maskSpans;
+}
+
+/**
+ * @brief Fills the mask's spans at a position, mirrored as requested, and grows the changed bounds.
+ */
+static void stampSpans(QImage& image, const vector<PixelSpan>& spans, QPoint center, QRgb color, PixelBlend::Mode mode,
+                       quint8* covered, bool mirrorX, bool mirrorY, QRect& changed) {
+    const int width = image.width();
+    const int height = image.height();
+
+    for (const PixelSpan& span : spans) {
+        int y = center.y() + span.y;
+        int left = center.x() + span.left;
+        int right = center.x() + span.right;
+
+        // Mirror the span itself, not just the center, so even-sized brushes stay exactly symmetric
+        if (mirrorX) {
+            int mirroredLeft = width - 1 - right;
+            right = width - 1 - left;
+            left = mirroredLeft;
+        }
+
+        if (mirrorY) {
+            y = height - 1 - y;
+        }
+
+        if (y < 0 || y >= height) {
+            continue;
+        }
+
+        left = max(left, 0);
+        right = min(right, width - 1);
+
+        if (left > right) {
+            continue;
+        }
+
+        QRgb* row = reinterpret_cast<QRgb*>(image.scanLine(y));
+        changed |= QRect(left, y, right - left + 1, 1);
+
+        if (mode == PixelBlend::Replace || !covered) {
+            PixelBlend::blendSpan(row + left, right - left + 1, color, mode);
+            continue;
+        }
+
+        // Blend only the runs this stroke has not painted yet
+        quint8* rowCovered = covered + static_cast<size_t>(y) * width;
+
+        for (int x = left; x <= right;) {
+            if (rowCovered[x]) {
+                x++;
+                continue;
+            }
+
+            int runStart = x;
+
+            while (x <= right && !rowCovered[x]) {
+                rowCovered[x++] = 1;
+            }
+            PixelBlend::blendSpan(row + runStart, x - runStart, color, mode);
+        }
+    }
+}
+
+QRegion BrushStamp::stamp(QImage& image, QPoint center, QRgb color, Symmetry symmetry,
+                          PixelBlend::Mode mode, vector<quint8>* covered) const {
+    return stroke(image, center, center, color, symmetry, mode, covered);
+}
+
+QRegion BrushStamp::stroke(QImage& image, QPoint from, QPoint to, QRgb color, Symmetry symmetry,
+                           PixelBlend::Mode mode, vector<quint8>* covered) const {
+    if (image.format() != QImage::Format_ARGB32) {
+        qWarning() << "BrushStamp::stroke: expected an ARGB32 image";
+        return QRegion();
+    }
+
+    if (covered && covered->size() != static_cast<size_t>(image.width()) * image.height()) {
+        qWarning() << "BrushStamp::stroke: covered flags do not match the image size";
+        covered = nullptr;
+    }
+    quint8* coveredPixels = covered ? covered->data() : nullptr;
+
+    // One bounding rectangle per mirrored copy keeps the commit small when the copies are far apart
+    QRect changed[4];
+    vector<PixelSpan> path = ShapeRasterizer::line(from, to);
+
+    for (const PixelSpan& pathSpan : path) {
+        for (int x = pathSpan.left; x <= pathSpan.right; ++x) {
+            QPoint center(x, pathSpan.y);
+
+            for (int copy = 0; copy < 4; ++copy) {
+                bool mirrorX = copy & Horizontal;
+                bool mirrorY = copy & Vertical;
+
+                if ((copy & symmetry) != copy) {
+                    continue;
+                }
+                stampSpans(image, maskSpans, center, color, mode, coveredPixels, mirrorX, mirrorY, changed[copy]);
+            }
+        }
+    }
+
+    QRegion region;
+
+    for (const QRect& rect : changed) {
+        if (!rect.isEmpty()) {
+            region += rect;
+        }
+    }
+    return region;
+}
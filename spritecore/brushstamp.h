@@ -0,0 +1,145 @@
+#ifndef BRUSHSTAMP_H
+#define BRUSHSTAMP_H
+
+/**
+ * @file brushstamp.h
+ * @brief Declares the BrushStamp class, a precomputed brush mask stamped as clipped row spans.
+ *
+ * The brush shape is rasterized once into spans relative to its center when the brush changes. Each
+ * stamp then only offsets and clips those spans, so a 64 px brush costs 64 row fills, and mirrored
+ * copies for symmetric painting cost the same again per axis.
+ *
+ * @date 03/31/2025
+ */
+
+#include "pixelblend.h"
+#include "shaperasterizer.h"
+
+#include <QImage>
+#include <QPoint>
+#include <QRegion>
+
+#include <vector>
+
+using std::vector;
+
+/**
+ * @class BrushStamp
+ *
+ * @brief A square or round brush from 1 to 64 pixels across.
+ */
+class BrushStamp {
+
+public:
+
+    /**
+     * @brief The shape of the brush tip.
+     */
+    enum Shape {
+        Square,
+        Round
+    };
+
+    /**
+     * @brief Axes a stroke is mirrored across, combinable as flags.
+     */
+    enum Symmetry {
+        NoSymmetry = 0,
+        Horizontal = 1, ///< Mirror left and right, across the vertical center line.
+        Vertical = 2,   ///< Mirror top and bottom, across the horizontal center line.
+        BothAxes = Horizontal | Vertical
+    };
+
+    /**
+     * @brief Smallest brush size.
+     */
+    static constexpr int minimumSize = 1;
+
+    /**
+     * @brief Largest brush size.
+     */
+    static constexpr int maximumSize = 64;
+
+    /**
+     * @brief Creates a one pixel brush.
+     */
+    BrushStamp();
+
+    /**
+     * @brief Precomputes the mask for a brush.
+     * @param shape The brush shape.
+     * @param size The brush width and height in pixels, clamped to 1–64.
+     */
+    BrushStamp(Shape shape, int size);
+
+    /**
+     * @brief Returns the brush shape.
+     * @return The shape.
+     */
+    Shape shape() const;
+
+    /**
+     * @brief Returns the brush size.
+     * @return Width and height in pixels.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the mask's spans, relative to the brush center.
+     * @return One or more spans per row of the brush.
+     */
+    const vector<PixelSpan>& spans() const;
+
+    /**
+     * @brief Paints the brush once at a position, plus its mirrored copies.
+     * @param image The ARGB32 image to paint.
+     * @param center Where the brush is centered, in image coordinates.
+     * @param color The color to write.
+     * @param symmetry The axes to mirror across.
+     * @param mode How the color combines with the pixels underneath.
+     * @param covered Optional per-pixel flags, see stroke().
+     * @return The changed area, as one rectangle per mirrored copy.
+     */
+    QRegion stamp(QImage& image, QPoint center, QRgb color, Symmetry symmetry,
+                  PixelBlend::Mode mode = PixelBlend::Replace, vector<quint8>* covered = nullptr) const;
+
+    /**
+     * @brief Paints the brush at every pixel of a line, plus its mirrored copies.
+     *
+     * Used for a mouse move, so fast strokes leave no gaps between events.
+     *
+     * Blended paint builds up wherever stamps overlap. Passing the same covered flags, one byte per
+     * image pixel and cleared when the stroke starts, blends each pixel once per stroke instead.
+     *
+     * @param image The ARGB32 image to paint.
+     * @param from Where the stroke segment starts.
+     * @param to Where the stroke segment ends.
+     * @param color The color to write.
+     * @param symmetry The axes to mirror across.
+     * @param mode How the color combines with the pixels underneath.
+     * @param covered Optional flags of the pixels this stroke already painted, width * height bytes.
+     * @return The changed area, as one rectangle per mirrored copy.
+     */
+    QRegion stroke(QImage& image, QPoint from, QPoint to, QRgb color, Symmetry symmetry,
+                   PixelBlend::Mode mode = PixelBlend::Replace, vector<quint8>* covered = nullptr) const;
+
+private:
+
+    /**
+     * @brief The brush shape.
+     */
+    Shape brushShape;
+
+    /**
+     * @brief The brush width and height in pixels.
+     */
+    int brushSize;
+
+    /**
+     * @brief The mask, as spans relative to the brush center.
+     */
+    vector<PixelSpan> maskSpans;
+
+};
+
+#endif // BRUSHSTAMP_H
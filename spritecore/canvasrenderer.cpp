@@ -0,0 +1,182 @@
+/**
+ * @file canvasrenderer.cpp
+ * @brief Implementation of the CanvasRenderer class used by the editor and preview canvases.
+ * @date 03/31/2025
+ */
+
+#include "canvasrenderer.h"
+#include "spritemipmaps.h"
+
+#include <QColor>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using std::max;
+using std::min;
+using std::vector;
+
+/**
+ * @brief Divides a product of two 8-bit channels by 255, rounded.
+ */
+static inline int divide255(int value) {
+    return (value + (value >> 8) + 0x80) >> 8;
+}
+
+int CanvasRenderer::pixelSize(QSize canvasSize, int spriteWidth, int spriteHeight) {
+    int pixelWidth = canvasSize.width() / max(1, spriteWidth);
+    int pixelHeight = canvasSize.height() / max(1, spriteHeight);
+    return max(1, min(pixelWidth, pixelHeight));
+}
+
+QRect CanvasRenderer::spriteArea(QSize canvasSize, int spriteWidth, int spriteHeight) {
+    int size = pixelSize(canvasSize, spriteWidth, spriteHeight);
+
+    // Calculate the total size of the scaled sprite
+    int totalWidth = size * spriteWidth;
+    int totalHeight = size * spriteHeight;
+
+    // Center the drawing on the canvas
+    int offsetX = (canvasSize.width() - totalWidth) / 2;
+    int offsetY = (canvasSize.height() - totalHeight) / 2;
+    return QRect(offsetX, offsetY, totalWidth, totalHeight);
+}
+
+QPoint CanvasRenderer::cellAt(QPoint position, QSize canvasSize, int spriteWidth, int spriteHeight) {
+    int size = pixelSize(canvasSize, spriteWidth, spriteHeight);
+    QRect area = spriteArea(canvasSize, spriteWidth, spriteHeight);
+
+    // Round toward negative infinity so positions just left of or above the sprite map outside it
+    auto floorDivide = [size](int value) {
+        return (value >= 0) ? value / size : -((-value + size - 1) / size);
+    };
+    return QPoint(floorDivide(position.x() - area.x()), floorDivide(position.y() - area.y()));
+}
+
+QRect CanvasRenderer::cellRect(QRect cells, QSize canvasSize, int spriteWidth, int spriteHeight) {
+    if (cells.isEmpty()) {
+        return QRect();
+    }
+
+    int size = pixelSize(canvasSize, spriteWidth, spriteHeight);
+    QRect area = spriteArea(canvasSize, spriteWidth, spriteHeight);
+    return QRect(area.x() + cells.x() * size, area.y() + cells.y() * size, cells.width() * size, cells.height() * size);
+}
+
+QImage CanvasRenderer::render(const QImage& sprite, QSize canvasSize, bool drawGrid) {
+    return render(sprite, canvasSize, CanvasView::fit(canvasSize, sprite.size()), drawGrid);
+}
+
+QImage CanvasRenderer::render(const QImage& sprite, QSize canvasSize, const CanvasView& view, bool drawGrid,
+                              const SpriteMipmaps* mipmaps) {
+    QImage canvas(canvasSize, QImage::Format_ARGB32_Premultiplied);
+    render(canvas, sprite, view, drawGrid, mipmaps, canvas.rect());
+    return canvas;
+}
+
+void CanvasRenderer::render(QImage& canvas, const QImage& sprite, const CanvasView& view, bool drawGrid,
+                            const SpriteMipmaps* mipmaps, const QRect& clip) {
+    const QRect bounds = clip & canvas.rect();
+
+    if (bounds.isEmpty()) {
+        return;
+    }
+
+    // Set background color to dark gray
+    const QRgb background = qPremultiply(qRgba(100, 100, 100, 50));
+
+    for (int y = bounds.top(); y <= bounds.bottom(); ++y) {
+        QRgb* row = reinterpret_cast<QRgb*>(canvas.scanLine(y));
+        std::fill(row + bounds.left(), row + bounds.right() + 1, background);
+    }
+
+    // Only the cells under the clip rectangle are drawn
+    const QRect clipCells(view.cellAt(bounds.topLeft()), view.cellAt(bounds.bottomRight()));
+    const QRect visible = view.visibleCells(canvas.size(), sprite.size());
+    const QRect cells = visible & clipCells;
+    const QRect area = view.cellRect(cells) & bounds;
+
+    if (visible.isEmpty() || sprite.format() != QImage::Format_ARGB32) {
+        return;
+    }
+
+    // Zoomed out, read the mipmap level whose pixels are closest to one screen pixel
+    const QImage* source = &sprite;
+    bool premultiplied = false;
+    int level = 0;
+
+    if (view.scale() < 1.0 && mipmaps && mipmaps->spriteSize() == sprite.size()) {
+        level = min(mipmaps->levelCount(), static_cast<int>(std::floor(std::log2(1.0 / view.scale()))));
+
+        if (level > 0) {
+            source = &mipmaps->level(level);
+            premultiplied = true;
+        }
+    }
+
+    // Source column of every canvas column in the area
+    vector<int> columns(area.width());
+
+    for (int x = 0; x < area.width(); ++x) {
+        columns[x] = view.cellAt(QPoint(area.left() + x, 0)).x() >> level;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(area.width()) * sizeof(QRgb);
+    int previousRow = -1;
+
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        QRgb* target = reinterpret_cast<QRgb*>(canvas.scanLine(y)) + area.left();
+        int sourceRow = view.cellAt(QPoint(0, y)).y() >> level;
+
+        // Zoomed in, consecutive canvas rows show the same sprite row
+        if (sourceRow == previousRow) {
+            std::memcpy(target, reinterpret_cast<const QRgb*>(canvas.constScanLine(y - 1)) + area.left(), rowBytes);
+            continue;
+        }
+
+        const QRgb* row = reinterpret_cast<const QRgb*>(source->constScanLine(sourceRow));
+
+        for (int x = 0; x < area.width(); ++x) {
+            QRgb color = premultiplied ? row[columns[x]] : qPremultiply(row[columns[x]]);
+            int inverse = 255 - qAlpha(color);
+
+            // Premultiplied source-over the background
+            target[x] = (inverse == 0) ? color
+                                       : qRgba(qRed(color) + divide255(qRed(background) * inverse),
+                                               qGreen(color) + divide255(qGreen(background) * inverse),
+                                               qBlue(color) + divide255(qBlue(background) * inverse),
+                                               qAlpha(color) + divide255(qAlpha(background) * inverse));
+        }
+        previousRow = sourceRow;
+    }
+
+    if (drawGrid && view.scale() >= 4.0) {
+        const QRgb gridColor = QColor(Qt::gray).rgba();
+
+        // Grid lines sit on the first canvas pixel of every cell, plus one past the last cell
+        QRect lines = view.cellRect(visible).adjusted(0, 0, 1, 1) & bounds;
+
+        for (int cell = max(visible.left(), clipCells.left()); cell <= min(visible.right() + 1, clipCells.right()); ++cell) {
+            int x = view.cellRect(QRect(cell, 0, 1, 1)).left();
+
+            if (x < lines.left() || x > lines.right()) {
+                continue;
+            }
+
+            for (int y = lines.top(); y <= lines.bottom(); ++y) {
+                reinterpret_cast<QRgb*>(canvas.scanLine(y))[x] = gridColor;
+            }
+        }
+
+        for (int cell = max(visible.top(), clipCells.top()); cell <= min(visible.bottom() + 1, clipCells.bottom()); ++cell) {
+            int y = view.cellRect(QRect(0, cell, 1, 1)).top();
+
+            if (y >= lines.top() && y <= lines.bottom()) {
+                QRgb* row = reinterpret_cast<QRgb*>(canvas.scanLine(y));
+                std::fill(row + lines.left(), row + lines.right() + 1, gridColor);
+            }
+        }
+    }
+}
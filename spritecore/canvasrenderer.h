@@ -0,0 +1,122 @@
+#ifndef CANVASRENDERER_H
+#define CANVASRENDERER_H
+
+/**
+ * @file canvasrenderer.h
+ * @brief Declares the CanvasRenderer class, which draws a sprite scaled up into a fixed-size canvas.
+ *
+ * The editor and the preview window both show the sprite as a grid of enlarged cells centered in a
+ * label. CanvasRenderer holds that layout math and the drawing so both windows, and the benchmarks,
+ * share one implementation.
+ *
+ * @date 03/31/2025
+ */
+
+#include "canvasview.h"
+
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+
+class SpriteMipmaps;
+
+/**
+ * @class CanvasRenderer
+ *
+ * @brief Lays out and draws a sprite as a centered grid of square cells.
+ */
+class CanvasRenderer {
+
+public:
+
+    /**
+     * @brief Computes the on-screen size of one sprite pixel.
+     * @param canvasSize Size of the display area.
+     * @param spriteWidth Width of the sprite in pixels.
+     * @param spriteHeight Height of the sprite in pixels.
+     * @return The largest whole cell size that fits, at least 1.
+     */
+    static int pixelSize(QSize canvasSize, int spriteWidth, int spriteHeight);
+
+    /**
+     * @brief Computes where the scaled sprite sits inside the display area.
+     * @param canvasSize Size of the display area.
+     * @param spriteWidth Width of the sprite in pixels.
+     * @param spriteHeight Height of the sprite in pixels.
+     * @return The rectangle covered by the sprite, centered in the canvas.
+     */
+    static QRect spriteArea(QSize canvasSize, int spriteWidth, int spriteHeight);
+
+    /**
+     * @brief Converts a position in the display area to sprite coordinates.
+     *
+     * The result may be outside the sprite; callers check the bounds.
+     *
+     * @param position Position in canvas coordinates.
+     * @param canvasSize Size of the display area.
+     * @param spriteWidth Width of the sprite in pixels.
+     * @param spriteHeight Height of the sprite in pixels.
+     * @return The (x, y) cell under the position.
+     */
+    static QPoint cellAt(QPoint position, QSize canvasSize, int spriteWidth, int spriteHeight);
+
+    /**
+     * @brief Converts a rectangle of sprite cells to the area they cover in the display.
+     * @param cells Rectangle in sprite coordinates.
+     * @param canvasSize Size of the display area.
+     * @param spriteWidth Width of the sprite in pixels.
+     * @param spriteHeight Height of the sprite in pixels.
+     * @return The rectangle in canvas coordinates, or an empty rectangle for no cells.
+     */
+    static QRect cellRect(QRect cells, QSize canvasSize, int spriteWidth, int spriteHeight);
+
+    /**
+     * @brief Draws the sprite into a new canvas image, fitted and centered.
+     *
+     * The canvas is filled with the editor's dark gray background, then each sprite pixel is painted
+     * as a cell, optionally outlined with a gray grid.
+     *
+     * @param sprite The sprite image to draw.
+     * @param canvasSize Size of the canvas to produce.
+     * @param drawGrid Whether to outline every cell.
+     * @return The rendered canvas.
+     */
+    static QImage render(const QImage& sprite, QSize canvasSize, bool drawGrid);
+
+    /**
+     * @brief Draws the sprite into a new canvas image through a zoomed and panned view.
+     *
+     * Only the canvas pixels covered by visible cells are computed, each sampled once, so the cost
+     * follows the canvas size rather than the sprite size. Below scale 1 the pixels come from the
+     * mipmap level nearest one sprite pixel per screen pixel. The grid is only drawn from scale 4 up,
+     * where the cells are still visible around it.
+     *
+     * @param sprite The ARGB32 sprite image to draw.
+     * @param canvasSize Size of the canvas to produce.
+     * @param view The zoom and pan to draw with.
+     * @param drawGrid Whether to outline every cell.
+     * @param mipmaps Downsampled levels of the sprite, or nullptr to sample the sprite directly.
+     * @return The rendered canvas.
+     */
+    static QImage render(const QImage& sprite, QSize canvasSize, const CanvasView& view, bool drawGrid,
+                         const SpriteMipmaps* mipmaps = nullptr);
+
+    /**
+     * @brief Redraws part of an existing canvas image through a zoomed and panned view.
+     *
+     * Pixels outside the clip rectangle are left untouched, so an edit only costs the cells it changed.
+     *
+     * @param canvas The ARGB32_Premultiplied canvas to draw into.
+     * @param sprite The ARGB32 sprite image to draw.
+     * @param view The zoom and pan to draw with.
+     * @param drawGrid Whether to outline every cell.
+     * @param mipmaps Downsampled levels of the sprite, or nullptr to sample the sprite directly.
+     * @param clip The canvas pixels to redraw.
+     */
+    static void render(QImage& canvas, const QImage& sprite, const CanvasView& view, bool drawGrid,
+                       const SpriteMipmaps* mipmaps, const QRect& clip);
+
+};
+
+#endif // CANVASRENDERER_H
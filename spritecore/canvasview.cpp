@@ -0,0 +1,102 @@
+/**
+ * @file canvasview.cpp
+ * @brief Implementation of the CanvasView class.
+ * @date 03/31/2025
+ */
+
+#include "canvasview.h"
+#include "canvasrenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief The scales zooming steps through, smallest first.
+ */
+static const double zoomLevels[] = {
+    1.0 / 64, 1.0 / 32, 1.0 / 16, 1.0 / 8, 1.0 / 4, 1.0 / 2,
+    1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64
+};
+
+CanvasView::CanvasView(double scale, QPoint origin) : viewScale(scale), viewOrigin(origin) {}
+
+CanvasView CanvasView::fit(QSize canvasSize, QSize spriteSize) {
+    QRect area = CanvasRenderer::spriteArea(canvasSize, spriteSize.width(), spriteSize.height());
+    return CanvasView(CanvasRenderer::pixelSize(canvasSize, spriteSize.width(), spriteSize.height()), area.topLeft());
+}
+
+double CanvasView::scale() const {
+    return viewScale;
+}
+
+QPoint CanvasView::origin() const {
+    return viewOrigin;
+}
+
+QPoint CanvasView::cellAt(QPoint position) const {
+    return QPoint(static_cast<int>(std::floor((position.x() - viewOrigin.x()) / viewScale)),
+                  static_cast<int>(std::floor((position.y() - viewOrigin.y()) / viewScale)));
+}
+
+QRect CanvasView::cellRect(QRect cells) const {
+    if (cells.isEmpty()) {
+        return QRect();
+    }
+
+    // The first canvas pixel of a cell is the first one whose left edge is inside it
+    auto edge = [this](int cell, int origin) {
+        return origin + static_cast<int>(std::ceil(cell * viewScale));
+    };
+
+    QPoint topLeft(edge(cells.left(), viewOrigin.x()), edge(cells.top(), viewOrigin.y()));
+    QPoint bottomRight(edge(cells.right() + 1, viewOrigin.x()) - 1, edge(cells.bottom() + 1, viewOrigin.y()) - 1);
+    return QRect(topLeft, bottomRight);
+}
+
+QRect CanvasView::visibleCells(QSize canvasSize, QSize spriteSize) const {
+    if (canvasSize.isEmpty()) {
+        return QRect();
+    }
+
+    QRect cells(cellAt(QPoint(0, 0)), cellAt(QPoint(canvasSize.width() - 1, canvasSize.height() - 1)));
+    return cells & QRect(QPoint(0, 0), spriteSize);
+}
+
+CanvasView CanvasView::zoomedAt(QPoint anchor, int steps) const {
+    if (steps == 0) {
+        return *this;
+    }
+
+    const int levelCount = static_cast<int>(sizeof(zoomLevels) / sizeof(zoomLevels[0]));
+
+    // A fitted view may sit between two levels; the first step goes to the neighbouring one
+    int level = static_cast<int>(std::lower_bound(zoomLevels, zoomLevels + levelCount, viewScale) - zoomLevels);
+
+    if (steps < 0 || (level < levelCount && zoomLevels[level] == viewScale)) {
+        level += steps;
+    }
+
+    else {
+        level += steps - 1;
+    }
+
+    double newScale = zoomLevels[std::clamp(level, 0, levelCount - 1)];
+
+    // Keep the point under the anchor where it is
+    double factor = newScale / viewScale;
+    QPoint origin(anchor.x() - static_cast<int>(std::lround((anchor.x() - viewOrigin.x()) * factor)),
+                  anchor.y() - static_cast<int>(std::lround((anchor.y() - viewOrigin.y()) * factor)));
+    return CanvasView(newScale, origin);
+}
+
+CanvasView CanvasView::pannedBy(QPoint delta) const {
+    return CanvasView(viewScale, viewOrigin + delta);
+}
+
+bool CanvasView::operator==(const CanvasView& other) const {
+    return viewScale == other.viewScale && viewOrigin == other.viewOrigin;
+}
+
+bool CanvasView::operator!=(const CanvasView& other) const {
+    return !(*this == other);
+}
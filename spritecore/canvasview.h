@@ -0,0 +1,130 @@
+#ifndef CANVASVIEW_H
+#define CANVASVIEW_H
+
+/**
+ * @file canvasview.h
+ * @brief Declares the CanvasView class, the zoom and pan that place a sprite on a canvas.
+ * @date 03/31/2025
+ */
+
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+
+/**
+ * @class CanvasView
+ *
+ * @brief Maps sprite cells to canvas pixels for a given zoom and pan.
+ *
+ * Cell (x, y) covers the canvas pixels from origin + (x, y) * scale up to, but not including,
+ * origin + (x + 1, y + 1) * scale. Zooming in steps between whole-pixel scales, and zooming out
+ * between powers of two, so cells stay crisp and zoomed-out levels line up with mipmap levels.
+ */
+class CanvasView {
+
+public:
+
+    /**
+     * @brief Constructs a view at scale 1 with the sprite in the top-left corner.
+     */
+    CanvasView() = default;
+
+    /**
+     * @brief Constructs a view with the given zoom and pan.
+     * @param scale Canvas pixels per sprite pixel.
+     * @param origin Canvas position of the sprite's top-left corner.
+     */
+    CanvasView(double scale, QPoint origin);
+
+    /**
+     * @brief Returns the view that fits a sprite into a canvas the way the editor always has.
+     *
+     * The scale is the largest whole number that fits, at least 1, and the sprite is centered.
+     *
+     * @param canvasSize Size of the display area.
+     * @param spriteSize Size of the sprite.
+     * @return The fitted view.
+     */
+    static CanvasView fit(QSize canvasSize, QSize spriteSize);
+
+    /**
+     * @brief Returns the number of canvas pixels per sprite pixel.
+     * @return The zoom factor.
+     */
+    double scale() const;
+
+    /**
+     * @brief Returns the canvas position of the sprite's top-left corner.
+     * @return The pan offset.
+     */
+    QPoint origin() const;
+
+    /**
+     * @brief Converts a canvas position to the sprite cell under it.
+     *
+     * The result may be outside the sprite; callers check the bounds.
+     *
+     * @param position Position in canvas coordinates.
+     * @return The (x, y) cell.
+     */
+    QPoint cellAt(QPoint position) const;
+
+    /**
+     * @brief Converts a rectangle of sprite cells to the canvas pixels they cover.
+     * @param cells Rectangle in sprite coordinates.
+     * @return The rectangle in canvas coordinates, or an empty rectangle for no cells.
+     */
+    QRect cellRect(QRect cells) const;
+
+    /**
+     * @brief Finds the sprite cells that are at least partly visible.
+     * @param canvasSize Size of the display area.
+     * @param spriteSize Size of the sprite.
+     * @return The visible cells, or an empty rectangle if the sprite is out of view.
+     */
+    QRect visibleCells(QSize canvasSize, QSize spriteSize) const;
+
+    /**
+     * @brief Returns this view zoomed in or out by whole steps, keeping the cell under the anchor in place.
+     * @param anchor Canvas position that stays fixed, usually the mouse position.
+     * @param steps Positive to zoom in, negative to zoom out.
+     * @return The zoomed view.
+     */
+    CanvasView zoomedAt(QPoint anchor, int steps) const;
+
+    /**
+     * @brief Returns this view moved across the canvas.
+     * @param delta Distance to move the sprite, in canvas pixels.
+     * @return The panned view.
+     */
+    CanvasView pannedBy(QPoint delta) const;
+
+    /**
+     * @brief Compares two views.
+     * @param other The view to compare with.
+     * @return true if both have the same scale and origin.
+     */
+    bool operator==(const CanvasView& other) const;
+
+    /**
+     * @brief Compares two views.
+     * @param other The view to compare with.
+     * @return true if the scale or origin differ.
+     */
+    bool operator!=(const CanvasView& other) const;
+
+private:
+
+    /**
+     * @brief Canvas pixels per sprite pixel.
+     */
+    double viewScale = 1.0;
+
+    /**
+     * @brief Canvas position of the sprite's top-left corner.
+     */
+    QPoint viewOrigin;
+
+};
+
+#endif // CANVASVIEW_H
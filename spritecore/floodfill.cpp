@@ -0,0 +1,213 @@
+/**
+ * @file floodfill.cpp
+ * @brief Implementation of the FloodFill class.
+ *
+ * Both fills are templates over the color test, so the common zero-tolerance case compiles down to a
+ * plain comparison in the inner loops. Matching runs are painted whole with PixelBlend::blendSpan().
+ *
+ * @date 03/31/2025
+ */
+
+#include "floodfill.h"
+
+#include <QtDebug>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <vector>
+
+using std::vector;
+
+/**
+ * @brief Bounding box of the pixels changed by a fill, grown one span at a time.
+ */
+struct ChangedBounds {
+    int left = INT_MAX;
+    int top = INT_MAX;
+    int right = -1;
+    int bottom = -1;
+
+    void add(int spanLeft, int spanRight, int y) {
+        left = qMin(left, spanLeft);
+        right = qMax(right, spanRight);
+        top = qMin(top, y);
+        bottom = qMax(bottom, y);
+    }
+
+    QRect rect() const {
+        return (right < 0) ? QRect() : QRect(QPoint(left, top), QPoint(right, bottom));
+    }
+};
+
+/**
+ * @brief Paints every matching pixel in the image, one run of matches at a time.
+ */
+template <typename Matches>
+static QRect fillGlobal(QImage& image, QRgb replacement, PixelBlend::Mode blend, Matches matches) {
+    const int width = image.width();
+    ChangedBounds bounds;
+
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb* row = reinterpret_cast<QRgb*>(image.scanLine(y));
+
+        for (int x = 0; x < width;) {
+            if (!matches(row[x])) {
+                x++;
+                continue;
+            }
+
+            int runStart = x;
+
+            while (x < width && matches(row[x])) {
+                x++;
+            }
+            PixelBlend::blendSpan(row + runStart, x - runStart, replacement, blend);
+            bounds.add(runStart, x - 1, y);
+        }
+    }
+    return bounds.rect();
+}
+
+/**
+ * @brief Span-based scanline fill of the region connected to the seed.
+ *
+ * @param trackVisits Whether filled pixels must be remembered because the replacement still matches.
+ */
+template <typename Matches>
+static QRect fillContiguous(QImage& image, QPoint seed, QRgb replacement, PixelBlend::Mode blend, Matches matches,
+                            bool trackVisits) {
+    const int width = image.width();
+    const int height = image.height();
+    ChangedBounds bounds;
+
+    vector<quint8> visited;
+
+    if (trackVisits) {
+        visited.assign(static_cast<size_t>(width) * height, 0);
+    }
+
+    auto isOpen = [&](const QRgb* row, int x, int y) {
+        if (trackVisits && visited[static_cast<size_t>(y) * width + x]) {
+            return false;
+        }
+        return matches(row[x]);
+    };
+
+    // Each seed remembers the span it was found from, whose row needs no second scan there
+    struct Seed {
+        int x;
+        int y;
+        int parentRow;
+        int parentLeft;
+        int parentRight;
+    };
+
+    vector<Seed> stack;
+    stack.push_back({seed.x(), seed.y(), -1, 1, 0});
+
+    while (!stack.empty()) {
+        Seed current = stack.back();
+        stack.pop_back();
+
+        const int y = current.y;
+        QRgb* row = reinterpret_cast<QRgb*>(image.scanLine(y));
+
+        if (!isOpen(row, current.x, y)) {
+            continue;
+        }
+
+        // Grow the span as far as it matches in both directions
+        int spanLeft = current.x;
+        int spanRight = current.x;
+
+        while (spanLeft > 0 && isOpen(row, spanLeft - 1, y)) {
+            spanLeft--;
+        }
+
+        while (spanRight < width - 1 && isOpen(row, spanRight + 1, y)) {
+            spanRight++;
+        }
+
+        PixelBlend::blendSpan(row + spanLeft, spanRight - spanLeft + 1, replacement, blend);
+
+        if (trackVisits) {
+            std::fill_n(visited.begin() + static_cast<size_t>(y) * width + spanLeft, spanRight - spanLeft + 1, 1);
+        }
+
+        bounds.add(spanLeft, spanRight, y);
+
+        // Push one seed for each matching run in the rows above and below the span
+        for (int neighbour : {y - 1, y + 1}) {
+            if (neighbour < 0 || neighbour >= height) {
+                continue;
+            }
+
+            const QRgb* neighbourRow = reinterpret_cast<const QRgb*>(image.constScanLine(neighbour));
+            bool isParent = (neighbour == current.parentRow);
+            bool inRun = false;
+
+            for (int x = spanLeft; x <= spanRight; ++x) {
+
+                // The parent span is already filled
+                if (isParent && x >= current.parentLeft && x <= current.parentRight) {
+                    x = current.parentRight;
+                    inRun = false;
+                    continue;
+                }
+
+                bool open = isOpen(neighbourRow, x, neighbour);
+
+                if (open && !inRun) {
+                    stack.push_back({x, neighbour, y, spanLeft, spanRight});
+                }
+                inRun = open;
+            }
+        }
+    }
+    return bounds.rect();
+}
+
+QRect FloodFill::fill(QImage& image, QPoint seed, QRgb replacement, int tolerance, Mode mode, PixelBlend::Mode blend) {
+    if (image.format() != QImage::Format_ARGB32) {
+        qWarning() << "FloodFill::fill: expected an ARGB32 image";
+        return QRect();
+    }
+
+    if (!image.rect().contains(seed)) {
+        return QRect();
+    }
+
+    const QRgb target = reinterpret_cast<const QRgb*>(image.constScanLine(seed.y()))[seed.x()];
+
+    if (target == replacement && blend == PixelBlend::Replace) {
+        return QRect();
+    }
+
+    auto exact = [target](QRgb color) {
+        return color == target;
+    };
+
+    auto similar = [target, tolerance](QRgb color) {
+        return std::abs(qAlpha(color) - qAlpha(target)) <= tolerance
+               && std::abs(qRed(color) - qRed(target)) <= tolerance
+               && std::abs(qGreen(color) - qGreen(target)) <= tolerance
+               && std::abs(qBlue(color) - qBlue(target)) <= tolerance;
+    };
+
+    if (mode == Global) {
+        return (tolerance <= 0) ? fillGlobal(image, replacement, blend, exact) : fillGlobal(image, replacement, blend, similar);
+    }
+
+    // A filled pixel can only match again if the replacement itself is within the tolerance; a blended
+    // result may be any color, so blended fills always remember what they painted
+    if (blend != PixelBlend::Replace) {
+        return (tolerance <= 0) ? fillContiguous(image, seed, replacement, blend, exact, true)
+                                : fillContiguous(image, seed, replacement, blend, similar, true);
+    }
+
+    if (tolerance <= 0) {
+        return fillContiguous(image, seed, replacement, blend, exact, false);
+    }
+    return fillContiguous(image, seed, replacement, blend, similar, similar(replacement));
+}
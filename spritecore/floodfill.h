@@ -0,0 +1,57 @@
+#ifndef FLOODFILL_H
+#define FLOODFILL_H
+
+/**
+ * @file floodfill.h
+ * @brief Declares the FloodFill class, which implements the bucket tool.
+ *
+ * Contiguous fills use a span-based scanline algorithm with an explicit stack, so every run of
+ * matching pixels is filled in one pass and the call stack never grows with the region size.
+ *
+ * @date 03/31/2025
+ */
+
+#include "pixelblend.h"
+
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+
+/**
+ * @class FloodFill
+ *
+ * @brief Replaces pixels similar to a seed pixel with a new color.
+ */
+class FloodFill {
+
+public:
+
+    /**
+     * @brief Which pixels a fill may reach.
+     */
+    enum Mode {
+        Contiguous, ///< Only pixels connected to the seed through 4-neighbours.
+        Global      ///< Every matching pixel in the image.
+    };
+
+    /**
+     * @brief Fills the region around a seed pixel.
+     *
+     * A pixel matches when each of its ARGB channels is within the tolerance of the seed pixel's
+     * original color. Each matching pixel is painted once, so blended fills do not build up. Nothing
+     * changes if the seed already has the replacement color and the fill replaces pixels.
+     *
+     * @param image The ARGB32 image to fill in place.
+     * @param seed The pixel the fill starts from.
+     * @param replacement The color painted onto every matching pixel.
+     * @param tolerance Largest per-channel difference still treated as a match (0–255).
+     * @param mode Whether to fill the connected region or every matching pixel.
+     * @param blend How the color combines with the matching pixels.
+     * @return Bounding rectangle of the changed pixels, or an empty rectangle if none changed.
+     */
+    static QRect fill(QImage& image, QPoint seed, QRgb replacement, int tolerance, Mode mode,
+                      PixelBlend::Mode blend = PixelBlend::Replace);
+
+};
+
+#endif // FLOODFILL_H
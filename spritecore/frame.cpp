@@ -0,0 +1,340 @@
+/**
+ * @file frame.cpp
+ * @brief Implementation of the Frame class, which represents a 2D pixel grid used in sprite frames.
+ * @date 03/31/2025
+ */
+
+#include "frame.h"
+#include "framebufferpool.h"
+
+#include <QMutex>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+using std::reverse;
+using std::swap;
+using std::vector;
+
+/**
+ * @brief Folds one 64-bit word into a hash lane.
+ */
+static inline quint64 hashRound(quint64 lane, quint64 word) {
+    lane += word * 0xC2B2AE3D27D4EB4FULL;
+    lane = (lane << 31) | (lane >> 33);
+    return lane * 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * @brief Spreads every input bit over the whole hash (the MurmurHash3 finalizer).
+ */
+static inline quint64 hashFinish(quint64 hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @class FrameData
+ *
+ * @brief The pixel buffer shared between copies of a Frame.
+ *
+ * While compressed, the pixels live in a zlib stream instead of the pixel buffer. Expanding is done under a
+ * mutex so that worker threads reading the same compressed frame expand it only once.
+ *
+ * Pixel buffers come from the FrameBufferPool, so a new frame usually reuses the memory of one that was
+ * deleted or dropped from the undo history.
+ */
+class FrameData : public QSharedData {
+
+public:
+
+    FrameData() = default;
+
+    /**
+     * @brief Creates a buffer whose pixels are left for the caller to write.
+     */
+    explicit FrameData(size_t pixelCount) : pixels(pixelCount) {}
+
+    FrameData(size_t pixelCount, QRgb fill) : pixels(pixelCount) {
+        std::fill_n(pixels.data(), pixelCount, fill);
+    }
+
+    FrameData(const FrameData& other) : QSharedData(other) {
+        other.expand();
+        pixels = PixelBuffer(other.pixels.size());
+        std::copy_n(other.pixels.data(), pixels.size(), pixels.data());
+    }
+
+    /**
+     * @brief Decompresses the buffer if needed. Cheap when it is already expanded.
+     */
+    void expand() const {
+        if (!compressed.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        QMutexLocker locker(&mutex);
+
+        if (compressed.load(std::memory_order_relaxed)) {
+            QByteArray raw = qUncompress(packed);
+            pixels = PixelBuffer(static_cast<size_t>(raw.size()) / sizeof(QRgb));
+            memcpy(pixels.data(), raw.constData(), pixels.size() * sizeof(QRgb));
+            packed = QByteArray();
+            compressed.store(false, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Replaces the pixel buffer with a compressed copy.
+     */
+    void compress() const {
+        QMutexLocker locker(&mutex);
+
+        if (compressed.load(std::memory_order_relaxed) || pixels.empty()) {
+            return;
+        }
+
+        QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char*>(pixels.data()),
+                                                 static_cast<qsizetype>(pixels.size() * sizeof(QRgb)));
+        packed = qCompress(raw, 1);
+
+        // Compressing is meant to give memory back, so the buffer is not kept in the pool
+        pixels.discard();
+        compressed.store(true, std::memory_order_release);
+    }
+
+    bool isCompressed() const {
+        return compressed.load(std::memory_order_acquire);
+    }
+
+    qint64 memoryBytes() const {
+        QMutexLocker locker(&mutex);
+        return static_cast<qint64>(pixels.size() * sizeof(QRgb)) + packed.capacity();
+    }
+
+    /**
+     * @brief Packed pixel buffer; empty while compressed.
+     */
+    mutable PixelBuffer pixels;
+
+    /**
+     * @brief Hash of the pixels, valid until the next write; it survives compression.
+     */
+    mutable std::atomic<quint64> hash{0};
+
+    mutable std::atomic<bool> hashValid{false};
+
+private:
+
+    /**
+     * @brief zlib stream holding the pixels while compressed.
+     */
+    mutable QByteArray packed;
+
+    mutable std::atomic<bool> compressed{false};
+
+    mutable QMutex mutex;
+
+};
+
+Frame::Frame() : d(new FrameData), height(0), width(0) {}
+
+Frame::Frame(int height, int width) :
+    d(new FrameData(static_cast<size_t>(height) * width, qRgba(255, 255, 255, 0))),
+    height(height),
+    width(width)
+{}
+
+Frame::Frame(const QImage& image) :
+    Frame(allocate(image.height(), image.width()))
+{
+    QImage source = (image.format() == QImage::Format_ARGB32) ? image : image.convertToFormat(QImage::Format_ARGB32);
+    size_t rowBytes = static_cast<size_t>(width) * sizeof(QRgb);
+
+    if (rowBytes == 0 || height == 0) {
+        return;
+    }
+
+    // Images without row padding are copied in one go
+    if (static_cast<size_t>(source.bytesPerLine()) == rowBytes) {
+        memcpy(scanLine(0), source.constBits(), rowBytes * height);
+        return;
+    }
+
+    for (int i = 0; i < height; i++) {
+        memcpy(scanLine(i), source.constScanLine(i), rowBytes);
+    }
+}
+
+Frame Frame::allocate(int height, int width) {
+    Frame frame;
+    frame.d = new FrameData(static_cast<size_t>(height) * width);
+    frame.height = height;
+    frame.width = width;
+    return frame;
+}
+
+Frame::Frame(const Frame& other) = default;
+
+Frame::Frame(Frame&& other) noexcept = default;
+
+Frame& Frame::operator=(const Frame& other) = default;
+
+Frame& Frame::operator=(Frame&& other) noexcept = default;
+
+Frame::~Frame() = default;
+
+void Frame::updateFrame(int rowIndex, int columnIndex, int red, int green, int blue, int alpha) {
+    if (rowIndex < 0 || rowIndex >= height || columnIndex < 0 || columnIndex >= width) {
+        throw std::out_of_range("Frame::updateFrame: pixel out of range");
+    }
+
+    scanLine(rowIndex)[columnIndex] = qRgba(red, green, blue, alpha);
+}
+
+vector<vector<QColor>> Frame::getPixels() const {
+    vector<vector<QColor>> rows(height, vector<QColor>(width));
+
+    for (int i = 0; i < height; i++) {
+        const QRgb* row = constScanLine(i);
+
+        for (int j = 0; j < width; j++) {
+            rows[i][j] = QColor::fromRgba(row[j]);
+        }
+    }
+    return rows;
+}
+
+const QRgb* Frame::constScanLine(int rowIndex) const {
+    d->expand();
+    return d->pixels.data() + static_cast<size_t>(rowIndex) * width;
+}
+
+QRgb* Frame::scanLine(int rowIndex) {
+    FrameData* data = d.data();
+    data->expand();
+    data->hashValid.store(false, std::memory_order_relaxed);
+    return data->pixels.data() + static_cast<size_t>(rowIndex) * width;
+}
+
+QImage Frame::toImage() const {
+    QImage image(width, height, QImage::Format_ARGB32);
+
+    for (int i = 0; i < height; i++) {
+        memcpy(image.scanLine(i), constScanLine(i), static_cast<size_t>(width) * sizeof(QRgb));
+    }
+    return image;
+}
+
+int Frame::getHeight() const {
+    return height;
+}
+
+int Frame::getWidth() const {
+    return width;
+}
+
+void Frame::rotateFrame() {
+    QRgb* pixels = scanLine(0);
+
+    // Transpose
+    for (int i = 0; i < height; i++) {
+        for (int j = i + 1; j < width; j++) {
+            swap(pixels[static_cast<size_t>(i) * width + j], pixels[static_cast<size_t>(j) * width + i]);
+        }
+    }
+
+    // Reverse each pixel in a row.
+    for (int i = 0; i < height; i++) {
+        QRgb* row = scanLine(i);
+        reverse(row, row + width);
+    }
+}
+
+void Frame::compress() {
+
+    // Hash while the pixels are at hand, so deduplication never has to expand a compressed frame
+    contentHash();
+    d.constData()->compress();
+}
+
+bool Frame::isCompressed() const {
+    return d->isCompressed();
+}
+
+bool Frame::isShared() const {
+    return d->ref.loadRelaxed() > 1;
+}
+
+int Frame::referenceCount() const {
+    return d->ref.loadRelaxed();
+}
+
+qint64 Frame::memoryBytes() const {
+    return d->memoryBytes();
+}
+
+const void* Frame::storageKey() const {
+    return d.constData();
+}
+
+quint64 Frame::contentHash() const {
+    if (d->hashValid.load(std::memory_order_acquire)) {
+        return d->hash.load(std::memory_order_relaxed);
+    }
+
+    d->expand();
+    const QRgb* pixels = d->pixels.data();
+    size_t count = d->pixels.size();
+
+    // Four independent lanes over pairs of pixels keep the multiplies pipelined
+    quint64 lanes[4] = {
+        0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0x27D4EB2F165667C5ULL
+    };
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        for (int lane = 0; lane < 4; ++lane) {
+            quint64 word;
+            memcpy(&word, pixels + i + 2 * lane, sizeof(word));
+            lanes[lane] = hashRound(lanes[lane], word);
+        }
+    }
+
+    quint64 hash = ((lanes[0] << 1) | (lanes[0] >> 63)) ^ ((lanes[1] << 7) | (lanes[1] >> 57))
+                   ^ ((lanes[2] << 12) | (lanes[2] >> 52)) ^ ((lanes[3] << 18) | (lanes[3] >> 46));
+
+    for (; i < count; ++i) {
+        hash = hashRound(hash, pixels[i]);
+    }
+
+    // The size is part of the content, so a 2x8 frame does not match a 4x4 one
+    hash = hashFinish(hash ^ (static_cast<quint64>(height) << 32 | static_cast<quint32>(width)));
+
+    d->hash.store(hash, std::memory_order_relaxed);
+    d->hashValid.store(true, std::memory_order_release);
+    return hash;
+}
+
+bool Frame::hasSamePixels(const Frame& other) const {
+    if (height != other.height || width != other.width) {
+        return false;
+    }
+
+    if (storageKey() == other.storageKey()) {
+        return true;
+    }
+
+    if (contentHash() != other.contentHash()) {
+        return false;
+    }
+
+    // Equal hashes are only a strong hint; the pixels decide
+    return memcmp(constScanLine(0), other.constScanLine(0), static_cast<size_t>(height) * width * sizeof(QRgb)) == 0;
+}
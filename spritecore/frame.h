@@ -0,0 +1,241 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+/**
+ * @file frame.h
+ * @brief Declares the Frame class, which represents a 2D grid of pixels that make up a single sprite frame.
+ *
+ * A Frame stores its pixels as a packed, row-major buffer of QRgb values (ARGB, 8 bits per channel),
+ * taken from a pool that recycles the buffers of deleted frames.
+ * The buffer is implicitly shared: copying a frame is cheap, and the pixels are only duplicated when
+ * one of the copies is modified. An inactive frame's buffer can also be compressed to save memory; it
+ * is expanded again the first time its pixels are read.
+ * Frames are used to store and manipulate individual layers of animation or static sprite images.
+ *
+ * @date 03/31/2025
+ */
+
+#include <QColor>
+#include <QImage>
+#include <QSharedDataPointer>
+
+using std::vector;
+
+class FrameData;
+
+/**
+ * @class Frame
+ *
+ * @brief Represents a single frame of a sprite composed of a grid of RGBA pixels.
+ *
+ * Provides methods for updating individual pixels, rotating the frame, and retrieving
+ * pixel data and frame dimensions.
+ */
+class Frame {
+
+private:
+
+    /**
+     * @brief Shared, copy-on-write pixel buffer, one QRgb per pixel.
+     *
+     * Pixels are stored row by row, so the pixel at (row, column) lives at index row * width + column.
+     * Keeping the rows contiguous lets whole scanlines be copied or scanned at once.
+     */
+    QSharedDataPointer<FrameData> d;
+
+    /**
+     * @brief The height of the frame in pixels.
+     */
+    int height;
+
+    /**
+     * @brief The width of the frame in pixels.
+     */
+    int width;
+
+public:
+
+    /**
+     * @brief Default constructor. Creates an empty frame with zero height and width.
+     */
+    Frame();
+
+    /**
+     * @brief Parameterized constructor. Initializes a frame with the specified height and width.
+     *
+     * All pixels are initialized to fully transparent white (RGBA: 255, 255, 255, 0).
+     *
+     * @param height The height of the frame (number of rows).
+     * @param width The width of the frame (number of columns).
+     */
+    Frame(int height, int width);
+
+    /**
+     * @brief Creates a frame holding a copy of an image, one scanline at a time.
+     *
+     * The image is converted to ARGB32 first if needed, so the frame has the image's size and colors.
+     *
+     * @param image The image to copy.
+     */
+    explicit Frame(const QImage& image);
+
+    /**
+     * @brief Creates a frame whose pixels are left uninitialized, for callers that write every pixel.
+     *
+     * Skips the transparent fill of Frame(int, int), so loading or importing touches each pixel once.
+     *
+     * @param height The height of the frame (number of rows).
+     * @param width The width of the frame (number of columns).
+     * @return The new frame.
+     */
+    static Frame allocate(int height, int width);
+
+    /**
+     * @brief Copies a frame by sharing its pixel buffer until either copy is modified.
+     * @param other The frame to copy.
+     */
+    Frame(const Frame& other);
+
+    /**
+     * @brief Moves a frame, taking over its pixel buffer.
+     * @param other The frame to move from.
+     */
+    Frame(Frame&& other) noexcept;
+
+    /**
+     * @brief Shares another frame's pixel buffer until either frame is modified.
+     * @param other The frame to copy.
+     * @return This frame.
+     */
+    Frame& operator=(const Frame& other);
+
+    /**
+     * @brief Takes over another frame's pixel buffer.
+     * @param other The frame to move from.
+     * @return This frame.
+     */
+    Frame& operator=(Frame&& other) noexcept;
+
+    /**
+     * @brief Releases this frame's reference to its pixel buffer.
+     */
+    ~Frame();
+
+    /**
+     * @brief Updates a specific pixel in the frame with new RGBA values.
+     * @param rowIndex The row index (y-coordinate) of the pixel to update.
+     * @param columnIndex The column index (x-coordinate) of the pixel to update.
+     * @param red Red component (0–255).
+     * @param green Green component (0–255).
+     * @param blue Blue component (0–255).
+     * @param alpha Alpha (opacity) component (0–255).
+     */
+    void updateFrame(int rowIndex, int columnIndex, int red, int green, int blue, int alpha);
+
+    /**
+     * @brief Retrieves the full 2D pixel data of the frame.
+     * @return A 2D vector of QColor objects representing all pixels in the frame.
+     */
+    vector<vector<QColor>> getPixels() const;
+
+    /**
+     * @brief Returns a read-only pointer to the first pixel of a row.
+     * @param rowIndex The row index (y-coordinate) to access.
+     * @return Pointer to width() consecutive QRgb values.
+     */
+    const QRgb* constScanLine(int rowIndex) const;
+
+    /**
+     * @brief Returns a writable pointer to the first pixel of a row.
+     * @param rowIndex The row index (y-coordinate) to access.
+     * @return Pointer to width() consecutive QRgb values.
+     */
+    QRgb* scanLine(int rowIndex);
+
+    /**
+     * @brief Copies the frame into a new ARGB32 image using one memcpy per row.
+     * @return A QImage of the same size as the frame.
+     */
+    QImage toImage() const;
+
+    /**
+     * @brief Rotates the frame 90 degrees clockwise.
+     *
+     * This is done by transposing the pixel matrix and then reversing each row.
+     * Note: This operation assumes the frame is square (height == width).
+     */
+    void rotateFrame();
+
+    /**
+     * @brief Gets the height of the frame.
+     * @return The height in pixels.
+     */
+    int getHeight() const;
+
+    /**
+     * @brief Gets the width of the frame.
+     * @return The width in pixels.
+     */
+    int getWidth() const;
+
+    /**
+     * @brief Compresses the pixel buffer in place, without detaching it from other frames sharing it.
+     *
+     * The pixels are expanded again by the next read or write. Must not be called while other threads
+     * are reading the frame, which may be the case for a buffer also referenced by copies the caller does not own.
+     */
+    void compress();
+
+    /**
+     * @brief Whether the pixel buffer is currently compressed.
+     * @return true if the buffer is compressed.
+     */
+    bool isCompressed() const;
+
+    /**
+     * @brief Whether the pixel buffer is shared with another frame.
+     * @return true if another Frame references the same buffer.
+     */
+    bool isShared() const;
+
+    /**
+     * @brief Returns how many frames reference the pixel buffer, this one included.
+     * @return The buffer's reference count.
+     */
+    int referenceCount() const;
+
+    /**
+     * @brief Returns the heap memory held by the pixel buffer, whether expanded or compressed.
+     * @return Size of the buffer in bytes.
+     */
+    qint64 memoryBytes() const;
+
+    /**
+     * @brief Identifies the pixel buffer, so frames sharing a buffer can be counted once.
+     * @return An address that is the same for all frames sharing a buffer.
+     */
+    const void* storageKey() const;
+
+    /**
+     * @brief Returns a 64-bit hash of the frame's size and pixels.
+     *
+     * The hash is stored with the pixel buffer, so it is computed once per change and shared by every
+     * frame using the buffer. It is not stable across versions and must not be saved.
+     *
+     * @return The hash of the frame's content.
+     */
+    quint64 contentHash() const;
+
+    /**
+     * @brief Checks whether another frame has the same size and pixels.
+     *
+     * Frames sharing a buffer or with different hashes are decided without looking at the pixels.
+     *
+     * @param other The frame to compare with.
+     * @return true if both frames hold identical pixels.
+     */
+    bool hasSamePixels(const Frame& other) const;
+
+};
+
+#endif // FRAME_H
@@ -0,0 +1,108 @@
+/**
+ * @file framebatchrunner.cpp
+ * @brief Implementation of the FrameBatchRunner class.
+ * @date 03/31/2025
+ */
+
+#include "framebatchrunner.h"
+#include "framemanager.h"
+
+#include <QtConcurrent>
+#include <QtDebug>
+
+#include <algorithm>
+
+FrameBatchRunner::FrameBatchRunner(FrameManager* frameManager, QObject* parent) :
+    QObject(parent),
+    frameManager(frameManager)
+{
+    connect(&watcher,
+            &QFutureWatcher<void>::progressValueChanged,
+            this,
+            [this](int completed) {
+                emit progressChanged(completed, static_cast<int>(working.size()));
+            }
+    );
+
+    connect(&watcher,
+            &QFutureWatcher<void>::finished,
+            this,
+            &FrameBatchRunner::onFinished
+    );
+}
+
+FrameBatchRunner::~FrameBatchRunner() {
+    watcher.cancel();
+    watcher.waitForFinished();
+}
+
+bool FrameBatchRunner::start(int first, int last, Operation operation, const QString& description) {
+    if (isRunning()) {
+        qWarning() << "FrameBatchRunner::start: a batch is already running";
+        return false;
+    }
+
+    first = std::max(first, 0);
+    last = std::min(last, static_cast<int>(frameManager->frames.size()) - 1);
+
+    if (first > last) {
+        return false;
+    }
+
+    firstFrame = first;
+    this->operation = std::move(operation);
+    this->description = description;
+
+    // Shared copies cost nothing until a worker changes them
+    working.assign(frameManager->frames.begin() + first, frameManager->frames.begin() + last + 1);
+
+    emit progressChanged(0, static_cast<int>(working.size()));
+    watcher.setFuture(QtConcurrent::map(working, this->operation));
+    return true;
+}
+
+bool FrameBatchRunner::isRunning() const {
+    return !working.empty();
+}
+
+void FrameBatchRunner::cancel() {
+    watcher.cancel();
+}
+
+void FrameBatchRunner::onFinished() {
+    vector<Frame> results;
+    results.swap(working);
+
+    bool committed = !watcher.isCanceled() && frameManager->replaceFrames(firstFrame, std::move(results), description);
+    emit finished(committed);
+}
+
+void FrameBatchRunner::invertColors(Frame& frame) {
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        QRgb* row = frame.scanLine(y);
+
+        for (int x = 0; x < frame.getWidth(); ++x) {
+            row[x] ^= 0x00FFFFFF;
+        }
+    }
+}
+
+void FrameBatchRunner::rotate90Clockwise(Frame& frame) {
+    if (frame.getHeight() == frame.getWidth()) {
+        frame.rotateFrame();
+    }
+}
+
+void FrameBatchRunner::flipHorizontal(Frame& frame) {
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        QRgb* row = frame.scanLine(y);
+        std::reverse(row, row + frame.getWidth());
+    }
+}
+
+void FrameBatchRunner::flipVertical(Frame& frame) {
+    for (int top = 0, bottom = frame.getHeight() - 1; top < bottom; ++top, --bottom) {
+        QRgb* topRow = frame.scanLine(top);
+        std::swap_ranges(topRow, topRow + frame.getWidth(), frame.scanLine(bottom));
+    }
+}
@@ -0,0 +1,157 @@
+#ifndef FRAMEBATCHRUNNER_H
+#define FRAMEBATCHRUNNER_H
+
+/**
+ * @file framebatchrunner.h
+ * @brief Declaration of the FrameBatchRunner class, which applies one operation to a run of frames in parallel.
+ * @date 03/31/2025
+ */
+
+#include "frame.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+
+#include <functional>
+
+class FrameManager;
+
+using std::vector;
+
+/**
+ * @class FrameBatchRunner
+ *
+ * @brief Runs a frame transform or filter over a range of frames on the global thread pool.
+ *
+ * Workers change shared copies of the frames, so the sprite is untouched until every frame is done.
+ * The results then replace the originals through FrameManager::replaceFrames(), which makes the whole
+ * batch one undo step and one framesChanged() notification. A cancelled batch changes nothing.
+ */
+class FrameBatchRunner : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief An operation applied to one frame at a time; it may be called from any thread.
+     */
+    using Operation = std::function<void(Frame&)>;
+
+    /**
+     * @brief Constructs a FrameBatchRunner for a sprite.
+     * @param frameManager The frames to operate on.
+     * @param parent Optional parent QObject.
+     */
+    explicit FrameBatchRunner(FrameManager* frameManager, QObject* parent = nullptr);
+
+    /**
+     * @brief Cancels a running batch and waits for its workers to stop.
+     */
+    ~FrameBatchRunner();
+
+    /**
+     * @brief Starts applying an operation to frames first through last.
+     *
+     * The range is clipped to the existing frames. progressChanged() and finished() are delivered on
+     * the thread that owns the runner.
+     *
+     * @param first Index of the first frame.
+     * @param last Index of the last frame.
+     * @param operation The operation to apply to each frame.
+     * @param description A short name for the undo step.
+     * @return true if the batch started; false if one is already running or the range is empty.
+     */
+    bool start(int first, int last, Operation operation, const QString& description);
+
+    /**
+     * @brief Checks whether a batch is still running.
+     * @return true until finished() has been emitted.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Inverts the red, green and blue channels, keeping alpha.
+     * @param frame The frame to change.
+     */
+    static void invertColors(Frame& frame);
+
+    /**
+     * @brief Rotates a square frame 90 degrees clockwise; other frames are left unchanged.
+     * @param frame The frame to change.
+     */
+    static void rotate90Clockwise(Frame& frame);
+
+    /**
+     * @brief Mirrors the frame left to right.
+     * @param frame The frame to change.
+     */
+    static void flipHorizontal(Frame& frame);
+
+    /**
+     * @brief Mirrors the frame top to bottom.
+     * @param frame The frame to change.
+     */
+    static void flipVertical(Frame& frame);
+
+public slots:
+
+    /**
+     * @brief Stops the running batch; frames already processed are thrown away.
+     */
+    void cancel();
+
+signals:
+
+    /**
+     * @brief Signal emitted as frames are finished.
+     * @param completed The number of frames done so far.
+     * @param total The number of frames in the batch.
+     */
+    void progressChanged(int completed, int total);
+
+    /**
+     * @brief Signal emitted once the batch is over.
+     * @param committed true if the results replaced the frames; false if it was cancelled.
+     */
+    void finished(bool committed);
+
+private:
+
+    /**
+     * @brief Commits the finished batch, or drops it if it was cancelled.
+     */
+    void onFinished();
+
+    /**
+     * @brief The frames operated on.
+     */
+    FrameManager* frameManager;
+
+    /**
+     * @brief Watches the running batch.
+     */
+    QFutureWatcher<void> watcher;
+
+    /**
+     * @brief Copies of the frames in the batch, changed in place by the workers.
+     */
+    vector<Frame> working;
+
+    /**
+     * @brief The operation of the running batch.
+     */
+    Operation operation;
+
+    /**
+     * @brief Index of the first frame in the batch.
+     */
+    int firstFrame = 0;
+
+    /**
+     * @brief Name of the undo step the batch commits as.
+     */
+    QString description;
+};
+
+#endif // FRAMEBATCHRUNNER_H
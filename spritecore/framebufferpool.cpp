@@ -0,0 +1,157 @@
+/**
+ * @file framebufferpool.cpp
+ * @brief Implementation of the FrameBufferPool and PixelBuffer classes.
+ *
+ * Buffers are plain uninitialized arrays; frames fill or overwrite every pixel themselves, so the pool
+ * never touches pixel memory. New buffers are allocated outside the mutex, so threads creating frames
+ * of a new size do not wait on each other.
+ *
+ * @date 03/31/2025
+ */
+
+#include "framebufferpool.h"
+
+#include <utility>
+
+FrameBufferPool& FrameBufferPool::instance() {
+    static FrameBufferPool* pool = new FrameBufferPool;
+    return *pool;
+}
+
+QRgb* FrameBufferPool::acquire(size_t pixelCount) {
+    if (pixelCount == 0) {
+        return nullptr;
+    }
+
+    {
+        QMutexLocker locker(&mutex);
+        auto it = freeLists.find(pixelCount);
+
+        if (it != freeLists.end() && !it->empty()) {
+            QRgb* pixels = it->back();
+            it->pop_back();
+            spareBytes -= static_cast<qint64>(pixelCount * sizeof(QRgb));
+            counters.reuses++;
+            return pixels;
+        }
+        counters.allocations++;
+    }
+    return new QRgb[pixelCount];
+}
+
+void FrameBufferPool::release(QRgb* pixels, size_t pixelCount) {
+    if (!pixels) {
+        return;
+    }
+
+    qint64 bytes = static_cast<qint64>(pixelCount * sizeof(QRgb));
+
+    {
+        QMutexLocker locker(&mutex);
+
+        // Make room by dropping spare buffers of other sizes first, which are likely left from an old sprite size
+        if (spareBytes + bytes > limitBytes) {
+            shrinkTo(limitBytes - bytes, pixelCount);
+        }
+
+        if (spareBytes + bytes <= limitBytes) {
+            freeLists[pixelCount].push_back(pixels);
+            spareBytes += bytes;
+            return;
+        }
+        counters.frees++;
+    }
+    delete[] pixels;
+}
+
+void FrameBufferPool::discard(QRgb* pixels) {
+    delete[] pixels;
+}
+
+void FrameBufferPool::trim() {
+    QMutexLocker locker(&mutex);
+    shrinkTo(0, 0);
+}
+
+qint64 FrameBufferPool::pooledBytes() const {
+    QMutexLocker locker(&mutex);
+    return spareBytes;
+}
+
+qint64 FrameBufferPool::maximumBytes() const {
+    QMutexLocker locker(&mutex);
+    return limitBytes;
+}
+
+void FrameBufferPool::setMaximumBytes(qint64 bytes) {
+    QMutexLocker locker(&mutex);
+    limitBytes = qMax<qint64>(0, bytes);
+    shrinkTo(limitBytes, 0);
+}
+
+FrameBufferPool::Statistics FrameBufferPool::statistics() const {
+    QMutexLocker locker(&mutex);
+    return counters;
+}
+
+void FrameBufferPool::resetStatistics() {
+    QMutexLocker locker(&mutex);
+    counters = Statistics();
+}
+
+void FrameBufferPool::shrinkTo(qint64 bytes, size_t keepPixelCount) {
+    for (int pass = 0; pass < 2 && spareBytes > bytes; ++pass) {
+        for (auto it = freeLists.begin(); it != freeLists.end() && spareBytes > bytes;) {
+
+            // The first pass spares the size class being released
+            if (pass == 0 && it.key() == keepPixelCount) {
+                ++it;
+                continue;
+            }
+
+            while (!it->empty() && spareBytes > bytes) {
+                delete[] it->back();
+                it->pop_back();
+                spareBytes -= static_cast<qint64>(it.key() * sizeof(QRgb));
+                counters.frees++;
+            }
+
+            if (it->empty()) {
+                it = freeLists.erase(it);
+            }
+
+            else {
+                ++it;
+            }
+        }
+    }
+}
+
+PixelBuffer::PixelBuffer(size_t pixelCount) :
+    pixels(FrameBufferPool::instance().acquire(pixelCount)),
+    count(pixelCount)
+{}
+
+PixelBuffer::PixelBuffer(PixelBuffer&& other) noexcept :
+    pixels(std::exchange(other.pixels, nullptr)),
+    count(std::exchange(other.count, 0))
+{}
+
+PixelBuffer& PixelBuffer::operator=(PixelBuffer&& other) noexcept {
+    if (this != &other) {
+        FrameBufferPool::instance().release(pixels, count);
+        pixels = std::exchange(other.pixels, nullptr);
+        count = std::exchange(other.count, 0);
+    }
+    return *this;
+}
+
+PixelBuffer::~PixelBuffer() {
+    FrameBufferPool::instance().release(pixels, count);
+}
+
+void PixelBuffer::discard() {
+    FrameBufferPool::instance().discard(pixels);
+    pixels = nullptr;
+    count = 0;
+}
@@ -0,0 +1,252 @@
+#ifndef FRAMEBUFFERPOOL_H
+#define FRAMEBUFFERPOOL_H
+
+/**
+ * @file framebufferpool.h
+ * @brief Declaration of the FrameBufferPool class, which recycles frame pixel buffers, and of the PixelBuffer handle.
+ * @date 03/31/2025
+ */
+
+#include <QHash>
+#include <QMutex>
+#include <QRgb>
+
+#include <vector>
+
+using std::vector;
+
+/**
+ * @class FrameBufferPool
+ *
+ * @brief A process-wide pool of pixel buffers, with one size class per pixel count.
+ *
+ * Every frame of a sprite has the same size, so a buffer given back by a deleted frame, an evicted
+ * undo step or a cleared project fits the next frame exactly. Freed buffers are kept on a free list
+ * for their size and handed out again instead of asking the system for new memory.
+ *
+ * The pool holds at most maximumBytes() of spare buffers. When a buffer is returned to a full pool,
+ * spare buffers of other sizes, left over from a previous sprite size, are freed first.
+ *
+ * All functions are thread-safe.
+ */
+class FrameBufferPool {
+
+public:
+
+    /**
+     * @brief Counters describing how buffers were obtained since the last resetStatistics().
+     */
+    struct Statistics {
+
+        /**
+         * @brief Buffers allocated from the system because no spare one of the size was pooled.
+         */
+        quint64 allocations = 0;
+
+        /**
+         * @brief Buffers handed out again from the pool.
+         */
+        quint64 reuses = 0;
+
+        /**
+         * @brief Buffers freed to the system because the pool was full or trimmed.
+         */
+        quint64 frees = 0;
+    };
+
+    /**
+     * @brief Default limit on spare buffers held by the pool.
+     */
+    static constexpr qint64 defaultMaximumBytes = qint64(64) << 20;
+
+    /**
+     * @brief Returns the pool shared by all frames.
+     *
+     * The pool is never destroyed, so frames released during static destruction still find it.
+     *
+     * @return The process-wide pool.
+     */
+    static FrameBufferPool& instance();
+
+    /**
+     * @brief Takes a buffer from the pool, or allocates one. Its contents are undefined.
+     * @param pixelCount The number of pixels the buffer must hold.
+     * @return The buffer, or nullptr for a pixel count of 0.
+     */
+    QRgb* acquire(size_t pixelCount);
+
+    /**
+     * @brief Gives a buffer back to the pool for reuse, or frees it if the pool is full.
+     * @param pixels A buffer from acquire(), or nullptr.
+     * @param pixelCount The pixel count it was acquired with.
+     */
+    void release(QRgb* pixels, size_t pixelCount);
+
+    /**
+     * @brief Frees a buffer to the system without pooling it, for example when its frame is compressed to save memory.
+     * @param pixels A buffer from acquire(), or nullptr.
+     */
+    void discard(QRgb* pixels);
+
+    /**
+     * @brief Frees every spare buffer.
+     */
+    void trim();
+
+    /**
+     * @brief Returns the memory held by spare buffers.
+     * @return Size of the pooled buffers in bytes.
+     */
+    qint64 pooledBytes() const;
+
+    /**
+     * @brief Returns the limit on spare buffers.
+     * @return The limit in bytes.
+     */
+    qint64 maximumBytes() const;
+
+    /**
+     * @brief Sets the limit on spare buffers, freeing any above it.
+     * @param bytes The new limit in bytes; 0 disables pooling.
+     */
+    void setMaximumBytes(qint64 bytes);
+
+    /**
+     * @brief Returns the allocation counters.
+     * @return The counters since the last reset.
+     */
+    Statistics statistics() const;
+
+    /**
+     * @brief Sets the allocation counters back to zero.
+     */
+    void resetStatistics();
+
+private:
+
+    FrameBufferPool() = default;
+
+    FrameBufferPool(const FrameBufferPool&) = delete;
+
+    FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+    /**
+     * @brief Frees spare buffers until at most the given number of bytes are pooled, sparing one size class if possible.
+     * @param bytes The number of bytes that may stay pooled.
+     * @param keepPixelCount A size class to free from last.
+     */
+    void shrinkTo(qint64 bytes, size_t keepPixelCount);
+
+    /**
+     * @brief Spare buffers by pixel count.
+     */
+    QHash<size_t, vector<QRgb*>> freeLists;
+
+    /**
+     * @brief Size of all spare buffers in bytes.
+     */
+    qint64 spareBytes = 0;
+
+    /**
+     * @brief Limit on spareBytes.
+     */
+    qint64 limitBytes = defaultMaximumBytes;
+
+    /**
+     * @brief Allocation counters since the last reset.
+     */
+    Statistics counters;
+
+    /**
+     * @brief Guards all members; frames are created and destroyed on worker threads.
+     */
+    mutable QMutex mutex;
+};
+
+/**
+ * @class PixelBuffer
+ *
+ * @brief Owns a buffer from the FrameBufferPool and gives it back when destroyed.
+ *
+ * Move-only; copying pixels is left to the caller, so every copy is explicit.
+ */
+class PixelBuffer {
+
+public:
+
+    /**
+     * @brief Creates an empty buffer.
+     */
+    PixelBuffer() = default;
+
+    /**
+     * @brief Takes a buffer of the given size from the pool. Its contents are undefined.
+     * @param pixelCount The number of pixels.
+     */
+    explicit PixelBuffer(size_t pixelCount);
+
+    /**
+     * @brief Takes over another buffer, leaving it empty.
+     * @param other The buffer to move from.
+     */
+    PixelBuffer(PixelBuffer&& other) noexcept;
+
+    /**
+     * @brief Releases this buffer and takes over another, leaving it empty.
+     * @param other The buffer to move from.
+     * @return This buffer.
+     */
+    PixelBuffer& operator=(PixelBuffer&& other) noexcept;
+
+    PixelBuffer(const PixelBuffer&) = delete;
+
+    PixelBuffer& operator=(const PixelBuffer&) = delete;
+
+    /**
+     * @brief Gives the buffer back to the pool.
+     */
+    ~PixelBuffer();
+
+    /**
+     * @brief Frees the buffer to the system, bypassing the pool, and leaves this buffer empty.
+     */
+    void discard();
+
+    /**
+     * @brief Returns the first pixel.
+     * @return The buffer, or nullptr if it is empty.
+     */
+    QRgb* data() { return pixels; }
+
+    /**
+     * @brief Returns the first pixel.
+     * @return The buffer, or nullptr if it is empty.
+     */
+    const QRgb* data() const { return pixels; }
+
+    /**
+     * @brief Returns the number of pixels.
+     * @return The pixel count.
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Whether the buffer holds no pixels.
+     * @return true if the buffer is empty.
+     */
+    bool empty() const { return count == 0; }
+
+private:
+
+    /**
+     * @brief The pooled buffer; nullptr when empty.
+     */
+    QRgb* pixels = nullptr;
+
+    /**
+     * @brief The number of pixels in the buffer.
+     */
+    size_t count = 0;
+};
+
+#endif // FRAMEBUFFERPOOL_H
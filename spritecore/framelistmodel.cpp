@@ -0,0 +1,194 @@
+/**
+ * @file framelistmodel.cpp
+ * @brief Implementation of the FrameListModel class.
+ *
+ * Labels are derived from the row, so inserting or deleting a frame renumbers the rows after it
+ * without touching them; the view asks again for the rows it repaints.
+ *
+ * @date 03/31/2025
+ */
+
+#include "framelistmodel.h"
+
+#include <QPixmap>
+
+FrameListModel::FrameListModel(FrameManager* frameManager, QObject* parent) :
+    QAbstractListModel(parent),
+    frameManager(frameManager)
+{
+    // Connect frame list changes to the matching row changes, begun before the frames change
+    connect(frameManager,
+            &FrameManager::framesAboutToBeInserted,
+            this,
+            &FrameListModel::onFramesAboutToBeInserted
+    );
+
+    connect(frameManager,
+            &FrameManager::framesInserted,
+            this,
+            &FrameListModel::onFramesInserted
+    );
+
+    connect(frameManager,
+            &FrameManager::frameAboutToBeDeleted,
+            this,
+            &FrameListModel::onFrameAboutToBeDeleted
+    );
+
+    connect(frameManager,
+            &FrameManager::frameDeleted,
+            this,
+            &FrameListModel::onFrameDeleted
+    );
+
+    connect(frameManager,
+            &FrameManager::framesAboutToBeMoved,
+            this,
+            &FrameListModel::onFramesAboutToBeMoved
+    );
+
+    connect(frameManager,
+            &FrameManager::framesMoved,
+            this,
+            &FrameListModel::onFramesMoved
+    );
+
+    connect(frameManager,
+            &FrameManager::framesAboutToBeCleared,
+            this,
+            &FrameListModel::onFramesAboutToBeCleared
+    );
+
+    connect(frameManager,
+            &FrameManager::framesCleared,
+            this,
+            &FrameListModel::onFramesCleared
+    );
+
+    connect(frameManager,
+            &FrameManager::frameDurationChanged,
+            this,
+            &FrameListModel::onFrameDurationChanged
+    );
+}
+
+int FrameListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(frameManager->frames.size());
+}
+
+QVariant FrameListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    if (role == Qt::DisplayRole) {
+        int duration = frameManager->frameDuration(index.row());
+
+        // Frames without their own duration follow the preview's playback speed
+        if (duration > 0) {
+            return QString("Frame %1 (%2 ms)").arg(index.row() + 1).arg(duration);
+        }
+        return QString("Frame %1").arg(index.row() + 1);
+    }
+
+    if (role == Qt::DecorationRole) {
+        auto it = thumbnails.constFind(frameManager->frameId(index.row()));
+
+        if (it != thumbnails.constEnd()) {
+            return it.value();
+        }
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags FrameListModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) {
+        return Qt::ItemIsDropEnabled;
+    }
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled | Qt::ItemNeverHasChildren;
+}
+
+Qt::DropActions FrameListModel::supportedDropActions() const {
+    return Qt::MoveAction;
+}
+
+bool FrameListModel::moveRows(const QModelIndex& sourceParent, int sourceRow, int count,
+                              const QModelIndex& destinationParent, int destinationChild) {
+    if (sourceParent.isValid() || destinationParent.isValid() || count < 1) {
+        return false;
+    }
+
+    emit framesAboutToMove();
+    return frameManager->moveFrames(sourceRow, sourceRow + count - 1, destinationChild);
+}
+
+void FrameListModel::setThumbnail(int frameIndex, const QImage& thumbnail) {
+    FrameManager::FrameId frameId = frameManager->frameId(frameIndex);
+
+    if (frameId == 0) {
+        return;
+    }
+
+    // Converted once here rather than by the delegate on every repaint
+    thumbnails.insert(frameId, QIcon(QPixmap::fromImage(thumbnail)));
+
+    QModelIndex changed = index(frameIndex);
+    emit dataChanged(changed, changed, {Qt::DecorationRole});
+}
+
+void FrameListModel::onFramesAboutToBeInserted(int first, int last) {
+    beginInsertRows(QModelIndex(), first, last);
+}
+
+void FrameListModel::onFramesInserted() {
+    endInsertRows();
+}
+
+void FrameListModel::onFrameAboutToBeDeleted(int frameIndex) {
+    beginRemoveRows(QModelIndex(), frameIndex, frameIndex);
+}
+
+void FrameListModel::onFrameDeleted(int, FrameManager::FrameId frameId) {
+    endRemoveRows();
+
+    // IDs are never reused, so only the deleted frame's thumbnail is stale
+    thumbnails.remove(frameId);
+}
+
+void FrameListModel::onFramesAboutToBeMoved(int first, int last, int destination) {
+    movingRows = beginMoveRows(QModelIndex(), first, last, QModelIndex(), destination);
+
+    // A move the views refuse is shown by resetting them around it
+    if (!movingRows) {
+        beginResetModel();
+    }
+}
+
+void FrameListModel::onFramesMoved() {
+    if (movingRows) {
+        endMoveRows();
+    }
+
+    else {
+        endResetModel();
+    }
+    movingRows = false;
+}
+
+void FrameListModel::onFrameDurationChanged(int frameIndex) {
+    if (frameIndex >= rowCount()) {
+        return;
+    }
+
+    QModelIndex changed = index(frameIndex);
+    emit dataChanged(changed, changed, {Qt::DisplayRole});
+}
+
+void FrameListModel::onFramesAboutToBeCleared() {
+    beginResetModel();
+}
+
+void FrameListModel::onFramesCleared() {
+    thumbnails.clear();
+    endResetModel();
+}
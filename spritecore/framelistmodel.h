@@ -0,0 +1,169 @@
+#ifndef FRAMELISTMODEL_H
+#define FRAMELISTMODEL_H
+
+/**
+ * @file framelistmodel.h
+ * @brief Declaration of the FrameListModel class, which presents the frames of a FrameManager to a list view.
+ * @date 03/31/2025
+ */
+
+#include "framemanager.h"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+
+/**
+ * @class FrameListModel
+ *
+ * @brief A list model with one row per frame, in animation order.
+ *
+ * Nothing is stored per row: labels are made from the row number and the frame's duration when the view
+ * asks for them, and thumbnails are kept by frame ID only for frames that have been shown. Inserting,
+ * deleting, moving and clearing frames in the FrameManager are passed on as the matching row signals, begun
+ * from the manager's "about to" signals and ended after it changed, so the view only lays out what changed
+ * and a project of any length opens at the cost of the rows on screen.
+ *
+ * Rows dragged within the view are moved through moveRows(), which moves the frames in the FrameManager.
+ */
+class FrameListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructs a FrameListModel over the frames of a FrameManager.
+     * @param frameManager The frames to present.
+     * @param parent Optional parent QObject.
+     */
+    explicit FrameListModel(FrameManager* frameManager, QObject* parent = nullptr);
+
+    /**
+     * @brief Returns the number of frames.
+     * @param parent Must be invalid; rows have no children.
+     * @return The row count.
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Returns the label or thumbnail of a frame.
+     * @param index The frame's row.
+     * @param role Qt::DisplayRole for "Frame N", Qt::DecorationRole for the thumbnail.
+     * @return The data, or an invalid QVariant for other roles or frames without a thumbnail yet.
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Returns the item flags; rows can be dragged and dropped between.
+     * @param index The row, or an invalid index for the space between rows.
+     * @return The flags.
+     */
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    /**
+     * @brief Returns the drop actions the model accepts.
+     * @return Qt::MoveAction.
+     */
+    Qt::DropActions supportedDropActions() const override;
+
+    /**
+     * @brief Moves frames within the list.
+     *
+     * Emits framesAboutToMove() first, then moves the frames in the FrameManager, whose move signals
+     * move the rows.
+     *
+     * @param sourceParent Must be invalid.
+     * @param sourceRow The first row to move.
+     * @param count The number of rows to move.
+     * @param destinationParent Must be invalid.
+     * @param destinationChild The row, counted before the move, the rows end up in front of.
+     * @return true if the frames moved.
+     */
+    bool moveRows(const QModelIndex& sourceParent, int sourceRow, int count,
+                  const QModelIndex& destinationParent, int destinationChild) override;
+
+public slots:
+
+    /**
+     * @brief Shows a thumbnail for a frame.
+     * @param frameIndex The frame's row.
+     * @param thumbnail The frame's thumbnail.
+     */
+    void setThumbnail(int frameIndex, const QImage& thumbnail);
+
+signals:
+
+    /**
+     * @brief Signal emitted before frames dragged in the view are moved, while every frame is still in place.
+     */
+    void framesAboutToMove();
+
+private slots:
+
+    /**
+     * @brief Begins adding the rows of frames about to be inserted.
+     */
+    void onFramesAboutToBeInserted(int first, int last);
+
+    /**
+     * @brief Finishes adding the rows of inserted frames.
+     */
+    void onFramesInserted();
+
+    /**
+     * @brief Begins removing the row of a frame about to be deleted.
+     */
+    void onFrameAboutToBeDeleted(int frameIndex);
+
+    /**
+     * @brief Finishes removing the row of a deleted frame and drops its thumbnail.
+     */
+    void onFrameDeleted(int frameIndex, FrameManager::FrameId frameId);
+
+    /**
+     * @brief Begins moving the rows of frames about to be moved.
+     */
+    void onFramesAboutToBeMoved(int first, int last, int destination);
+
+    /**
+     * @brief Finishes moving the rows of moved frames.
+     */
+    void onFramesMoved();
+
+    /**
+     * @brief Begins removing every row.
+     */
+    void onFramesAboutToBeCleared();
+
+    /**
+     * @brief Finishes removing every row and drops every thumbnail.
+     */
+    void onFramesCleared();
+
+    /**
+     * @brief Relabels the row of a frame whose duration changed.
+     */
+    void onFrameDurationChanged(int frameIndex);
+
+private:
+
+    /**
+     * @brief The frames presented.
+     */
+    FrameManager* frameManager;
+
+    /**
+     * @brief Whether the views accepted the move begun for the frames being moved.
+     *
+     * If they did not, the views are reset once the frames have moved instead.
+     */
+    bool movingRows = false;
+
+    /**
+     * @brief Thumbnails of frames that have been shown, by frame ID.
+     */
+    QHash<FrameManager::FrameId, QIcon> thumbnails;
+};
+
+#endif // FRAMELISTMODEL_H
@@ -0,0 +1,703 @@
+/**
+ * @file framemanager.cpp
+ * @brief Implementation of the FrameManager class for managing sprite frames and pixel data.
+ * @date 03/31/2025
+ *
+ * Checked by Nicholas Cicalese
+ */
+
+#include "framemanager.h"
+#include "framebufferpool.h"
+
+#include <QSet>
+#include <QtConcurrent>
+#include <QtDebug>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+
+using std::vector;
+
+FrameManager::FrameManager(int height, int width, QObject* parent) :
+    QObject(parent),
+    height(height),
+    width(width)
+{}
+
+void FrameManager::addFrameJson(Frame frameToAdd){
+    insertFrameAt(static_cast<int>(frames.size()), std::move(frameToAdd));
+    enforceMemoryBudget();
+}
+
+void FrameManager::addFrame() {
+    insertFrame(static_cast<int>(frames.size()));
+}
+
+void FrameManager::insertFrame(int frameIndex) {
+    insertFrameAt(frameIndex, Frame(height, width));
+    enforceMemoryBudget();
+}
+
+void FrameManager::deleteFrame(int frameIndex) {
+    if (frames.size() > 1 && frameIndex >= 0 && frameIndex < static_cast<int>(frames.size())) {
+        FrameId removedId = frameIds[frameIndex];
+        emit frameAboutToBeDeleted(frameIndex);
+
+        // Only the handles after the frame move up; the pixels stay where they are
+        frames.erase(frames.begin() + frameIndex);
+        frameIds.erase(frameIds.begin() + frameIndex);
+        durations.erase(durations.begin() + frameIndex);
+
+        // Steps refer to frames by ID, so only the deleted frame's snapshots go
+        for (vector<UndoStep>* history : {&undoSteps, &redoSteps}) {
+            for (UndoStep& step : *history) {
+                auto removed = std::remove_if(step.frames.begin(), step.frames.end(), [removedId](const std::pair<FrameId, Frame>& saved) {
+                    return saved.first == removedId;
+                });
+                step.frames.erase(removed, step.frames.end());
+            }
+
+            history->erase(std::remove_if(history->begin(), history->end(), [](const UndoStep& step) {
+                return step.frames.empty();
+            }), history->end());
+        }
+        emit frameDeleted(frameIndex, removedId);
+        emit undoHistoryChanged();
+    }
+}
+
+void FrameManager::copyFrame(int frameIndex) {
+    copyFrameTo(frameIndex, static_cast<int>(frames.size()));
+}
+
+void FrameManager::copyFrameTo(int frameIndex, int position) {
+    if (frameIndex < 0 || frameIndex >= static_cast<int>(frames.size())) {
+        qWarning() << "FrameManager::copyFrameTo: frame" << frameIndex << "does not exist";
+        return;
+    }
+    insertFrameAt(position, frames[frameIndex], durations[frameIndex]);
+}
+
+void FrameManager::updateFrame(int frameIndex, int rowIndex, int columnIndex, int red, int green, int blue, int alpha) {
+
+    // A step per pixel would copy the whole frame each time, so single pixels are only grouped
+    if (openStepDepth > 0) {
+        rememberFrame(frameIndex);
+    }
+    frames.at(frameIndex).updateFrame(rowIndex, columnIndex, red, green, blue, alpha);
+}
+
+void FrameManager::updateFrameRegion(int frameIndex, const QImage& image, const QRegion& region) {
+    rememberFrame(frameIndex);
+
+    Frame& frame = frames.at(frameIndex);
+    QRect bounds = QRect(0, 0, frame.getWidth(), frame.getHeight()) & image.rect();
+    QImage source = (image.format() == QImage::Format_ARGB32) ? image : image.convertToFormat(QImage::Format_ARGB32);
+
+    for (const QRect& rect : region) {
+        QRect clipped = rect & bounds;
+        size_t rowBytes = static_cast<size_t>(clipped.width()) * sizeof(QRgb);
+
+        for (int y = clipped.top(); y <= clipped.bottom(); ++y) {
+            const QRgb* sourceRow = reinterpret_cast<const QRgb*>(source.constScanLine(y));
+            memcpy(frame.scanLine(y) + clipped.left(), sourceRow + clipped.left(), rowBytes);
+        }
+    }
+}
+
+vector<Frame> FrameManager::sendFrames(){
+    return frames;
+}
+
+void FrameManager::rotate90Clockwise(int frameIndex) {
+    rememberFrame(frameIndex);
+
+    Frame* frameToRotate = &frames.at(frameIndex);
+    frameToRotate->rotateFrame();
+    emit foundFrame(*frameToRotate);
+}
+
+void FrameManager::setActiveFrame(int frameIndex) {
+    activeFrameId = frameId(frameIndex);
+    enforceMemoryBudget();
+}
+
+FrameManager::FrameId FrameManager::frameId(int frameIndex) const {
+    return (frameIndex >= 0 && frameIndex < static_cast<int>(frameIds.size())) ? frameIds[frameIndex] : 0;
+}
+
+int FrameManager::indexOfFrame(FrameId id) const {
+    auto found = std::find(frameIds.begin(), frameIds.end(), id);
+    return (found == frameIds.end()) ? -1 : static_cast<int>(found - frameIds.begin());
+}
+
+const vector<FrameManager::FrameId>& FrameManager::frameOrder() const {
+    return frameIds;
+}
+
+int FrameManager::frameDuration(int frameIndex) const {
+    return (frameIndex >= 0 && frameIndex < static_cast<int>(durations.size())) ? durations[frameIndex] : 0;
+}
+
+const vector<int>& FrameManager::frameDurations() const {
+    return durations;
+}
+
+PlaybackTimeline FrameManager::timeline(int defaultDuration) const {
+    return PlaybackTimeline(durations, defaultDuration);
+}
+
+void FrameManager::setFrameDuration(int frameIndex, int milliseconds) {
+    if (frameIndex < 0 || frameIndex >= static_cast<int>(durations.size())) {
+        qWarning() << "FrameManager::setFrameDuration: frame" << frameIndex << "does not exist";
+        return;
+    }
+
+    milliseconds = std::clamp(milliseconds, 0, maximumFrameDuration);
+
+    if (durations[frameIndex] != milliseconds) {
+        durations[frameIndex] = milliseconds;
+        emit frameDurationChanged(frameIndex);
+    }
+}
+
+void FrameManager::clearFrames() {
+    emit framesAboutToBeCleared();
+    frames.clear();
+    frameIds.clear();
+    durations.clear();
+    countedBytes = -1;
+
+    emit framesCleared();
+}
+
+bool FrameManager::moveFrames(int first, int last, int destination) {
+    int count = static_cast<int>(frames.size());
+
+    if (first < 0 || last < first || last >= count || destination < 0 || destination > count) {
+        qWarning() << "FrameManager::moveFrames: cannot move frames" << first << "to" << last << "before" << destination;
+        return false;
+    }
+
+    // Moving a run in front of itself or of the frame right after it changes nothing
+    if (destination >= first && destination <= last + 1) {
+        return true;
+    }
+
+    emit framesAboutToBeMoved(first, last, destination);
+
+    // Rotating the handles and IDs leaves every pixel buffer in place
+    if (destination < first) {
+        std::rotate(frames.begin() + destination, frames.begin() + first, frames.begin() + last + 1);
+        std::rotate(frameIds.begin() + destination, frameIds.begin() + first, frameIds.begin() + last + 1);
+        std::rotate(durations.begin() + destination, durations.begin() + first, durations.begin() + last + 1);
+    }
+
+    else {
+        std::rotate(frames.begin() + first, frames.begin() + last + 1, frames.begin() + destination);
+        std::rotate(frameIds.begin() + first, frameIds.begin() + last + 1, frameIds.begin() + destination);
+        std::rotate(durations.begin() + first, durations.begin() + last + 1, durations.begin() + destination);
+    }
+
+    emit framesMoved(first, last, destination);
+    return true;
+}
+
+void FrameManager::reportCacheUsage(const QString& cacheName, qint64 bytes) {
+    uncountedBytes += std::max<qint64>(0, bytes - cacheUsage.value(cacheName));
+    cacheUsage.insert(cacheName, bytes);
+}
+
+MemoryUsage FrameManager::memoryUsage() const {
+    MemoryUsage usage;
+    usage.frameBytes.reserve(frames.size());
+    QSet<const void*> counted;
+
+    for (const Frame& frame : frames) {
+        qint64 bytes = frame.memoryBytes();
+        usage.frameBytes.push_back(bytes);
+
+        if (frame.isCompressed()) {
+            usage.compressedFrames++;
+        }
+
+        // A buffer shared by several frames is only counted the first time it is seen
+        if (counted.contains(frame.storageKey())) {
+            continue;
+        }
+        counted.insert(frame.storageKey());
+
+        if (frame.isShared()) {
+            usage.sharedBytes += bytes;
+        }
+
+        else {
+            usage.uniqueBytes += bytes;
+        }
+
+        if (frame.isCompressed()) {
+            usage.compressedBytes += bytes;
+        }
+    }
+
+    // Undo steps share buffers with frames until the frames change, so only the rest is history
+    for (const vector<UndoStep>* history : {&undoSteps, &redoSteps}) {
+        for (const UndoStep& step : *history) {
+            for (const std::pair<FrameId, Frame>& saved : step.frames) {
+                if (!counted.contains(saved.second.storageKey())) {
+                    counted.insert(saved.second.storageKey());
+                    usage.undoBytes += saved.second.memoryBytes();
+                }
+            }
+        }
+    }
+
+    for (qint64 bytes : cacheUsage) {
+        usage.cacheBytes += bytes;
+    }
+    return usage;
+}
+
+qint64 FrameManager::memoryBudget() const {
+    return budgetBytes;
+}
+
+void FrameManager::setMemoryBudget(qint64 bytes) {
+    budgetBytes = std::max<qint64>(0, bytes);
+    countedBytes = -1;
+    enforceMemoryBudget();
+}
+
+void FrameManager::enforceMemoryBudget() {
+    if (budgetBytes <= 0) {
+        return;
+    }
+
+    // Between full counts only growth is added up. While that upper bound fits the budget the count is
+    // skipped, but never for more adds than there are frames: counting stays amortized O(1) per add, and
+    // growth nobody reports, such as compressed frames expanding when read, is still noticed
+    if (countedBytes >= 0 && countedBytes + uncountedBytes <= budgetBytes && framesSinceCount < static_cast<int>(frames.size())) {
+        return;
+    }
+
+    countedBytes = reduceMemoryUse(memoryUsage().totalBytes());
+    uncountedBytes = 0;
+    framesSinceCount = 0;
+}
+
+qint64 FrameManager::reduceMemoryUse(qint64 total) {
+    if (total <= budgetBytes) {
+        return total;
+    }
+
+    // Give caches the first chance to shrink; spare pooled buffers go back to the system too
+    emit memoryBudgetExceeded(total - budgetBytes);
+    FrameBufferPool::instance().trim();
+    total = memoryUsage().totalBytes();
+
+    // Sharing identical frames is free to undo, so it comes before any compression
+    if (deduplicateFrames() > 0) {
+        total = memoryUsage().totalBytes();
+
+        if (total <= budgetBytes) {
+            return total;
+        }
+    }
+
+    // Count the references the manager itself holds to each buffer. A buffer with more is also held
+    // elsewhere, such as by a thumbnail or batch worker that may be reading it, and is left alone.
+    QSet<const void*> liveStorage;
+    QHash<const void*, int> ownReferences;
+
+    for (const Frame& frame : frames) {
+        liveStorage.insert(frame.storageKey());
+        ownReferences[frame.storageKey()]++;
+    }
+
+    for (const vector<UndoStep>* history : {&undoSteps, &redoSteps}) {
+        for (const UndoStep& step : *history) {
+            for (const std::pair<FrameId, Frame>& saved : step.frames) {
+                ownReferences[saved.second.storageKey()]++;
+            }
+        }
+    }
+
+    for (const std::pair<FrameId, Frame>& saved : openStep.frames) {
+        ownReferences[saved.second.storageKey()]++;
+    }
+
+    auto heldElsewhere = [&ownReferences](const Frame& frame) {
+        return frame.referenceCount() > ownReferences.value(frame.storageKey());
+    };
+
+    // Then compress undo history the frames no longer share, oldest first
+
+    for (vector<UndoStep>* history : {&undoSteps, &redoSteps}) {
+        for (UndoStep& step : *history) {
+            for (std::pair<FrameId, Frame>& saved : step.frames) {
+                if (total <= budgetBytes) {
+                    return total;
+                }
+
+                if (saved.second.isCompressed() || liveStorage.contains(saved.second.storageKey()) || heldElsewhere(saved.second)) {
+                    continue;
+                }
+
+                qint64 before = saved.second.memoryBytes();
+                saved.second.compress();
+                total -= before - saved.second.memoryBytes();
+            }
+        }
+    }
+
+    // Compress the frames furthest from the one being edited first
+    const int activeFrame = indexOfFrame(activeFrameId);
+    vector<int> order;
+    order.reserve(frames.size());
+
+    for (int i = 0; i < static_cast<int>(frames.size()); ++i) {
+        if (i != activeFrame) {
+            order.push_back(i);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [activeFrame](int a, int b) {
+        return std::abs(a - activeFrame) > std::abs(b - activeFrame);
+    });
+
+    // Buffers shared with the active frame stay expanded, or the next edit would undo the work
+    const void* activeStorage = nullptr;
+
+    if (activeFrame >= 0 && activeFrame < static_cast<int>(frames.size())) {
+        activeStorage = frames[activeFrame].storageKey();
+    }
+
+    for (int frameIndex : order) {
+        if (total <= budgetBytes) {
+            break;
+        }
+
+        Frame& frame = frames[frameIndex];
+
+        if (frame.isCompressed() || frame.storageKey() == activeStorage || heldElsewhere(frame)) {
+            continue;
+        }
+
+        qint64 before = frame.memoryBytes();
+        frame.compress();
+        total -= before - frame.memoryBytes();
+    }
+    return total;
+}
+
+vector<int> FrameManager::findDuplicateFrames(vector<int>& uniqueFrames) const {
+    vector<int> order(frames.size());
+    QHash<quint64, vector<int>> buckets;
+    QHash<const void*, int> byStorage;
+    uniqueFrames.clear();
+
+    for (int i = 0; i < static_cast<int>(frames.size()); ++i) {
+
+        // Frames sharing a buffer are identical without hashing or comparing them
+        auto shared = byStorage.constFind(frames[i].storageKey());
+
+        if (shared != byStorage.constEnd()) {
+            order[i] = shared.value();
+            continue;
+        }
+
+        vector<int>& candidates = buckets[frames[i].contentHash()];
+        int match = -1;
+
+        // Candidates are positions in uniqueFrames; a bucket almost never holds more than one
+        for (int candidate : candidates) {
+            if (frames[uniqueFrames[candidate]].hasSamePixels(frames[i])) {
+                match = candidate;
+                break;
+            }
+        }
+
+        if (match < 0) {
+            match = static_cast<int>(uniqueFrames.size());
+            uniqueFrames.push_back(i);
+            candidates.push_back(match);
+        }
+        order[i] = match;
+        byStorage.insert(frames[i].storageKey(), match);
+    }
+    return order;
+}
+
+int FrameManager::deduplicateFrames() {
+    vector<int> uniqueFrames;
+    vector<int> order = findDuplicateFrames(uniqueFrames);
+    int merged = 0;
+
+    for (int i = 0; i < static_cast<int>(frames.size()); ++i) {
+        const Frame& original = frames[uniqueFrames[order[i]]];
+
+        if (frames[i].storageKey() != original.storageKey()) {
+            frames[i] = original;
+            merged++;
+        }
+    }
+    return merged;
+}
+
+void FrameManager::beginUndoStep(const QString& description) {
+    if (openStepDepth++ == 0) {
+        openStep = UndoStep();
+        openStep.description = description;
+    }
+}
+
+void FrameManager::endUndoStep() {
+    if (openStepDepth == 0) {
+        qWarning() << "FrameManager::endUndoStep: no undo step is open";
+        return;
+    }
+
+    if (--openStepDepth == 0 && !openStep.frames.empty()) {
+        pushUndoStep(std::move(openStep));
+    }
+    openStep = UndoStep();
+}
+
+bool FrameManager::replaceFrames(int first, vector<Frame> replacements, const QString& description) {
+    int count = static_cast<int>(replacements.size());
+
+    if (count == 0 || first < 0 || first + count > static_cast<int>(frames.size())) {
+        qWarning() << "FrameManager::replaceFrames: frames" << first << "to" << first + count - 1 << "do not exist";
+        return false;
+    }
+
+    UndoStep step;
+    step.description = description;
+    step.frames.reserve(count);
+
+    // The replaced frames move into the step; nothing is copied
+    for (int i = 0; i < count; ++i) {
+        step.frames.emplace_back(frameIds[first + i], std::move(frames[first + i]));
+        frames[first + i] = std::move(replacements[i]);
+    }
+
+    pushUndoStep(std::move(step));
+    emit framesChanged(first, first + count - 1);
+    enforceMemoryBudget();
+    return true;
+}
+
+bool FrameManager::insertFrames(int position, vector<Frame> newFrames) {
+    for (const Frame& frame : newFrames) {
+        if (frame.getHeight() != height || frame.getWidth() != width) {
+            qWarning() << "FrameManager::insertFrames: frame is" << frame.getWidth() << "x" << frame.getHeight()
+                       << "but the sprite is" << width << "x" << height;
+            return false;
+        }
+    }
+
+    if (newFrames.empty()) {
+        return false;
+    }
+
+    // One insert moves the handles after the run once, however many frames there are
+    int count = static_cast<int>(newFrames.size());
+    position = std::clamp(position, 0, static_cast<int>(frames.size()));
+    emit framesAboutToBeInserted(position, position + count - 1);
+    frames.insert(frames.begin() + position, std::make_move_iterator(newFrames.begin()), std::make_move_iterator(newFrames.end()));
+
+    vector<FrameId> newIds(count);
+    std::iota(newIds.begin(), newIds.end(), nextFrameId);
+    nextFrameId += count;
+    frameIds.insert(frameIds.begin() + position, newIds.begin(), newIds.end());
+    durations.insert(durations.begin() + position, count, 0);
+    uncountedBytes += count * static_cast<qint64>(height) * width * static_cast<qint64>(sizeof(QRgb));
+    framesSinceCount += count;
+
+    emit framesInserted(position, position + count - 1);
+    emit frameAdded(frames.size());
+    enforceMemoryBudget();
+    return true;
+}
+
+bool FrameManager::resizeCanvas(int newHeight, int newWidth, SpriteResampler::Anchor anchor) {
+    return resizeFrames(newHeight, newWidth, [newHeight, newWidth, anchor](const Frame& frame) {
+        return SpriteResampler::resizeCanvas(frame, newHeight, newWidth, anchor);
+    });
+}
+
+bool FrameManager::scaleFrames(int newHeight, int newWidth, SpriteResampler::Method method) {
+    return resizeFrames(newHeight, newWidth, [newHeight, newWidth, method](const Frame& frame) {
+        return SpriteResampler::scale(frame, newHeight, newWidth, method);
+    });
+}
+
+bool FrameManager::canUndo() const {
+    return !undoSteps.empty();
+}
+
+bool FrameManager::canRedo() const {
+    return !redoSteps.empty();
+}
+
+QString FrameManager::undoText() const {
+    return undoSteps.empty() ? QString() : undoSteps.back().description;
+}
+
+QString FrameManager::redoText() const {
+    return redoSteps.empty() ? QString() : redoSteps.back().description;
+}
+
+void FrameManager::clearUndoHistory() {
+    undoSteps.clear();
+    redoSteps.clear();
+    openStep = UndoStep();
+    openStepDepth = 0;
+    emit undoHistoryChanged();
+}
+
+void FrameManager::undo() {
+    if (undoSteps.empty() || openStepDepth > 0) {
+        return;
+    }
+
+    UndoStep step = std::move(undoSteps.back());
+    undoSteps.pop_back();
+    swapStep(step);
+    redoSteps.push_back(std::move(step));
+    emit undoHistoryChanged();
+}
+
+void FrameManager::redo() {
+    if (redoSteps.empty() || openStepDepth > 0) {
+        return;
+    }
+
+    UndoStep step = std::move(redoSteps.back());
+    redoSteps.pop_back();
+    swapStep(step);
+    undoSteps.push_back(std::move(step));
+    emit undoHistoryChanged();
+}
+
+void FrameManager::insertFrameAt(int position, Frame frame, int duration) {
+    position = std::clamp(position, 0, static_cast<int>(frames.size()));
+    emit framesAboutToBeInserted(position, position);
+    frames.insert(frames.begin() + position, std::move(frame));
+    frameIds.insert(frameIds.begin() + position, nextFrameId++);
+    durations.insert(durations.begin() + position, duration);
+    uncountedBytes += static_cast<qint64>(frames[position].getHeight()) * frames[position].getWidth() * static_cast<qint64>(sizeof(QRgb));
+    framesSinceCount++;
+
+    emit framesInserted(position, position);
+    emit frameAdded(frames.size());
+}
+
+bool FrameManager::resizeFrames(int newHeight, int newWidth, const std::function<Frame(const Frame&)>& resize) {
+    if (newHeight <= 0 || newWidth <= 0) {
+        qWarning() << "FrameManager::resizeFrames: invalid size" << newWidth << "x" << newHeight;
+        return false;
+    }
+
+    if (openStepDepth > 0) {
+        qWarning() << "FrameManager::resizeFrames: cannot resize while an undo step is open";
+        return false;
+    }
+
+    // Holds and duplicated frames share a buffer, which is resized once and shared again afterwards
+    QHash<const void*, int> uniqueIndex;
+    vector<Frame> unique;
+    vector<int> order(frames.size());
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        auto found = uniqueIndex.constFind(frames[i].storageKey());
+
+        if (found == uniqueIndex.constEnd()) {
+            found = uniqueIndex.insert(frames[i].storageKey(), static_cast<int>(unique.size()));
+            unique.push_back(frames[i]);
+        }
+        order[i] = found.value();
+    }
+
+    vector<Frame> resized = QtConcurrent::blockingMapped<vector<Frame>>(unique, resize);
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        frames[i] = resized[order[i]];
+    }
+
+    height = newHeight;
+    width = newWidth;
+
+    // Every frame changed size, so earlier counts say nothing
+    countedBytes = -1;
+
+    // Every step holds frames of the old size, which could not be swapped back in
+    clearUndoHistory();
+
+    emit framesResized(height, width);
+
+    if (!frames.empty()) {
+        emit framesChanged(0, static_cast<int>(frames.size()) - 1);
+    }
+    enforceMemoryBudget();
+    return true;
+}
+
+void FrameManager::rememberFrame(int frameIndex) {
+    if (frameIndex < 0 || frameIndex >= static_cast<int>(frames.size())) {
+        return;
+    }
+
+    // Outside a group every change is a step of its own
+    if (openStepDepth == 0) {
+        UndoStep step;
+        step.description = "Edit";
+        step.frames.emplace_back(frameIds[frameIndex], frames[frameIndex]);
+        pushUndoStep(std::move(step));
+        return;
+    }
+
+    for (const std::pair<FrameId, Frame>& saved : openStep.frames) {
+        if (saved.first == frameIds[frameIndex]) {
+            return;
+        }
+    }
+    openStep.frames.emplace_back(frameIds[frameIndex], frames[frameIndex]);
+}
+
+void FrameManager::pushUndoStep(UndoStep step) {
+
+    // Each saved frame can become history of its own once its frame is edited
+    uncountedBytes += static_cast<qint64>(step.frames.size()) * height * width * static_cast<qint64>(sizeof(QRgb));
+    undoSteps.push_back(std::move(step));
+    redoSteps.clear();
+
+    if (static_cast<int>(undoSteps.size()) > maximumUndoSteps) {
+        undoSteps.erase(undoSteps.begin());
+    }
+    emit undoHistoryChanged();
+}
+
+void FrameManager::swapStep(UndoStep& step) {
+    int first = INT_MAX;
+    int last = -1;
+
+    // Frames are found by ID, so steps stay valid after frames were moved or inserted
+    for (std::pair<FrameId, Frame>& saved : step.frames) {
+        int frameIndex = indexOfFrame(saved.first);
+
+        if (frameIndex >= 0) {
+            std::swap(frames[frameIndex], saved.second);
+            first = std::min(first, frameIndex);
+            last = std::max(last, frameIndex);
+        }
+    }
+
+    if (last >= 0) {
+        emit framesChanged(first, last);
+    }
+}
@@ -0,0 +1,672 @@
+#ifndef FRAMEMANAGER_H
+#define FRAMEMANAGER_H
+
+/**
+ * @file framemanager.h
+ * @brief Declaration of the FrameManager class, which manages a collection of animation frames for a sprite.
+ * @date 03/31/2025
+ */
+
+#include "frame.h"
+#include "playbacktimeline.h"
+#include "spriteresampler.h"
+
+#include <QHash>
+#include <QObject>
+#include <QRegion>
+
+#include <functional>
+#include <utility>
+
+using std::vector;
+
+/**
+ * @struct MemoryUsage
+ *
+ * @brief Snapshot of the memory held by a project, as reported by FrameManager::memoryUsage().
+ *
+ * Buffers shared between several frames are counted once in sharedBytes, so totalBytes() is what the
+ * project actually holds rather than the sum of frameBytes.
+ */
+struct MemoryUsage {
+
+    /**
+     * @brief Bytes of pixel storage referenced by each frame, in frame order.
+     */
+    vector<qint64> frameBytes;
+
+    /**
+     * @brief Bytes of pixel buffers referenced by exactly one frame.
+     */
+    qint64 uniqueBytes = 0;
+
+    /**
+     * @brief Bytes of pixel buffers referenced by more than one frame, counted once per buffer.
+     */
+    qint64 sharedBytes = 0;
+
+    /**
+     * @brief Portion of uniqueBytes and sharedBytes held in compressed buffers.
+     */
+    qint64 compressedBytes = 0;
+
+    /**
+     * @brief Number of frames whose buffer is currently compressed.
+     */
+    int compressedFrames = 0;
+
+    /**
+     * @brief Bytes held by undo and redo history that no frame still shares.
+     */
+    qint64 undoBytes = 0;
+
+    /**
+     * @brief Bytes held by caches that reported their size through FrameManager::reportCacheUsage().
+     */
+    qint64 cacheBytes = 0;
+
+    /**
+     * @brief Returns everything the project holds.
+     * @return The sum of frame, undo and cache bytes.
+     */
+    qint64 totalBytes() const {
+        return uniqueBytes + sharedBytes + undoBytes + cacheBytes;
+    }
+
+};
+
+/**
+ * @class FrameManager
+ *
+ * @brief Manages a list of frames used in sprite animation.
+ *
+ * Responsible for creating, updating, duplicating, deleting, and rotating frames.
+ */
+class FrameManager : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructs a FrameManager instance with initial frame dimensions.
+     * @param height The height of each frame.
+     * @param width The width of each frame.
+     * @param parent Optional parent QObject.
+     */
+    explicit FrameManager(int height, int width, QObject* parent = nullptr);
+
+    /**
+     * @brief Identifies a frame for as long as it exists, wherever it moves in the list. Never reused.
+     */
+    using FrameId = quint32;
+
+    /**
+     * @brief The list of frames currently managed, in animation order.
+     *
+     * Each Frame is a handle to shared pixel storage, so inserting, deleting or moving entries only moves
+     * handles. Add and remove frames through the FrameManager so frameOrder() stays in step.
+     */
+    vector<Frame> frames;
+
+    /**
+     * @brief The height of each frame in pixels.
+     */
+    int height;
+
+    /**
+     * @brief The width of each frame in pixels.
+     */
+    int width;
+
+    /**
+     * @brief Returns the stable ID of the frame at a position.
+     * @param frameIndex The position in frames.
+     * @return The frame's ID, or 0 if there is no such frame.
+     */
+    FrameId frameId(int frameIndex) const;
+
+    /**
+     * @brief Finds the current position of a frame.
+     * @param id The frame's ID.
+     * @return The index into frames, or -1 if the frame was deleted.
+     */
+    int indexOfFrame(FrameId id) const;
+
+    /**
+     * @brief Returns the order table: the ID of each frame, in animation order.
+     * @return One ID per entry of frames.
+     */
+    const vector<FrameId>& frameOrder() const;
+
+    /**
+     * @brief Longest hold time a frame can be given, in milliseconds.
+     */
+    static constexpr int maximumFrameDuration = 60000;
+
+    /**
+     * @brief Returns how long a frame is shown during playback.
+     * @param frameIndex The position in frames.
+     * @return The duration in milliseconds, or 0 if the frame follows the playback speed or does not exist.
+     */
+    int frameDuration(int frameIndex) const;
+
+    /**
+     * @brief Returns the duration of each frame, in animation order.
+     * @return One duration in milliseconds per entry of frames; 0 follows the playback speed.
+     */
+    const vector<int>& frameDurations() const;
+
+    /**
+     * @brief Builds the playback timeline of the current frames.
+     * @param defaultDuration Duration in milliseconds of frames without their own, from the playback speed.
+     * @return The timeline.
+     */
+    PlaybackTimeline timeline(int defaultDuration) const;
+
+    /**
+     * @brief Removes every frame, for example before another sprite is loaded.
+     */
+    void clearFrames();
+
+    /**
+     * @brief Moves a run of frames to another position without touching their pixels.
+     *
+     * The arguments follow QAbstractItemModel::moveRows(), so a list view's rowsMoved() can be
+     * passed straight through. Undo history follows the frames by ID.
+     *
+     * @param first Index of the first frame to move.
+     * @param last Index of the last frame to move.
+     * @param destination Index, counted before the move, of the frame the run ends up in front of;
+     *        frames.size() moves it to the end.
+     * @return true if the frames moved; false if the run or destination is out of range.
+     */
+    bool moveFrames(int first, int last, int destination);
+
+    /**
+     * @brief Measures the memory currently held by frames, undo history and reported caches.
+     * @return A snapshot of the project's memory use.
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * @brief Returns the soft memory budget.
+     * @return The budget in bytes, or 0 if there is none.
+     */
+    qint64 memoryBudget() const;
+
+    /**
+     * @brief Sets the soft memory budget and enforces it right away.
+     * @param bytes The budget in bytes, or 0 to disable it.
+     */
+    void setMemoryBudget(qint64 bytes);
+
+    /**
+     * @brief Brings memory use back under the budget if it is exceeded.
+     *
+     * Caches are asked to shrink first through memoryBudgetExceeded(). If that is not enough, identical
+     * frames are made to share storage, then undo history and inactive frames are compressed, starting
+     * with the frames furthest from the active frame.
+     *
+     * Memory use is only counted in full when the growth added up since the last count could exceed the
+     * budget, or after as many adds as there are frames, so adding frames one at a time stays linear.
+     */
+    void enforceMemoryBudget();
+
+    /**
+     * @brief Groups frames with identical pixels.
+     *
+     * Frames sharing a buffer are grouped by their storage key alone. The rest are bucketed by
+     * Frame::contentHash() and only frames in the same bucket are compared. The frames are not changed.
+     *
+     * @param uniqueFrames Receives the index of the first frame of each distinct content, in frame order.
+     * @return For each frame, the position in uniqueFrames of the frame it is identical to.
+     */
+    vector<int> findDuplicateFrames(vector<int>& uniqueFrames) const;
+
+    /**
+     * @brief Makes frames with identical pixels share one pixel buffer.
+     *
+     * Holds and ping-pong loops then cost the memory of one frame each. A shared frame gets its own
+     * copy again the first time it is edited.
+     *
+     * @return The number of frames that were given another frame's buffer.
+     */
+    int deduplicateFrames();
+
+    /**
+     * @brief Most undo steps kept; the oldest is dropped when another is added.
+     */
+    static constexpr int maximumUndoSteps = 100;
+
+    /**
+     * @brief Starts grouping changes into one undo step, for example for a whole mouse stroke.
+     *
+     * Each frame changed before the matching endUndoStep() is remembered once, as it was before its first
+     * change. Remembering a frame is a shared copy, so only frames that really change cost memory.
+     * Calls may be nested; the outermost pair decides the step.
+     *
+     * @param description A short name for the step, such as "Draw".
+     */
+    void beginUndoStep(const QString& description);
+
+    /**
+     * @brief Closes the step opened by beginUndoStep() and adds it to the history if anything changed.
+     */
+    void endUndoStep();
+
+    /**
+     * @brief Replaces a run of frames at once, as a single undo step.
+     *
+     * framesChanged() is emitted once for the whole run.
+     *
+     * @param first Index of the first frame to replace.
+     * @param replacements The new frames, which must be the size of the frames they replace.
+     * @param description A short name for the undo step.
+     * @return true if the frames were replaced; false if the run does not fit the frame list.
+     */
+    bool replaceFrames(int first, vector<Frame> replacements, const QString& description);
+
+    /**
+     * @brief Inserts a run of frames at once, for example generated in-betweens.
+     *
+     * framesInserted() and frameAdded() are emitted once for the whole run, and the memory budget
+     * is enforced once afterwards.
+     *
+     * @param position Where the first frame goes; frames.size() appends the run.
+     * @param newFrames The frames to insert, which must be the size of the sprite.
+     * @return true if the frames were inserted; false if there are none or one has the wrong size.
+     */
+    bool insertFrames(int position, vector<Frame> newFrames);
+
+    /**
+     * @brief Changes the size of every frame's canvas without scaling the pixels.
+     *
+     * Frames are resized in parallel, and frames sharing a pixel buffer are resized once and keep sharing
+     * it. The undo history holds frames of the old size, so it is cleared.
+     *
+     * @param newHeight The new frame height.
+     * @param newWidth The new frame width.
+     * @param anchor The part of the old canvas that stays in place.
+     * @return true if the frames were resized; false if the size is invalid or an undo step is open.
+     */
+    bool resizeCanvas(int newHeight, int newWidth, SpriteResampler::Anchor anchor);
+
+    /**
+     * @brief Scales the pixels of every frame to a new size.
+     *
+     * Works like resizeCanvas(), with the pixels resampled instead of cropped or padded.
+     *
+     * @param newHeight The new frame height.
+     * @param newWidth The new frame width.
+     * @param method The resampling method.
+     * @return true if the frames were scaled; false if the size is invalid or an undo step is open.
+     */
+    bool scaleFrames(int newHeight, int newWidth, SpriteResampler::Method method);
+
+    /**
+     * @brief Checks whether there is a step to undo.
+     * @return true if undo() would change any frames.
+     */
+    bool canUndo() const;
+
+    /**
+     * @brief Checks whether there is a step to redo.
+     * @return true if redo() would change any frames.
+     */
+    bool canRedo() const;
+
+    /**
+     * @brief Returns the description of the step undo() would revert.
+     * @return The description, or an empty string if there is none.
+     */
+    QString undoText() const;
+
+    /**
+     * @brief Returns the description of the step redo() would reapply.
+     * @return The description, or an empty string if there is none.
+     */
+    QString redoText() const;
+
+    /**
+     * @brief Forgets all undo and redo steps, for example when another sprite is loaded.
+     */
+    void clearUndoHistory();
+
+public slots:
+
+    /**
+     * @brief Adds a new blank frame to the end of the list using the current width and height.
+     */
+    void addFrame();
+
+    /**
+     * @brief Adds a deserialized frame to the frame list (used during JSON loading).
+     * @param frame The frame to be added.
+     */
+    void addFrameJson(Frame frame);
+
+    /**
+     * @brief Inserts a new blank frame at a position.
+     * @param frameIndex Where the new frame goes; frames.size() appends it.
+     */
+    void insertFrame(int frameIndex);
+
+    /**
+     * @brief Deletes the frame at the given index if more than one frame exists.
+     * @param frameIndex The index of the frame to delete.
+     */
+    void deleteFrame(int frameIndex);
+
+    /**
+     * @brief Duplicates the frame at the given index and appends it to the list.
+     * @param frameIndex The index of the frame to copy.
+     */
+    void copyFrame(int frameIndex);
+
+    /**
+     * @brief Duplicates a frame into a position; the copy shares the original's pixels until either is edited.
+     * @param frameIndex The index of the frame to copy.
+     * @param position Where the copy goes; frames.size() appends it.
+     */
+    void copyFrameTo(int frameIndex, int position);
+
+    /**
+     * @brief Updates the pixel at (rowIndex, columnIndex) in a specified frame.
+     *
+     * The change is only recorded for undo inside a beginUndoStep() group.
+     *
+     * @param frameIndex Index of the frame to modify.
+     * @param rowIndex Y-coordinate of the pixel.
+     * @param columnIndex X-coordinate of the pixel.
+     * @param red Red value of the new color (0–255).
+     * @param green Green value of the new color (0–255).
+     * @param blue Blue value of the new color (0–255).
+     * @param alpha Alpha value of the new color (0–255).
+     */
+    void updateFrame(int frameIndex, int rowIndex, int columnIndex, int red, int green, int blue, int alpha);
+
+    /**
+     * @brief Copies an area of pixels from an image into a frame in one batch.
+     *
+     * Tools that change many pixels at once edit the canvas image and commit the changed area here,
+     * one row copy per scanline of each rectangle, instead of sending one updateFrame() per pixel.
+     * Outside a beginUndoStep() group, each call is its own undo step.
+     *
+     * @param frameIndex Index of the frame to modify.
+     * @param image An ARGB32 image the size of the frame holding the new pixels.
+     * @param region The area to copy, as one or more rectangles; it is clipped to the frame.
+     */
+    void updateFrameRegion(int frameIndex, const QImage& image, const QRegion& region);
+
+    /**
+     * @brief Returns all frames currently stored.
+     * @return A vector containing all Frame objects.
+     */
+    vector<Frame> sendFrames();
+
+    /**
+     * @brief Rotates the specified frame 90 degrees clockwise.
+     *
+     * The frame must be square (height == width).
+     *
+     * @param frameIndex The index of the frame to rotate.
+     */
+    void rotate90Clockwise(int frameIndex);
+
+    /**
+     * @brief Sets how long a frame is shown during playback.
+     * @param frameIndex The index of the frame.
+     * @param milliseconds The duration, up to maximumFrameDuration; 0 follows the playback speed.
+     */
+    void setFrameDuration(int frameIndex, int milliseconds);
+
+    /**
+     * @brief Marks the frame being edited, which is never compressed by the memory budget.
+     * @param frameIndex The index of the active frame.
+     */
+    void setActiveFrame(int frameIndex);
+
+    /**
+     * @brief Records how much memory a cache outside the model currently holds.
+     * @param cacheName A name identifying the cache.
+     * @param bytes The cache's current size in bytes.
+     */
+    void reportCacheUsage(const QString& cacheName, qint64 bytes);
+
+    /**
+     * @brief Restores the frames changed by the most recent undo step.
+     */
+    void undo();
+
+    /**
+     * @brief Reapplies the most recently undone step.
+     */
+    void redo();
+
+signals:
+
+    /**
+     * @brief Signal emitted when the manager changes a frame that should be shown, such as after a rotation.
+     * @param frame The changed frame.
+     */
+    void foundFrame(const Frame& frame);
+
+    /**
+     * @brief Signal emitted after one or more new frames have been added.
+     * @param framesCount The total number of frames after the addition.
+     */
+    void frameAdded(int framesCount);
+
+    /**
+     * @brief Signal emitted before a run of frames is inserted, while every existing frame is still in place.
+     * @param first The position the first new frame will have.
+     * @param last The position the last new frame will have.
+     */
+    void framesAboutToBeInserted(int first, int last);
+
+    /**
+     * @brief Signal emitted after a run of frames has been inserted, at the end or anywhere else.
+     *
+     * Emitted before frameAdded() for the same frames.
+     *
+     * @param first The position of the first new frame.
+     * @param last The position of the last new frame.
+     */
+    void framesInserted(int first, int last);
+
+    /**
+     * @brief Signal emitted before a frame is deleted, while it is still in the list.
+     * @param frameIndex The position of the frame.
+     */
+    void frameAboutToBeDeleted(int frameIndex);
+
+    /**
+     * @brief Signal emitted after a frame has been deleted.
+     * @param frameIndex The position the frame had.
+     * @param frameId The ID the frame had.
+     */
+    void frameDeleted(int frameIndex, FrameManager::FrameId frameId);
+
+    /**
+     * @brief Signal emitted before moveFrames() moves a run of frames, while every frame is still in place.
+     * @param first Index of the first frame to move.
+     * @param last Index of the last frame to move.
+     * @param destination The destination passed to moveFrames().
+     */
+    void framesAboutToBeMoved(int first, int last, int destination);
+
+    /**
+     * @brief Signal emitted after moveFrames() moved a run of frames.
+     * @param first Index, before the move, of the first moved frame.
+     * @param last Index, before the move, of the last moved frame.
+     * @param destination The destination passed to moveFrames().
+     */
+    void framesMoved(int first, int last, int destination);
+
+    /**
+     * @brief Signal emitted before clearFrames() removes every frame.
+     */
+    void framesAboutToBeCleared();
+
+    /**
+     * @brief Signal emitted after clearFrames() removed every frame.
+     */
+    void framesCleared();
+
+    /**
+     * @brief Signal emitted after setFrameDuration() changed a frame's duration.
+     * @param frameIndex The index of the frame.
+     */
+    void frameDurationChanged(int frameIndex);
+
+    /**
+     * @brief Signal emitted when memory use is over budget, before any frames are compressed.
+     *
+     * Caches should drop entries and report their new size through reportCacheUsage() from a direct
+     * connection.
+     *
+     * @param bytesOver How far memory use is over the budget.
+     */
+    void memoryBudgetExceeded(qint64 bytesOver);
+
+    /**
+     * @brief Signal emitted once after replaceFrames(), undo() or redo() changed a run of frames.
+     * @param first Index of the first changed frame.
+     * @param last Index of the last changed frame.
+     */
+    void framesChanged(int first, int last);
+
+    /**
+     * @brief Signal emitted after resizeCanvas() or scaleFrames() changed the size of the frames.
+     *
+     * Emitted before framesChanged() for all frames.
+     *
+     * @param height The new frame height.
+     * @param width The new frame width.
+     */
+    void framesResized(int height, int width);
+
+    /**
+     * @brief Signal emitted whenever steps are added to or removed from the undo or redo history.
+     */
+    void undoHistoryChanged();
+
+private:
+
+    /**
+     * @brief Frames as they were before one user action.
+     */
+    struct UndoStep {
+        QString description;
+        vector<std::pair<FrameId, Frame>> frames;
+    };
+
+    /**
+     * @brief Compresses caches, history and inactive frames until memory use fits the budget.
+     * @param total Memory use in bytes, just counted.
+     * @return Memory use in bytes afterwards.
+     */
+    qint64 reduceMemoryUse(qint64 total);
+
+    /**
+     * @brief Puts a frame into the list under a new ID.
+     * @param position Where the frame goes, clamped to the list.
+     * @param frame The frame to insert.
+     * @param duration The frame's duration in milliseconds; 0 follows the playback speed.
+     */
+    void insertFrameAt(int position, Frame frame, int duration = 0);
+
+    /**
+     * @brief Replaces every frame with a resized copy and adopts the new size.
+     * @param newHeight The new frame height.
+     * @param newWidth The new frame width.
+     * @param resize Makes the resized copy of one frame; called from worker threads.
+     * @return true if the frames were resized.
+     */
+    bool resizeFrames(int newHeight, int newWidth, const std::function<Frame(const Frame&)>& resize);
+
+    /**
+     * @brief Remembers a frame before it changes, in the open step or in a step of its own.
+     * @param frameIndex The index of the frame about to change.
+     */
+    void rememberFrame(int frameIndex);
+
+    /**
+     * @brief Adds a step to the undo history, dropping the redo history and the oldest step if needed.
+     * @param step The step to add.
+     */
+    void pushUndoStep(UndoStep step);
+
+    /**
+     * @brief Swaps the frames of a step with the current ones, so the step can be applied in reverse.
+     * @param step The step to apply.
+     */
+    void swapStep(UndoStep& step);
+
+    /**
+     * @brief Steps that undo() reverts, oldest first.
+     */
+    vector<UndoStep> undoSteps;
+
+    /**
+     * @brief Steps that redo() reapplies, most recently undone last.
+     */
+    vector<UndoStep> redoSteps;
+
+    /**
+     * @brief The step being grouped by beginUndoStep().
+     */
+    UndoStep openStep;
+
+    /**
+     * @brief How many beginUndoStep() calls are still open.
+     */
+    int openStepDepth = 0;
+
+    /**
+     * @brief Soft memory budget in bytes; 0 disables it.
+     */
+    qint64 budgetBytes = 512LL * 1024 * 1024;
+
+    /**
+     * @brief The ID of each entry of frames.
+     */
+    vector<FrameId> frameIds;
+
+    /**
+     * @brief The duration in milliseconds of each entry of frames; 0 follows the playback speed.
+     */
+    vector<int> durations;
+
+    /**
+     * @brief The ID the next new frame gets.
+     */
+    FrameId nextFrameId = 1;
+
+    /**
+     * @brief The frame being edited.
+     */
+    FrameId activeFrameId = 0;
+
+    /**
+     * @brief Last size reported by each cache.
+     */
+    QHash<QString, qint64> cacheUsage;
+
+    /**
+     * @brief Memory use in bytes at the last full count, or -1 if the next check must count again.
+     */
+    qint64 countedBytes = -1;
+
+    /**
+     * @brief Most the memory use can have grown, in bytes, since the last full count.
+     */
+    qint64 uncountedBytes = 0;
+
+    /**
+     * @brief Frames added since the last full count.
+     */
+    int framesSinceCount = 0;
+};
+
+#endif // FRAMEMANAGER_H
@@ -0,0 +1,566 @@
+/**
+ * @file gifexporter.cpp
+ * @brief Implementation of the GifExporter class for exporting frames as an animated GIF.
+ *
+ * Export runs in four passes: gather the colors of every frame, build one shared palette, map each
+ * frame to palette indices, then difference and LZW-encode each frame against the one before it.
+ * All passes except the final file write are parallel over frames.
+ *
+ * Palette index 0 is reserved for transparency; pixels with alpha below 128 map to it.
+ *
+ * @date 03/31/2025
+ */
+
+#include "gifexporter.h"
+
+#include <QtConcurrent>
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QRect>
+#include <QSet>
+#include <QDebug>
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+using std::max;
+using std::min;
+using std::sort;
+using std::vector;
+
+/**
+ * @brief Palette size available for colors once index 0 is taken by transparency.
+ */
+static const int maxPaletteColors = 255;
+
+/**
+ * @brief Number of bins in the 5-bit-per-channel color histogram.
+ */
+static const int histogramSize = 32 * 32 * 32;
+
+/**
+ * @brief 4x4 Bayer matrix used for ordered dithering.
+ */
+static const int bayerMatrix[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5}
+};
+
+/**
+ * @brief Colors found in one or more frames.
+ */
+struct ColorStats {
+    QSet<QRgb> exactColors;             // Distinct opaque colors, until there are too many
+    bool tooManyColors = false;         // Set once exactColors would exceed the palette
+    vector<quint32> histogram;          // Pixel counts per 5-bit-per-channel bin
+};
+
+/**
+ * @brief One frame after palette mapping and encoding.
+ */
+struct EncodedFrame {
+    int frameIndex = 0;
+    vector<uchar> indices;              // Palette index per pixel, full canvas size
+    bool startsFromClearCanvas = true;  // The previous frame is disposed to background before this one
+    int disposal = 1;                   // GIF disposal method: 1 keeps the frame, 2 clears it
+    QRect rect;                         // Region of the canvas stored in the file
+    QByteArray lzwData;                 // Compressed image data, already split into sub-blocks
+};
+
+static inline int histogramBin(QRgb color) {
+    return ((qRed(color) >> 3) << 10) | ((qGreen(color) >> 3) << 5) | (qBlue(color) >> 3);
+}
+
+static inline int expandFiveBits(int value) {
+    return (value << 3) | (value >> 2);
+}
+
+static ColorStats collectColors(const Frame& frame) {
+    ColorStats stats;
+    stats.histogram.assign(histogramSize, 0);
+
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        const QRgb* row = frame.constScanLine(y);
+
+        for (int x = 0; x < frame.getWidth(); ++x) {
+            if (qAlpha(row[x]) < 128) {
+                continue;
+            }
+
+            stats.histogram[histogramBin(row[x])]++;
+
+            if (!stats.tooManyColors) {
+                stats.exactColors.insert(row[x] | 0xff000000u);
+                stats.tooManyColors = stats.exactColors.size() > maxPaletteColors;
+            }
+        }
+    }
+    return stats;
+}
+
+static void mergeColors(ColorStats& result, const ColorStats& frameStats) {
+    if (result.histogram.empty()) {
+        result.histogram.assign(histogramSize, 0);
+    }
+
+    for (int i = 0; i < histogramSize; ++i) {
+        result.histogram[i] += frameStats.histogram[i];
+    }
+
+    if (!result.tooManyColors) {
+        result.tooManyColors = frameStats.tooManyColors;
+        result.exactColors.unite(frameStats.exactColors);
+        result.tooManyColors = result.tooManyColors || result.exactColors.size() > maxPaletteColors;
+    }
+}
+
+/**
+ * @brief Reduces a color histogram to at most maxPaletteColors colors with median cut.
+ *
+ * The most populated box is repeatedly split at the weighted median of its longest axis, and each
+ * final box contributes the weighted average of its colors.
+ */
+static vector<QRgb> medianCut(const vector<quint32>& histogram) {
+    struct Entry {
+        int channel[3];
+        quint32 count;
+    };
+
+    struct Box {
+        int begin;
+        int end;
+        quint64 population;
+    };
+
+    vector<Entry> entries;
+    for (int bin = 0; bin < histogramSize; ++bin) {
+        if (histogram[bin] > 0) {
+            entries.push_back({{(bin >> 10) & 31, (bin >> 5) & 31, bin & 31}, histogram[bin]});
+        }
+    }
+
+    vector<Box> boxes;
+    if (!entries.empty()) {
+        quint64 population = 0;
+        for (const Entry& entry : entries) {
+            population += entry.count;
+        }
+        boxes.push_back({0, static_cast<int>(entries.size()), population});
+    }
+
+    while (static_cast<int>(boxes.size()) < maxPaletteColors) {
+
+        // Pick the most populated box that still holds more than one color
+        int boxIndex = -1;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].end - boxes[i].begin > 1 && (boxIndex < 0 || boxes[i].population > boxes[boxIndex].population)) {
+                boxIndex = static_cast<int>(i);
+            }
+        }
+
+        if (boxIndex < 0) {
+            break;
+        }
+
+        Box box = boxes[boxIndex];
+
+        // Find the longest axis of the box
+        int axis = 0;
+        int longestRange = -1;
+        for (int c = 0; c < 3; ++c) {
+            int low = 31;
+            int high = 0;
+            for (int i = box.begin; i < box.end; ++i) {
+                low = min(low, entries[i].channel[c]);
+                high = max(high, entries[i].channel[c]);
+            }
+
+            if (high - low > longestRange) {
+                longestRange = high - low;
+                axis = c;
+            }
+        }
+
+        sort(entries.begin() + box.begin, entries.begin() + box.end, [axis](const Entry& a, const Entry& b) {
+            return a.channel[axis] < b.channel[axis];
+        });
+
+        // Split where the running count passes half of the population, keeping both halves non-empty
+        quint64 running = 0;
+        int split = box.begin + 1;
+        for (int i = box.begin; i < box.end - 1; ++i) {
+            running += entries[i].count;
+            split = i + 1;
+
+            if (running * 2 >= box.population) {
+                break;
+            }
+        }
+
+        quint64 lowerPopulation = 0;
+        for (int i = box.begin; i < split; ++i) {
+            lowerPopulation += entries[i].count;
+        }
+
+        boxes[boxIndex] = {box.begin, split, lowerPopulation};
+        boxes.push_back({split, box.end, box.population - lowerPopulation});
+    }
+
+    vector<QRgb> palette;
+    for (const Box& box : boxes) {
+        quint64 sums[3] = {0, 0, 0};
+
+        for (int i = box.begin; i < box.end; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                sums[c] += static_cast<quint64>(expandFiveBits(entries[i].channel[c])) * entries[i].count;
+            }
+        }
+
+        palette.push_back(qRgb(static_cast<int>(sums[0] / box.population),
+                               static_cast<int>(sums[1] / box.population),
+                               static_cast<int>(sums[2] / box.population)));
+    }
+    return palette;
+}
+
+/**
+ * @brief Compresses palette indices with GIF-flavoured variable-width LZW.
+ *
+ * Codes are packed least-significant bit first and the output is split into sub-blocks of at most
+ * 255 bytes, ready to be written after the minimum code size byte.
+ */
+static QByteArray lzwEncode(const vector<uchar>& indices, int minimumCodeSize) {
+    const int clearCode = 1 << minimumCodeSize;
+    const int endCode = clearCode + 1;
+    const int maxCodes = 4096;
+    const int tableSize = 8191;
+
+    // Open-addressed dictionary mapping (prefix code, next index) to a code
+    vector<int> tableKeys(tableSize, -1);
+    vector<short> tableCodes(tableSize, 0);
+
+    QByteArray packed;
+    quint32 bitBuffer = 0;
+    int bitCount = 0;
+    int codeSize = minimumCodeSize + 1;
+    int nextCode = endCode + 1;
+
+    auto writeCode = [&](int code) {
+        bitBuffer |= static_cast<quint32>(code) << bitCount;
+        bitCount += codeSize;
+
+        while (bitCount >= 8) {
+            packed.append(static_cast<char>(bitBuffer & 0xff));
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+    };
+
+    auto resetDictionary = [&]() {
+        std::fill(tableKeys.begin(), tableKeys.end(), -1);
+        codeSize = minimumCodeSize + 1;
+        nextCode = endCode + 1;
+    };
+
+    writeCode(clearCode);
+
+    if (!indices.empty()) {
+        int prefix = indices[0];
+
+        for (size_t i = 1; i < indices.size(); ++i) {
+            int key = (prefix << 8) | indices[i];
+            int slot = key % tableSize;
+
+            while (tableKeys[slot] != -1 && tableKeys[slot] != key) {
+                slot = (slot + 1) % tableSize;
+            }
+
+            if (tableKeys[slot] == key) {
+                prefix = tableCodes[slot];
+                continue;
+            }
+
+            writeCode(prefix);
+
+            if (nextCode < maxCodes) {
+                if (nextCode == (1 << codeSize)) {
+                    codeSize++;
+                }
+                tableKeys[slot] = key;
+                tableCodes[slot] = static_cast<short>(nextCode++);
+            }
+
+            else {
+                writeCode(clearCode);
+                resetDictionary();
+            }
+
+            prefix = indices[i];
+        }
+
+        writeCode(prefix);
+    }
+
+    writeCode(endCode);
+
+    if (bitCount > 0) {
+        packed.append(static_cast<char>(bitBuffer & 0xff));
+    }
+
+    QByteArray blocks;
+    blocks.reserve(packed.size() + packed.size() / 255 + 2);
+
+    for (qsizetype offset = 0; offset < packed.size(); offset += 255) {
+        qsizetype length = min<qsizetype>(255, packed.size() - offset);
+        blocks.append(static_cast<char>(length));
+        blocks.append(packed.constData() + offset, length);
+    }
+    blocks.append('\0');
+    return blocks;
+}
+
+static void appendShort(QByteArray& out, int value) {
+    out.append(static_cast<char>(value & 0xff));
+    out.append(static_cast<char>((value >> 8) & 0xff));
+}
+
+GifExporter::GifExporter(QObject* parent) : QObject{parent} {}
+
+bool GifExporter::exportToFile(FrameManager& manager, QString filePath, int framesPerSecond, bool dither) {
+    const vector<Frame>& frames = manager.frames;
+
+    if (frames.empty()) {
+        qWarning() << "No frames to export.";
+        return false;
+    }
+
+    int width = manager.width;
+    int height = manager.height;
+    size_t pixelCount = static_cast<size_t>(width) * height;
+
+    // Pass 1: gather the colors of every frame
+    ColorStats colors = QtConcurrent::blockingMappedReduced<ColorStats>(frames, collectColors, mergeColors);
+
+    // Pass 2: build the shared palette and a way to look colors up in it
+    vector<QRgb> palette;
+    QHash<QRgb, uchar> exactLookup;
+    vector<uchar> binLookup;
+    bool exactPalette = !colors.tooManyColors;
+
+    if (exactPalette) {
+        palette = vector<QRgb>(colors.exactColors.begin(), colors.exactColors.end());
+        sort(palette.begin(), palette.end());
+
+        for (size_t i = 0; i < palette.size(); ++i) {
+            exactLookup.insert(palette[i], static_cast<uchar>(i + 1));
+        }
+    }
+
+    else {
+        palette = medianCut(colors.histogram);
+        binLookup.assign(histogramSize, 1);
+
+        // Nearest palette entry for every histogram bin, one red level per task
+        vector<int> redLevels(32);
+        std::iota(redLevels.begin(), redLevels.end(), 0);
+
+        QtConcurrent::blockingMap(redLevels, [&palette, &binLookup](int& red) {
+            for (int bin = red << 10; bin < (red + 1) << 10; ++bin) {
+                int r = expandFiveBits((bin >> 10) & 31);
+                int g = expandFiveBits((bin >> 5) & 31);
+                int b = expandFiveBits(bin & 31);
+                int bestDistance = INT_MAX;
+
+                for (size_t i = 0; i < palette.size(); ++i) {
+                    int dr = r - qRed(palette[i]);
+                    int dg = g - qGreen(palette[i]);
+                    int db = b - qBlue(palette[i]);
+                    int distance = dr * dr + dg * dg + db * db;
+
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        binLookup[bin] = static_cast<uchar>(i + 1);
+                    }
+                }
+            }
+        });
+    }
+
+    // Pass 3: map every frame to palette indices
+    vector<EncodedFrame> encoded(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        encoded[i].frameIndex = static_cast<int>(i);
+    }
+
+    bool applyDither = dither && !exactPalette;
+
+    QtConcurrent::blockingMap(encoded, [&](EncodedFrame& entry) {
+        const Frame& frame = frames[entry.frameIndex];
+        entry.indices.assign(pixelCount, 0);
+
+        for (int y = 0; y < height; ++y) {
+            const QRgb* row = frame.constScanLine(y);
+            uchar* out = entry.indices.data() + static_cast<size_t>(y) * width;
+
+            for (int x = 0; x < width; ++x) {
+                QRgb color = row[x];
+
+                if (qAlpha(color) < 128) {
+                    continue;
+                }
+
+                if (exactPalette) {
+                    out[x] = exactLookup.value(color | 0xff000000u);
+                }
+
+                else if (applyDither) {
+
+                    // Offset by up to about half a quantization step before binning
+                    int offset = bayerMatrix[y & 3][x & 3] - 8;
+                    int r = qBound(0, qRed(color) + offset, 255);
+                    int g = qBound(0, qGreen(color) + offset, 255);
+                    int b = qBound(0, qBlue(color) + offset, 255);
+                    out[x] = binLookup[histogramBin(qRgb(r, g, b))];
+                }
+
+                else {
+                    out[x] = binLookup[histogramBin(color)];
+                }
+            }
+        }
+    });
+
+    // A frame must start from a clear canvas if it turns any previously drawn pixel transparent.
+    // The first frame always does, since it follows the last one when the animation loops.
+    QtConcurrent::blockingMap(encoded, [&encoded, pixelCount](EncodedFrame& entry) {
+        if (entry.frameIndex == 0) {
+            entry.startsFromClearCanvas = true;
+            return;
+        }
+
+        const vector<uchar>& previous = encoded[entry.frameIndex - 1].indices;
+        entry.startsFromClearCanvas = false;
+
+        for (size_t i = 0; i < pixelCount; ++i) {
+            if (previous[i] != 0 && entry.indices[i] == 0) {
+                entry.startsFromClearCanvas = true;
+                break;
+            }
+        }
+    });
+
+    // Pass 4: difference against the previous frame, crop and compress
+    QtConcurrent::blockingMap(encoded, [&encoded, width, height](EncodedFrame& entry) {
+        size_t next = (static_cast<size_t>(entry.frameIndex) + 1) % encoded.size();
+        entry.disposal = encoded[next].startsFromClearCanvas ? 2 : 1;
+
+        vector<uchar> pixels = entry.indices;
+
+        // Pixels that already show the right color become transparent
+        if (!entry.startsFromClearCanvas) {
+            const vector<uchar>& previous = encoded[entry.frameIndex - 1].indices;
+
+            for (size_t i = 0; i < pixels.size(); ++i) {
+                if (pixels[i] == previous[i]) {
+                    pixels[i] = 0;
+                }
+            }
+        }
+
+        // Disposing to background only clears this frame's rectangle, so such frames cover the canvas
+        if (entry.disposal == 2) {
+            entry.rect = QRect(0, 0, width, height);
+        }
+
+        else {
+            int left = width;
+            int right = -1;
+            int top = height;
+            int bottom = -1;
+
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    if (pixels[static_cast<size_t>(y) * width + x] != 0) {
+                        left = min(left, x);
+                        right = max(right, x);
+                        top = min(top, y);
+                        bottom = max(bottom, y);
+                    }
+                }
+            }
+
+            entry.rect = (right < 0) ? QRect(0, 0, 1, 1) : QRect(QPoint(left, top), QPoint(right, bottom));
+        }
+
+        vector<uchar> cropped;
+        cropped.reserve(static_cast<size_t>(entry.rect.width()) * entry.rect.height());
+
+        for (int y = entry.rect.top(); y <= entry.rect.bottom(); ++y) {
+            const uchar* row = pixels.data() + static_cast<size_t>(y) * width;
+            cropped.insert(cropped.end(), row + entry.rect.left(), row + entry.rect.right() + 1);
+        }
+
+        entry.lzwData = lzwEncode(cropped, 8);
+    });
+
+    // Header, logical screen descriptor and the 256-entry global color table
+    QByteArray out("GIF89a");
+    appendShort(out, width);
+    appendShort(out, height);
+    out.append(static_cast<char>(0xf7));    // Global table, 8-bit color resolution, 256 entries
+    out.append('\0');                       // Background color index
+    out.append('\0');                       // Pixel aspect ratio
+
+    for (int i = 0; i < 256; ++i) {
+        QRgb color = (i >= 1 && i <= static_cast<int>(palette.size())) ? palette[i - 1] : qRgb(0, 0, 0);
+        out.append(static_cast<char>(qRed(color)));
+        out.append(static_cast<char>(qGreen(color)));
+        out.append(static_cast<char>(qBlue(color)));
+    }
+
+    // Loop forever
+    out.append("\x21\xff\x0bNETSCAPE2.0\x03\x01", 16);
+    appendShort(out, 0);
+    out.append('\0');
+
+    // Delays are rounded at each frame's end on the timeline, so rounding to 1/100 s never adds up
+    PlaybackTimeline timeline = manager.timeline(qRound(1000.0 / max(1, framesPerSecond)));
+
+    for (const EncodedFrame& entry : encoded) {
+        int delay = qRound(timeline.frameEnd(entry.frameIndex) / 10.0) - qRound(timeline.frameStart(entry.frameIndex) / 10.0);
+
+        // Graphic control extension: disposal, delay and transparent index 0
+        out.append("\x21\xf9\x04", 3);
+        out.append(static_cast<char>((entry.disposal << 2) | 0x01));
+        appendShort(out, delay);
+        out.append('\0');
+        out.append('\0');
+
+        // Image descriptor without a local color table
+        out.append(',');
+        appendShort(out, entry.rect.left());
+        appendShort(out, entry.rect.top());
+        appendShort(out, entry.rect.width());
+        appendShort(out, entry.rect.height());
+        out.append('\0');
+
+        out.append(static_cast<char>(8));   // LZW minimum code size
+        out.append(entry.lzwData);
+    }
+
+    out.append(';');
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open file for writing:" << filePath;
+        return false;
+    }
+
+    file.write(out);
+    file.close();
+    return true;
+}
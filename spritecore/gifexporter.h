@@ -0,0 +1,53 @@
+#ifndef GIFEXPORTER_H
+#define GIFEXPORTER_H
+
+/**
+ * @file gifexporter.h
+ * @brief Declaration of the GifExporter class, which writes all frames as a looping animated GIF.
+ *
+ * Frames share one global palette built from the colors of every frame. Sprites with at most 255
+ * distinct colors keep their exact colors; larger palettes are reduced with median cut and can be
+ * ordered-dithered. Each frame after the first only stores the pixels that changed, and the image
+ * data is compressed with a built-in LZW encoder.
+ *
+ * @date 03/31/2025
+ */
+
+#include "framemanager.h"
+
+#include <QObject>
+#include <QString>
+
+/**
+ * @class GifExporter
+ *
+ * @brief Exports the frames of a FrameManager as an animated GIF file.
+ */
+class GifExporter : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructs a GifExporter instance.
+     * @param parent Optional parent QObject.
+     */
+    explicit GifExporter(QObject* parent = nullptr);
+
+    /**
+     * @brief Writes every frame in the FrameManager to an animated GIF.
+     *
+     * Palette mapping, frame differencing and LZW compression run per frame on the global thread pool;
+     * only the final write to disk is sequential.
+     *
+     * @param manager Reference to the FrameManager containing the frames to export.
+     * @param filePath Target path of the .gif file.
+     * @param framesPerSecond Playback speed; frames without their own duration are shown for 1/framesPerSecond seconds.
+     * @param dither Whether to apply 4x4 ordered dithering when the palette had to be reduced.
+     * @return true if the file was written successfully; false otherwise.
+     */
+    bool exportToFile(FrameManager& manager, QString filePath, int framesPerSecond, bool dither = false);
+
+};
+
+#endif // GIFEXPORTER_H
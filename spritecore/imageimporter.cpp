@@ -0,0 +1,272 @@
+/**
+ * @file imageimporter.cpp
+ * @brief Implementation of the ImageImporter class for importing images and sprite sheets as frames.
+ * @date 03/31/2025
+ */
+
+#include "imageimporter.h"
+
+#include <QtConcurrent>
+#include <QAtomicInt>
+#include <QImageReader>
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+
+using std::max;
+using std::min;
+using std::vector;
+
+/**
+ * @brief Number of image rows scanned by one task when looking for gutters.
+ */
+static const int gutterBandHeight = 64;
+
+/**
+ * @brief Rows of a sheet scanned by one task, with the alpha bits found in each row and column.
+ */
+struct GutterBand {
+    int top = 0;
+    int bottom = 0;
+    vector<QRgb> rowBits;       // OR of every pixel in each row of the band
+    vector<QRgb> columnBits;    // OR of every pixel in each column, restricted to the band
+};
+
+/**
+ * @brief Decodes an image file and converts it to ARGB32.
+ */
+static QImage readImage(const QString& filePath) {
+    QImageReader reader(filePath);
+    QImage image = reader.read();
+
+    if (image.isNull()) {
+        qWarning() << "Failed to read image:" << filePath << reader.errorString();
+        return image;
+    }
+    return image.convertToFormat(QImage::Format_ARGB32);
+}
+
+/**
+ * @brief Copies one cell of a sheet into a new frame, centering it if the frame is larger.
+ */
+static Frame sliceCell(const QImage& sheet, const QRect& cell, int frameWidth, int frameHeight) {
+    Frame frame(frameHeight, frameWidth);
+    QRect source = cell.intersected(sheet.rect());
+    int offsetX = (frameWidth - cell.width()) / 2;
+    int offsetY = (frameHeight - cell.height()) / 2;
+    size_t rowBytes = static_cast<size_t>(source.width()) * sizeof(QRgb);
+
+    for (int y = source.top(); y <= source.bottom(); ++y) {
+        const QRgb* row = reinterpret_cast<const QRgb*>(sheet.constScanLine(y)) + source.left();
+        memcpy(frame.scanLine(y - cell.top() + offsetY) + (source.left() - cell.left()) + offsetX, row, rowBytes);
+    }
+    return frame;
+}
+
+/**
+ * @brief Splits a list of per-line "has content" flags into runs of consecutive content lines.
+ */
+static vector<std::pair<int, int>> contentRuns(const vector<QRgb>& bits) {
+    vector<std::pair<int, int>> runs;
+    int start = -1;
+
+    for (int i = 0; i <= static_cast<int>(bits.size()); ++i) {
+        bool hasContent = i < static_cast<int>(bits.size()) && (bits[i] & 0xff000000u) != 0;
+
+        if (hasContent && start < 0) {
+            start = i;
+        }
+
+        else if (!hasContent && start >= 0) {
+            runs.push_back({start, i - start});
+            start = -1;
+        }
+    }
+    return runs;
+}
+
+/**
+ * @brief Returns true if every pixel of the frame has zero alpha.
+ */
+static bool isTransparent(const Frame& frame) {
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        const QRgb* row = frame.constScanLine(y);
+        QRgb bits = 0;
+
+        for (int x = 0; x < frame.getWidth(); ++x) {
+            bits |= row[x];
+        }
+
+        if ((bits & 0xff000000u) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ImageImporter::ImageImporter(QObject* parent) : QObject{parent} {}
+
+vector<QRect> ImageImporter::detectCells(const QImage& sheet) {
+    int width = sheet.width();
+    int height = sheet.height();
+
+    vector<GutterBand> bands;
+    for (int top = 0; top < height; top += gutterBandHeight) {
+        GutterBand band;
+        band.top = top;
+        band.bottom = min(height, top + gutterBandHeight);
+        bands.push_back(band);
+    }
+
+    QtConcurrent::blockingMap(bands, [&sheet, width](GutterBand& band) {
+        band.rowBits.assign(band.bottom - band.top, 0);
+        band.columnBits.assign(width, 0);
+
+        for (int y = band.top; y < band.bottom; ++y) {
+            const QRgb* row = reinterpret_cast<const QRgb*>(sheet.constScanLine(y));
+            QRgb rowBits = 0;
+
+            for (int x = 0; x < width; ++x) {
+                rowBits |= row[x];
+                band.columnBits[x] |= row[x];
+            }
+            band.rowBits[y - band.top] = rowBits;
+        }
+    });
+
+    vector<QRgb> rowBits;
+    vector<QRgb> columnBits(width, 0);
+
+    for (const GutterBand& band : bands) {
+        rowBits.insert(rowBits.end(), band.rowBits.begin(), band.rowBits.end());
+
+        for (int x = 0; x < width; ++x) {
+            columnBits[x] |= band.columnBits[x];
+        }
+    }
+
+    vector<QRect> cells;
+    for (const auto& rowRun : contentRuns(rowBits)) {
+        for (const auto& columnRun : contentRuns(columnBits)) {
+            QRect cell(columnRun.first, rowRun.first, columnRun.second, rowRun.second);
+
+            // Skip cells with nothing in them, e.g. the empty end of the last row of a sheet
+            bool hasContent = false;
+            for (int y = cell.top(); y <= cell.bottom() && !hasContent; ++y) {
+                const QRgb* row = reinterpret_cast<const QRgb*>(sheet.constScanLine(y));
+
+                for (int x = cell.left(); x <= cell.right(); ++x) {
+                    if (qAlpha(row[x]) != 0) {
+                        hasContent = true;
+                        break;
+                    }
+                }
+            }
+
+            if (hasContent) {
+                cells.push_back(cell);
+            }
+        }
+    }
+    return cells;
+}
+
+bool ImageImporter::importSheet(QString filePath, SliceMode mode, int cellWidth, int cellHeight, vector<Frame>& frames) {
+    frames.clear();
+    emit progressChanged(0, 1);
+
+    QImage sheet = readImage(filePath);
+    if (sheet.isNull()) {
+        return false;
+    }
+
+    vector<QRect> cells;
+    int frameWidth = sheet.width();
+    int frameHeight = sheet.height();
+
+    if (mode == Grid) {
+        if (cellWidth <= 0 || cellHeight <= 0) {
+            qWarning() << "Invalid grid cell size:" << cellWidth << "x" << cellHeight;
+            return false;
+        }
+
+        frameWidth = cellWidth;
+        frameHeight = cellHeight;
+
+        for (int y = 0; y + cellHeight <= sheet.height(); y += cellHeight) {
+            for (int x = 0; x + cellWidth <= sheet.width(); x += cellWidth) {
+                cells.push_back(QRect(x, y, cellWidth, cellHeight));
+            }
+        }
+    }
+
+    else if (mode == Gutters) {
+        cells = detectCells(sheet);
+        frameWidth = 0;
+        frameHeight = 0;
+
+        for (const QRect& cell : cells) {
+            frameWidth = max(frameWidth, cell.width());
+            frameHeight = max(frameHeight, cell.height());
+        }
+    }
+
+    else {
+        cells.push_back(sheet.rect());
+    }
+
+    if (cells.empty()) {
+        qWarning() << "No frames found in image:" << filePath;
+        return false;
+    }
+
+    // Slice every cell on the thread pool, reporting each finished cell
+    int total = static_cast<int>(cells.size());
+    QAtomicInt completed = 0;
+    emit progressChanged(0, total);
+
+    frames = QtConcurrent::blockingMapped<vector<Frame>>(cells, [&, this](const QRect& cell) {
+        Frame frame = sliceCell(sheet, cell, frameWidth, frameHeight);
+        emit progressChanged(completed.fetchAndAddRelaxed(1) + 1, total);
+        return frame;
+    });
+
+    // Grid slicing keeps transparent cells so frame positions match the sheet; drop the trailing ones
+    if (mode == Grid) {
+        while (frames.size() > 1 && isTransparent(frames.back())) {
+            frames.pop_back();
+        }
+    }
+    return true;
+}
+
+bool ImageImporter::importImages(QStringList filePaths, vector<Frame>& frames) {
+    frames.clear();
+
+    if (filePaths.isEmpty()) {
+        return false;
+    }
+
+    int total = static_cast<int>(filePaths.size());
+    QAtomicInt completed = 0;
+    emit progressChanged(0, total);
+
+    vector<QImage> images = QtConcurrent::blockingMapped<vector<QImage>>(filePaths, [&, this](const QString& filePath) {
+        QImage image = readImage(filePath);
+        emit progressChanged(completed.fetchAndAddRelaxed(1) + 1, total);
+        return image;
+    });
+
+    for (const QImage& image : images) {
+        if (image.isNull() || image.size() != images.front().size()) {
+            qWarning() << "All imported images must be valid and the same size.";
+            return false;
+        }
+    }
+
+    for (const QImage& image : images) {
+        frames.emplace_back(image);
+    }
+    return true;
+}
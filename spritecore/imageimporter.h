@@ -0,0 +1,100 @@
+#ifndef IMAGEIMPORTER_H
+#define IMAGEIMPORTER_H
+
+/**
+ * @file imageimporter.h
+ * @brief Declaration of the ImageImporter class, which turns PNG images and sprite sheets into frames.
+ *
+ * A sheet can be kept as a single frame, sliced on a fixed grid, or sliced along fully transparent
+ * rows and columns ("gutters") found automatically. Pixels are copied into frames a scanline at a time.
+ *
+ * @date 03/31/2025
+ */
+
+#include "frame.h"
+
+#include <QImage>
+#include <QObject>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+
+using std::vector;
+
+/**
+ * @class ImageImporter
+ *
+ * @brief Decodes images and slices them into equally sized frames.
+ *
+ * Import methods are synchronous and safe to call from a worker thread; progressChanged is emitted
+ * from whichever thread does the work, so GUI receivers get it through a queued connection.
+ */
+class ImageImporter : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief How a sprite sheet is divided into frames.
+     */
+    enum SliceMode {
+        SingleFrame,    ///< The whole image becomes one frame
+        Grid,           ///< Fixed-size cells, read left to right, top to bottom
+        Gutters         ///< Cells separated by fully transparent rows and columns
+    };
+
+    /**
+     * @brief Constructs an ImageImporter instance.
+     * @param parent Optional parent QObject.
+     */
+    explicit ImageImporter(QObject* parent = nullptr);
+
+    /**
+     * @brief Decodes a sprite sheet and slices it into frames.
+     *
+     * Cells are sliced in parallel. With Gutters, every frame takes the size of the largest cell,
+     * smaller cells are centered in it and fully transparent cells are skipped. With Grid, transparent
+     * cells at the end of the sheet are dropped.
+     *
+     * @param filePath Path of the image to import.
+     * @param mode How to divide the image into frames.
+     * @param cellWidth Cell width in pixels (Grid mode only).
+     * @param cellHeight Cell height in pixels (Grid mode only).
+     * @param frames Receives the imported frames.
+     * @return true if the image was decoded and produced at least one frame; false otherwise.
+     */
+    bool importSheet(QString filePath, SliceMode mode, int cellWidth, int cellHeight, vector<Frame>& frames);
+
+    /**
+     * @brief Decodes several images in parallel, one frame per image.
+     *
+     * All images must have the same size.
+     *
+     * @param filePaths Paths of the images to import, in frame order.
+     * @param frames Receives the imported frames.
+     * @return true if every image was decoded and all sizes match; false otherwise.
+     */
+    bool importImages(QStringList filePaths, vector<Frame>& frames);
+
+    /**
+     * @brief Finds the cells of a sheet laid out with fully transparent gutters.
+     *
+     * Rows and columns are scanned in parallel bands. Cells are returned left to right, top to bottom.
+     *
+     * @param sheet The image to scan, in ARGB32 format.
+     * @return The bounding rectangle of every non-empty cell.
+     */
+    static vector<QRect> detectCells(const QImage& sheet);
+
+signals:
+
+    /**
+     * @brief Emitted as work completes.
+     * @param completed Number of finished steps.
+     * @param total Total number of steps.
+     */
+    void progressChanged(int completed, int total);
+
+};
+
+#endif // IMAGEIMPORTER_H
@@ -0,0 +1,59 @@
+/**
+ * @file inbetweengenerator.cpp
+ * @brief Implementation of the InbetweenGenerator class.
+ * @date 03/31/2025
+ */
+
+#include "inbetweengenerator.h"
+#include "pixelblend.h"
+#include "spriteresampler.h"
+
+#include <QtConcurrent>
+#include <QtDebug>
+
+#include <numeric>
+
+Frame InbetweenGenerator::generate(const Frame& first, const Frame& second, int step, int count, Mode mode, QPoint offset) {
+    const int height = first.getHeight();
+    const int width = first.getWidth();
+
+    if (mode == Translate) {
+
+        // Each in-between moves its share of the way, so the second key frame would sit at the full offset
+        QPoint shift(qRound(double(offset.x()) * step / (count + 1)), qRound(double(offset.y()) * step / (count + 1)));
+        return SpriteResampler::translate(first, shift);
+    }
+
+    // Weights run from 0 for the first key frame to 256 for the second
+    const int weight = qRound(256.0 * step / (count + 1));
+    Frame result = Frame::allocate(height, width);
+
+    // Frames are one packed buffer, so cross-fades run as a single span; dithering needs each row's position
+    if (mode == CrossFade) {
+        PixelBlend::interpolateSpan(result.scanLine(0), first.constScanLine(0), second.constScanLine(0), height * width, weight);
+        return result;
+    }
+
+    for (int y = 0; y < height; ++y) {
+        PixelBlend::ditherSpan(result.scanLine(y), first.constScanLine(y), second.constScanLine(y), width, weight, 0, y);
+    }
+    return result;
+}
+
+vector<Frame> InbetweenGenerator::generate(const Frame& first, const Frame& second, int count, Mode mode, QPoint offset) {
+    if (first.getHeight() != second.getHeight() || first.getWidth() != second.getWidth()) {
+        qWarning() << "InbetweenGenerator::generate: the key frames differ in size";
+        return vector<Frame>();
+    }
+
+    if (count <= 0) {
+        return vector<Frame>();
+    }
+
+    vector<int> steps(count);
+    std::iota(steps.begin(), steps.end(), 1);
+
+    return QtConcurrent::blockingMapped<vector<Frame>>(steps, [&](int step) {
+        return generate(first, second, step, count, mode, offset);
+    });
+}
@@ -0,0 +1,63 @@
+#ifndef INBETWEENGENERATOR_H
+#define INBETWEENGENERATOR_H
+
+/**
+ * @file inbetweengenerator.h
+ * @brief Declares the InbetweenGenerator class, which makes the frames between two key frames.
+ * @date 03/31/2025
+ */
+
+#include "frame.h"
+
+#include <QPoint>
+
+using std::vector;
+
+/**
+ * @class InbetweenGenerator
+ *
+ * @brief Generates in-between frames for simple motion between two key frames of the same size.
+ *
+ * In-between k of n sits k / (n + 1) of the way from the first key frame to the second. Cross-fades
+ * and dithers run a row at a time through PixelBlend's vector kernels, and the frames of one request
+ * are generated in parallel.
+ */
+class InbetweenGenerator {
+
+public:
+
+    /**
+     * @brief How the in-betweens get from the first key frame to the second.
+     */
+    enum Mode {
+        CrossFade,  ///< Mix the two key frames, premultiplied, so transparent areas fade cleanly.
+        Dither,     ///< Pick each pixel from one key frame or the other with an ordered dither; no new colors.
+        Translate   ///< Slide the first key frame by a growing share of an offset; the second is not used.
+    };
+
+    /**
+     * @brief Generates one in-between frame.
+     * @param first The first key frame.
+     * @param second The second key frame, the size of the first.
+     * @param step Which in-between to make, from 1 to count.
+     * @param count How many in-betweens there are in all.
+     * @param mode How to get from one key frame to the other.
+     * @param offset For Translate, how far the first key frame has moved by the second.
+     * @return The in-between frame.
+     */
+    static Frame generate(const Frame& first, const Frame& second, int step, int count, Mode mode, QPoint offset = QPoint());
+
+    /**
+     * @brief Generates all in-between frames at once, in parallel on the global thread pool.
+     * @param first The first key frame.
+     * @param second The second key frame, the size of the first.
+     * @param count How many in-betweens to make.
+     * @param mode How to get from one key frame to the other.
+     * @param offset For Translate, how far the first key frame has moved by the second.
+     * @return The in-betweens in order, or none if the key frames differ in size.
+     */
+    static vector<Frame> generate(const Frame& first, const Frame& second, int count, Mode mode, QPoint offset = QPoint());
+
+};
+
+#endif // INBETWEENGENERATOR_H
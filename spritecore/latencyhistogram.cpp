@@ -0,0 +1,132 @@
+/**
+ * @file latencyhistogram.cpp
+ * @brief Implementation of the LatencyHistogram class.
+ *
+ * Buckets follow the usual high-dynamic-range layout: values below 32 get one bucket each, and every
+ * higher power of two is split into 32 equal sub-buckets.
+ *
+ * @date 03/31/2025
+ */
+
+#include "latencyhistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+using std::max;
+using std::min;
+
+/**
+ * @brief Number of sub-buckets per power of two, as a bit count.
+ */
+static const int subBucketBits = 5;
+static const int subBucketCount = 1 << subBucketBits;
+
+/**
+ * @brief Durations are clamped to 2^40 ns (about 18 minutes), which bounds the bucket count.
+ */
+static const int maxMagnitude = 40;
+static const int bucketCount = (maxMagnitude - subBucketBits + 2) * subBucketCount;
+
+LatencyHistogram::LatencyHistogram(int windowSize) :
+    durations(max(1, windowSize), 0),
+    timestamps(max(1, windowSize), 0),
+    bucketCounts(bucketCount, 0)
+{}
+
+int LatencyHistogram::bucketFor(qint64 duration) {
+    quint64 value = static_cast<quint64>(qBound<qint64>(0, duration, (qint64(1) << maxMagnitude) - 1));
+
+    if (value < static_cast<quint64>(subBucketCount)) {
+        return static_cast<int>(value);
+    }
+
+    int magnitude = 63 - qCountLeadingZeroBits(value);
+    int shift = magnitude - subBucketBits;
+    int subBucket = static_cast<int>(value >> shift) - subBucketCount;
+    return (shift + 1) * subBucketCount + subBucket;
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < subBucketCount) {
+        return bucket;
+    }
+
+    int shift = bucket / subBucketCount - 1;
+    qint64 subBucket = bucket % subBucketCount + subBucketCount;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::addSample(qint64 timestamp, qint64 duration) {
+    int windowSize = static_cast<int>(durations.size());
+
+    if (count == windowSize) {
+        bucketCounts[bucketFor(durations[nextSlot])]--;
+    }
+
+    else {
+        count++;
+    }
+
+    durations[nextSlot] = duration;
+    timestamps[nextSlot] = timestamp;
+    bucketCounts[bucketFor(duration)]++;
+    nextSlot = (nextSlot + 1) % windowSize;
+}
+
+qint64 LatencyHistogram::percentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    int target = max(1, static_cast<int>(std::ceil(qBound(0.0, fraction, 1.0) * count)));
+    int seen = 0;
+
+    for (int bucket = 0; bucket < bucketCount; ++bucket) {
+        seen += bucketCounts[bucket];
+
+        if (seen >= target) {
+            return min(bucketUpperBound(bucket), maximum());
+        }
+    }
+    return maximum();
+}
+
+qint64 LatencyHistogram::maximum() const {
+    qint64 largest = 0;
+
+    for (int i = 0; i < count; ++i) {
+        largest = max(largest, durations[i]);
+    }
+    return largest;
+}
+
+qint64 LatencyHistogram::latest() const {
+    if (count == 0) {
+        return 0;
+    }
+
+    int windowSize = static_cast<int>(durations.size());
+    return durations[(nextSlot + windowSize - 1) % windowSize];
+}
+
+int LatencyHistogram::sampleCount() const {
+    return count;
+}
+
+int LatencyHistogram::samplesSince(qint64 timestamp) const {
+    int matching = 0;
+
+    for (int i = 0; i < count; ++i) {
+        if (timestamps[i] >= timestamp) {
+            matching++;
+        }
+    }
+    return matching;
+}
+
+void LatencyHistogram::clear() {
+    std::fill(bucketCounts.begin(), bucketCounts.end(), 0);
+    nextSlot = 0;
+    count = 0;
+}
@@ -0,0 +1,476 @@
+/**
+ * @file pixelblend.cpp
+ * @brief Implementation of the PixelBlend class.
+ *
+ * Both paths run the same integer formulas in 16-bit lanes:
+ *  - x / 255 is (x + 128 + ((x + 128) >> 8)) >> 8, exact for every product of two 8-bit values;
+ *  - unpremultiplying c by alpha is ((c * 256 + 128) * inverse[alpha]) >> 16 with a table of 65280 / alpha,
+ *    which is what _mm_mulhi_epu16 computes.
+ * No intermediate ever goes negative or above 16 bits, so wrapping lanes and plain ints agree.
+ *
+ * @date 03/31/2025
+ */
+
+#include "pixelblend.h"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXELBLEND_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Returns 65280 / alpha, rounded, for unpremultiplying with a multiply and a shift; 0 for alpha 0.
+ */
+static constexpr std::array<quint16, 256> makeInverseAlpha() {
+    std::array<quint16, 256> table{};
+
+    for (int alpha = 1; alpha < 256; ++alpha) {
+        table[alpha] = static_cast<quint16>((255 * 256 + alpha / 2) / alpha);
+    }
+    return table;
+}
+
+static constexpr std::array<quint16, 256> inverseAlpha = makeInverseAlpha();
+
+/**
+ * @brief Divides a product of two 8-bit values by 255, rounded to nearest.
+ */
+static inline int divide255(int value) {
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+static inline int multiply255(int a, int b) {
+    return divide255(a * b);
+}
+
+static inline int unpremultiply(int channel, int alpha) {
+    quint32 scaled = (static_cast<quint32>(channel) * 256 + 128) * inverseAlpha[alpha];
+    return std::min(static_cast<int>(scaled >> 16), 255);
+}
+
+/**
+ * @brief The paint color, premultiplied once per run. Channels are in memory order: blue, green, red.
+ */
+struct BlendSource {
+    int color[3];
+    int alpha;
+};
+
+static BlendSource premultiplied(QRgb source) {
+    int alpha = qAlpha(source);
+    return {{multiply255(qBlue(source), alpha), multiply255(qGreen(source), alpha), multiply255(qRed(source), alpha)}, alpha};
+}
+
+template <PixelBlend::Mode mode>
+static inline QRgb blendPixel(QRgb destination, const BlendSource& source) {
+    const int sourceAlpha = source.alpha;
+    const int destinationAlpha = qAlpha(destination);
+    int outAlpha;
+
+    if constexpr (mode == PixelBlend::Add) {
+        outAlpha = std::min(sourceAlpha + destinationAlpha, 255);
+    }
+
+    else if constexpr (mode == PixelBlend::AlphaLock) {
+        outAlpha = destinationAlpha;
+    }
+
+    else {
+        outAlpha = sourceAlpha + destinationAlpha - multiply255(sourceAlpha, destinationAlpha);
+    }
+
+    // Nothing to see on either side
+    if (outAlpha == 0) {
+        return destination;
+    }
+
+    const int channels[3] = {qBlue(destination), qGreen(destination), qRed(destination)};
+    int out[3];
+
+    for (int i = 0; i < 3; ++i) {
+        const int s = source.color[i];
+        const int d = multiply255(channels[i], destinationAlpha);
+        int o;
+
+        if constexpr (mode == PixelBlend::Normal) {
+            o = s + d - multiply255(d, sourceAlpha);
+        }
+
+        else if constexpr (mode == PixelBlend::Multiply) {
+            o = multiply255(s, d) + multiply255(s, 255 - destinationAlpha) + multiply255(d, 255 - sourceAlpha);
+        }
+
+        else if constexpr (mode == PixelBlend::Screen) {
+            o = s + d - multiply255(s, d);
+        }
+
+        else if constexpr (mode == PixelBlend::Add) {
+            o = std::min(s + d, 255);
+        }
+
+        else {
+            o = multiply255(s, destinationAlpha) + multiply255(d, 255 - sourceAlpha);
+        }
+
+        // A premultiplied channel cannot exceed its alpha; rounding in Multiply can reach one above
+        out[i] = unpremultiply(std::min(o, outAlpha), outAlpha);
+    }
+    return qRgba(out[2], out[1], out[0], outAlpha);
+}
+
+/**
+ * @brief What a pixel that comes out of an interpolation fully transparent becomes, matching a blank frame.
+ */
+static const QRgb transparentPixel = qRgba(255, 255, 255, 0);
+
+/**
+ * @brief Ordered 4x4 Bayer thresholds for ditherSpan().
+ */
+static const int bayer4x4[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5}
+};
+
+/**
+ * @brief Whether the dither pattern takes the second pixel at a position for a weight out of 256.
+ */
+static inline bool ditherTakesSecond(int x, int y, int weight) {
+    return bayer4x4[y & 3][x & 3] * 16 + 8 < weight;
+}
+
+/**
+ * @brief Mixes two pixels, premultiplied, with weight / 256 of the second.
+ */
+static inline QRgb interpolatePixel(QRgb first, QRgb second, int weight) {
+    const int firstAlpha = qAlpha(first);
+    const int secondAlpha = qAlpha(second);
+    const int outAlpha = (firstAlpha * (256 - weight) + secondAlpha * weight + 128) >> 8;
+
+    if (outAlpha == 0) {
+        return transparentPixel;
+    }
+
+    const int firstChannels[3] = {qBlue(first), qGreen(first), qRed(first)};
+    const int secondChannels[3] = {qBlue(second), qGreen(second), qRed(second)};
+    int out[3];
+
+    for (int i = 0; i < 3; ++i) {
+        int mixed = (multiply255(firstChannels[i], firstAlpha) * (256 - weight)
+                     + multiply255(secondChannels[i], secondAlpha) * weight + 128) >> 8;
+        out[i] = unpremultiply(std::min(mixed, outAlpha), outAlpha);
+    }
+    return qRgba(out[2], out[1], out[0], outAlpha);
+}
+
+static void interpolateRunScalar(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight) {
+    for (int i = 0; i < count; ++i) {
+        target[i] = interpolatePixel(first[i], second[i], weight);
+    }
+}
+
+template <PixelBlend::Mode mode>
+static void blendRunScalar(QRgb* pixels, int count, const BlendSource& source) {
+    for (int i = 0; i < count; ++i) {
+        pixels[i] = blendPixel<mode>(pixels[i], source);
+    }
+}
+
+#ifdef PIXELBLEND_SSE2
+
+static inline __m128i divide255(__m128i value) {
+    value = _mm_add_epi16(value, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+static inline __m128i multiply255(__m128i a, __m128i b) {
+    return divide255(_mm_mullo_epi16(a, b));
+}
+
+/**
+ * @brief Copies each pixel's alpha into its four lanes.
+ */
+static inline __m128i broadcastAlpha(__m128i pixels) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+/**
+ * @brief Selects the alpha lane of each of two pixels.
+ */
+static inline __m128i alphaLanes() {
+    return _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+}
+
+/**
+ * @brief Turns two premultiplied pixels back into ARGB lanes, exactly as unpremultiply() does.
+ * @param color The premultiplied channels.
+ * @param outAlpha Each pixel's alpha in all four of its lanes.
+ * @param transparent What a pixel with alpha 0 becomes.
+ */
+static inline __m128i unpremultiplyPair(__m128i color, __m128i outAlpha, __m128i transparent) {
+    const __m128i max = _mm_set1_epi16(255);
+    __m128i o = _mm_min_epi16(color, outAlpha);
+
+    // The reciprocal depends on each pixel's alpha, so it is looked up per pixel
+    int inverse0 = inverseAlpha[_mm_extract_epi16(outAlpha, 0)];
+    int inverse1 = inverseAlpha[_mm_extract_epi16(outAlpha, 4)];
+    __m128i inverse = _mm_set_epi16(static_cast<short>(inverse1), static_cast<short>(inverse1),
+                                    static_cast<short>(inverse1), static_cast<short>(inverse1),
+                                    static_cast<short>(inverse0), static_cast<short>(inverse0),
+                                    static_cast<short>(inverse0), static_cast<short>(inverse0));
+    __m128i scaled = _mm_add_epi16(_mm_slli_epi16(o, 8), _mm_set1_epi16(128));
+    __m128i unpremultiplied = _mm_min_epi16(_mm_mulhi_epu16(scaled, inverse), max);
+
+    // Put the alpha back into its lanes, and replace pixels that came out fully transparent
+    unpremultiplied = _mm_or_si128(_mm_andnot_si128(alphaLanes(), unpremultiplied), _mm_and_si128(alphaLanes(), outAlpha));
+
+    __m128i isTransparent = _mm_cmpeq_epi16(outAlpha, _mm_setzero_si128());
+    return _mm_or_si128(_mm_and_si128(isTransparent, transparent), _mm_andnot_si128(isTransparent, unpremultiplied));
+}
+
+/**
+ * @brief The paint color as two pixels of 16-bit lanes.
+ */
+struct VectorSource {
+    __m128i color;
+    __m128i alpha;
+    __m128i inverseAlpha;
+};
+
+/**
+ * @brief Blends two pixels held as eight 16-bit lanes, exactly as blendPixel() does.
+ */
+template <PixelBlend::Mode mode>
+static inline __m128i blendPair(__m128i destination, const VectorSource& source) {
+    const __m128i max = _mm_set1_epi16(255);
+    const __m128i destinationAlpha = broadcastAlpha(destination);
+    const __m128i s = source.color;
+    const __m128i d = multiply255(destination, destinationAlpha);
+    __m128i outAlpha;
+    __m128i o;
+
+    if constexpr (mode == PixelBlend::Add) {
+        outAlpha = _mm_min_epi16(_mm_add_epi16(source.alpha, destinationAlpha), max);
+    }
+
+    else if constexpr (mode == PixelBlend::AlphaLock) {
+        outAlpha = destinationAlpha;
+    }
+
+    else {
+        outAlpha = _mm_sub_epi16(_mm_add_epi16(source.alpha, destinationAlpha), multiply255(source.alpha, destinationAlpha));
+    }
+
+    if constexpr (mode == PixelBlend::Normal) {
+        o = _mm_sub_epi16(_mm_add_epi16(s, d), multiply255(d, source.alpha));
+    }
+
+    else if constexpr (mode == PixelBlend::Multiply) {
+        o = _mm_add_epi16(_mm_add_epi16(multiply255(s, d), multiply255(s, _mm_sub_epi16(max, destinationAlpha))),
+                          multiply255(d, source.inverseAlpha));
+    }
+
+    else if constexpr (mode == PixelBlend::Screen) {
+        o = _mm_sub_epi16(_mm_add_epi16(s, d), multiply255(s, d));
+    }
+
+    else if constexpr (mode == PixelBlend::Add) {
+        o = _mm_min_epi16(_mm_add_epi16(s, d), max);
+    }
+
+    else {
+        o = _mm_add_epi16(multiply255(s, destinationAlpha), multiply255(d, source.inverseAlpha));
+    }
+    return unpremultiplyPair(o, outAlpha, destination);
+}
+
+
+template <PixelBlend::Mode mode>
+static void blendRunVector(QRgb* pixels, int count, const BlendSource& source) {
+    const __m128i zero = _mm_setzero_si128();
+    const short b = static_cast<short>(source.color[0]);
+    const short g = static_cast<short>(source.color[1]);
+    const short r = static_cast<short>(source.color[2]);
+    const short a = static_cast<short>(source.alpha);
+
+    VectorSource vector;
+    vector.color = _mm_set_epi16(a, r, g, b, a, r, g, b);
+    vector.alpha = _mm_set1_epi16(a);
+    vector.inverseAlpha = _mm_set1_epi16(static_cast<short>(255 - source.alpha));
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        __m128i low = blendPair<mode>(_mm_unpacklo_epi8(packed, zero), vector);
+        __m128i high = blendPair<mode>(_mm_unpackhi_epi8(packed, zero), vector);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_packus_epi16(low, high));
+    }
+
+    blendRunScalar<mode>(pixels + i, count - i, source);
+}
+
+/**
+ * @brief Premultiplies two pixels, keeping their alpha in the alpha lanes.
+ */
+static inline __m128i premultiplyPair(__m128i pixels) {
+    const __m128i alpha = broadcastAlpha(pixels);
+    return _mm_or_si128(_mm_andnot_si128(alphaLanes(), multiply255(pixels, alpha)), _mm_and_si128(alphaLanes(), alpha));
+}
+
+static void interpolateRunVector(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i firstWeight = _mm_set1_epi16(static_cast<short>(256 - weight));
+    const __m128i secondWeight = _mm_set1_epi16(static_cast<short>(weight));
+    const __m128i transparent = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(transparentPixel)), zero);
+
+    // 255 * 256 + 128 is the largest sum, which still fits an unsigned 16-bit lane
+    auto mixPair = [&](__m128i a, __m128i b) {
+        __m128i mixed = _mm_add_epi16(_mm_mullo_epi16(premultiplyPair(a), firstWeight), _mm_mullo_epi16(premultiplyPair(b), secondWeight));
+        mixed = _mm_srli_epi16(_mm_add_epi16(mixed, _mm_set1_epi16(128)), 8);
+        return unpremultiplyPair(mixed, broadcastAlpha(mixed), transparent);
+    };
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+        __m128i low = mixPair(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i high = mixPair(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm_packus_epi16(low, high));
+    }
+
+    interpolateRunScalar(target + i, first + i, second + i, count - i, weight);
+}
+
+#endif // PIXELBLEND_SSE2
+
+QRgb PixelBlend::blend(QRgb destination, QRgb source, Mode mode) {
+    blendSpanScalar(&destination, 1, source, mode);
+    return destination;
+}
+
+void PixelBlend::blendSpan(QRgb* pixels, int count, QRgb source, Mode mode) {
+
+    // Opaque normal paint is exactly a copy of the color
+    if (mode == Replace || (mode == Normal && qAlpha(source) == 255)) {
+        std::fill_n(pixels, std::max(count, 0), source);
+        return;
+    }
+
+#ifdef PIXELBLEND_SSE2
+    if (qAlpha(source) == 0 || count <= 0) {
+        return;
+    }
+
+    BlendSource premultipliedSource = premultiplied(source);
+
+    switch (mode) {
+    case Normal:
+        blendRunVector<Normal>(pixels, count, premultipliedSource);
+        break;
+    case Multiply:
+        blendRunVector<Multiply>(pixels, count, premultipliedSource);
+        break;
+    case Screen:
+        blendRunVector<Screen>(pixels, count, premultipliedSource);
+        break;
+    case Add:
+        blendRunVector<Add>(pixels, count, premultipliedSource);
+        break;
+    case AlphaLock:
+        blendRunVector<AlphaLock>(pixels, count, premultipliedSource);
+        break;
+    case Replace:
+        break;
+    }
+#else
+    blendSpanScalar(pixels, count, source, mode);
+#endif
+}
+
+void PixelBlend::blendSpanScalar(QRgb* pixels, int count, QRgb source, Mode mode) {
+    if (mode == Replace) {
+        std::fill_n(pixels, std::max(count, 0), source);
+        return;
+    }
+
+    // Transparent paint changes nothing; skipping it also avoids rounding the pixels through premultiplication
+    if (qAlpha(source) == 0 || count <= 0) {
+        return;
+    }
+
+    BlendSource premultipliedSource = premultiplied(source);
+
+    switch (mode) {
+    case Normal:
+        blendRunScalar<Normal>(pixels, count, premultipliedSource);
+        break;
+    case Multiply:
+        blendRunScalar<Multiply>(pixels, count, premultipliedSource);
+        break;
+    case Screen:
+        blendRunScalar<Screen>(pixels, count, premultipliedSource);
+        break;
+    case Add:
+        blendRunScalar<Add>(pixels, count, premultipliedSource);
+        break;
+    case AlphaLock:
+        blendRunScalar<AlphaLock>(pixels, count, premultipliedSource);
+        break;
+    case Replace:
+        break;
+    }
+}
+
+void PixelBlend::interpolateSpan(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight) {
+    weight = std::clamp(weight, 0, 256);
+
+#ifdef PIXELBLEND_SSE2
+    interpolateRunVector(target, first, second, count, weight);
+#else
+    interpolateRunScalar(target, first, second, count, weight);
+#endif
+}
+
+void PixelBlend::interpolateSpanScalar(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight) {
+    interpolateRunScalar(target, first, second, count, std::clamp(weight, 0, 256));
+}
+
+void PixelBlend::ditherSpan(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight, int x, int y) {
+    int i = 0;
+
+#ifdef PIXELBLEND_SSE2
+
+    // The pattern repeats every four pixels, so one mask covers every group of four
+    const __m128i takeSecond = _mm_set_epi32(ditherTakesSecond(x + 3, y, weight) ? -1 : 0,
+                                             ditherTakesSecond(x + 2, y, weight) ? -1 : 0,
+                                             ditherTakesSecond(x + 1, y, weight) ? -1 : 0,
+                                             ditherTakesSecond(x, y, weight) ? -1 : 0);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i),
+                         _mm_or_si128(_mm_and_si128(takeSecond, b), _mm_andnot_si128(takeSecond, a)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        target[i] = ditherTakesSecond(x + i, y, weight) ? second[i] : first[i];
+    }
+}
+
+bool PixelBlend::hasVectorKernel() {
+#ifdef PIXELBLEND_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
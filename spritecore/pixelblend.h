@@ -0,0 +1,120 @@
+#ifndef PIXELBLEND_H
+#define PIXELBLEND_H
+
+/**
+ * @file pixelblend.h
+ * @brief Declares the PixelBlend class, which composites a paint color onto ARGB32 pixels.
+ *
+ * Pixels are premultiplied, blended and unpremultiplied again with 8-bit integer math only. Dividing by
+ * 255 and by the result's alpha both use exact integer formulas, so the SSE2 kernel for runs of
+ * pixels produces the same bits as the scalar code it replaces.
+ *
+ * @date 03/31/2025
+ */
+
+#include <QRgb>
+
+/**
+ * @class PixelBlend
+ *
+ * @brief Blend modes for brushes, fills and shapes, over runs of pixels in one color, and mixing of two runs.
+ *
+ * Colors in and out are ARGB32, the format of frames and the editor's sprite. The separable modes
+ * follow the W3C compositing formulas with source-over alpha.
+ */
+class PixelBlend {
+
+public:
+
+    /**
+     * @brief How the paint color combines with the pixels underneath.
+     */
+    enum Mode {
+        Replace,    ///< Overwrite the pixel, alpha included.
+        Normal,     ///< Source-over: the paint covers the pixel by its alpha.
+        Multiply,   ///< Darken by multiplying the colors.
+        Screen,     ///< Lighten by multiplying the inverted colors.
+        Add,        ///< Add the colors and alphas, saturating at 255.
+        AlphaLock   ///< Source-atop: paint only where the pixel is opaque, keeping its alpha.
+    };
+
+    /**
+     * @brief Blends a color onto one pixel.
+     * @param destination The pixel underneath.
+     * @param source The paint color.
+     * @param mode The blend mode.
+     * @return The blended pixel.
+     */
+    static QRgb blend(QRgb destination, QRgb source, Mode mode);
+
+    /**
+     * @brief Blends a color onto a run of pixels, with the SSE2 kernel where the CPU has one.
+     * @param pixels The first pixel of the run.
+     * @param count The number of pixels.
+     * @param source The paint color.
+     * @param mode The blend mode.
+     */
+    static void blendSpan(QRgb* pixels, int count, QRgb source, Mode mode);
+
+    /**
+     * @brief Blends a color onto a run of pixels one at a time.
+     *
+     * The reference for blendSpan(), which must produce exactly the same pixels.
+     *
+     * @param pixels The first pixel of the run.
+     * @param count The number of pixels.
+     * @param source The paint color.
+     * @param mode The blend mode.
+     */
+    static void blendSpanScalar(QRgb* pixels, int count, QRgb source, Mode mode);
+
+    /**
+     * @brief Mixes two runs of pixels, premultiplied, into a third, with the SSE2 kernel where the CPU has one.
+     *
+     * Pixels that come out fully transparent are transparent white, like a blank frame.
+     *
+     * @param target Receives the mixed pixels; may be first or second.
+     * @param first The first run.
+     * @param second The second run.
+     * @param count The number of pixels.
+     * @param weight How much of the second run to take, from 0 to 256.
+     */
+    static void interpolateSpan(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight);
+
+    /**
+     * @brief Mixes two runs of pixels one at a time.
+     *
+     * The reference for interpolateSpan(), which must produce exactly the same pixels.
+     *
+     * @param target Receives the mixed pixels; may be first or second.
+     * @param first The first run.
+     * @param second The second run.
+     * @param count The number of pixels.
+     * @param weight How much of the second run to take, from 0 to 256.
+     */
+    static void interpolateSpanScalar(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight);
+
+    /**
+     * @brief Picks each pixel from one of two runs with an ordered 4x4 dither pattern.
+     *
+     * Pixels are copied, never mixed, so the result uses only colors of the two runs.
+     *
+     * @param target Receives the picked pixels; may be first or second.
+     * @param first The first run.
+     * @param second The second run.
+     * @param count The number of pixels.
+     * @param weight How much of the second run to take, from 0 to 256.
+     * @param x The column of the run's first pixel, which places the pattern.
+     * @param y The row of the run.
+     */
+    static void ditherSpan(QRgb* target, const QRgb* first, const QRgb* second, int count, int weight, int x, int y);
+
+    /**
+     * @brief Whether blendSpan() was compiled with a vector kernel.
+     * @return true if runs are blended, mixed and dithered four pixels at a time.
+     */
+    static bool hasVectorKernel();
+
+};
+
+#endif // PIXELBLEND_H
@@ -0,0 +1,77 @@
+/**
+ * @file pixelblit.cpp
+ * @brief Implementation of the PixelBlit class.
+ * @date 03/31/2025
+ */
+
+#include "pixelblit.h"
+
+#include <QtDebug>
+
+#include <algorithm>
+#include <cstring>
+
+QImage PixelBlit::copy(const QImage& source, const QRect& region) {
+    QImage result(region.size(), QImage::Format_ARGB32);
+    result.fill(Qt::transparent);
+
+    if (source.format() != QImage::Format_ARGB32) {
+        qWarning() << "PixelBlit::copy: expected an ARGB32 image";
+        return result;
+    }
+
+    QRect clipped = region & source.rect();
+
+    if (clipped.isEmpty()) {
+        return result;
+    }
+
+    size_t rowBytes = static_cast<size_t>(clipped.width()) * sizeof(QRgb);
+    QPoint offset = clipped.topLeft() - region.topLeft();
+
+    for (int y = 0; y < clipped.height(); ++y) {
+        const QRgb* sourceRow = reinterpret_cast<const QRgb*>(source.constScanLine(clipped.top() + y)) + clipped.left();
+        QRgb* targetRow = reinterpret_cast<QRgb*>(result.scanLine(offset.y() + y)) + offset.x();
+        memcpy(targetRow, sourceRow, rowBytes);
+    }
+    return result;
+}
+
+QRect PixelBlit::paste(QImage& target, const QImage& patch, QPoint position) {
+    if (target.format() != QImage::Format_ARGB32) {
+        qWarning() << "PixelBlit::paste: expected an ARGB32 image";
+        return QRect();
+    }
+
+    QImage source = (patch.format() == QImage::Format_ARGB32) ? patch : patch.convertToFormat(QImage::Format_ARGB32);
+    QRect clipped = QRect(position, source.size()) & target.rect();
+
+    if (clipped.isEmpty()) {
+        return QRect();
+    }
+
+    size_t rowBytes = static_cast<size_t>(clipped.width()) * sizeof(QRgb);
+    QPoint offset = clipped.topLeft() - position;
+
+    for (int y = 0; y < clipped.height(); ++y) {
+        const QRgb* sourceRow = reinterpret_cast<const QRgb*>(source.constScanLine(offset.y() + y)) + offset.x();
+        QRgb* targetRow = reinterpret_cast<QRgb*>(target.scanLine(clipped.top() + y)) + clipped.left();
+        memcpy(targetRow, sourceRow, rowBytes);
+    }
+    return clipped;
+}
+
+QRect PixelBlit::fill(QImage& target, const QRect& region, QRgb color) {
+    if (target.format() != QImage::Format_ARGB32) {
+        qWarning() << "PixelBlit::fill: expected an ARGB32 image";
+        return QRect();
+    }
+
+    QRect clipped = region & target.rect();
+
+    for (int y = clipped.top(); y <= clipped.bottom(); ++y) {
+        QRgb* row = reinterpret_cast<QRgb*>(target.scanLine(y)) + clipped.left();
+        std::fill(row, row + clipped.width(), color);
+    }
+    return clipped;
+}
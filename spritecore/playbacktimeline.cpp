@@ -0,0 +1,55 @@
+/**
+ * @file playbacktimeline.cpp
+ * @brief Implementation of the PlaybackTimeline class.
+ * @date 03/31/2025
+ */
+
+#include "playbacktimeline.h"
+
+#include <algorithm>
+
+PlaybackTimeline::PlaybackTimeline(const vector<int>& durations, int defaultDuration) {
+    defaultDuration = std::max(defaultDuration, 1);
+    starts.reserve(durations.size() + 1);
+    starts.push_back(0);
+
+    // Sums are 64-bit, so long animations keep millisecond accuracy
+    for (int duration : durations) {
+        starts.push_back(starts.back() + (duration > 0 ? duration : defaultDuration));
+    }
+}
+
+int PlaybackTimeline::frameCount() const {
+    return starts.empty() ? 0 : static_cast<int>(starts.size()) - 1;
+}
+
+qint64 PlaybackTimeline::totalDuration() const {
+    return starts.empty() ? 0 : starts.back();
+}
+
+qint64 PlaybackTimeline::frameStart(int frameIndex) const {
+    return starts.at(frameIndex);
+}
+
+qint64 PlaybackTimeline::frameEnd(int frameIndex) const {
+    return starts.at(frameIndex + 1);
+}
+
+int PlaybackTimeline::frameAt(qint64 time) const {
+    if (frameCount() == 0) {
+        return -1;
+    }
+
+    // The first start after the time belongs to the frame after the one shown
+    auto next = std::upper_bound(starts.begin() + 1, starts.end() - 1, time);
+    return static_cast<int>(next - starts.begin()) - 1;
+}
+
+int PlaybackTimeline::frameAtLooped(qint64 time) const {
+    if (frameCount() == 0) {
+        return -1;
+    }
+
+    qint64 total = totalDuration();
+    return frameAt(((time % total) + total) % total);
+}
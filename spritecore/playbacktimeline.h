@@ -0,0 +1,89 @@
+#ifndef PLAYBACKTIMELINE_H
+#define PLAYBACKTIMELINE_H
+
+/**
+ * @file playbacktimeline.h
+ * @brief Declares the PlaybackTimeline class, which maps playback time to frames.
+ * @date 03/31/2025
+ */
+
+#include <QtGlobal>
+
+#include <vector>
+
+using std::vector;
+
+/**
+ * @class PlaybackTimeline
+ *
+ * @brief The start time of every frame of an animation, precomputed once.
+ *
+ * Finding the frame shown at a time is a binary search over the cumulative start times, so seeking
+ * costs O(log n) however long the animation is. Players should look frames up from the total time
+ * played rather than add up timer intervals, so playback never drifts from the timeline.
+ */
+class PlaybackTimeline {
+
+public:
+
+    /**
+     * @brief Creates a timeline without frames.
+     */
+    PlaybackTimeline() = default;
+
+    /**
+     * @brief Creates a timeline from each frame's duration.
+     * @param durations Each frame's duration in milliseconds; 0 means the default duration.
+     * @param defaultDuration Duration of frames without their own, in milliseconds; at least 1 is used.
+     */
+    PlaybackTimeline(const vector<int>& durations, int defaultDuration);
+
+    /**
+     * @brief Returns the number of frames.
+     * @return The frame count.
+     */
+    int frameCount() const;
+
+    /**
+     * @brief Returns how long one pass through the animation takes.
+     * @return The total duration in milliseconds, or 0 without frames.
+     */
+    qint64 totalDuration() const;
+
+    /**
+     * @brief Returns when a frame starts showing.
+     * @param frameIndex The frame.
+     * @return The start time in milliseconds.
+     */
+    qint64 frameStart(int frameIndex) const;
+
+    /**
+     * @brief Returns when a frame stops showing, which is when the next one starts.
+     * @param frameIndex The frame.
+     * @return The end time in milliseconds.
+     */
+    qint64 frameEnd(int frameIndex) const;
+
+    /**
+     * @brief Finds the frame shown at a time.
+     * @param time Milliseconds from the start; clamped to the animation.
+     * @return The frame index, or -1 without frames.
+     */
+    int frameAt(qint64 time) const;
+
+    /**
+     * @brief Finds the frame shown at a time when the animation loops.
+     * @param time Milliseconds since the first pass started; may span any number of passes.
+     * @return The frame index, or -1 without frames.
+     */
+    int frameAtLooped(qint64 time) const;
+
+private:
+
+    /**
+     * @brief The start time of each frame, followed by the total duration.
+     */
+    vector<qint64> starts;
+};
+
+#endif // PLAYBACKTIMELINE_H
@@ -0,0 +1,638 @@
+/**
+ * @file saveloadmanager.cpp
+ * @brief Implementation of the SaveLoadManager class for saving and loading sprite data in the Sprite Editor.
+ *
+ * This file provides functionality for converting the internal sprite representation into JSON
+ * and saving it to disk, as well as loading and reconstructing sprite frames from previously saved files.
+ *
+ * @date 03/31/2025
+ */
+
+#include "saveloadmanager.h"
+#include "tracer.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QColor>
+#include <QtEndian>
+#include <QDebug>
+
+#include <algorithm>
+
+using std::vector;
+
+/**
+ * @brief Magic bytes at the start of every binary .ssp file.
+ */
+static const char binaryMagic[] = "SSPB";
+
+/**
+ * @brief Current binary format version; version 2 added the frame-order table, version 3 the frame durations.
+ */
+static const quint32 binaryVersion = 3;
+
+/**
+ * @brief Size of the version 1 header: magic, version, height, width and frame count.
+ */
+static const int binaryHeaderSizeV1 = 20;
+
+/**
+ * @brief Size of the current header, which adds the number of distinct frames.
+ */
+static const int binaryHeaderSize = 24;
+
+/**
+ * @brief Longest side, in pixels, of a sprite a file may describe.
+ */
+static const int maxSpriteSide = 16384;
+
+/**
+ * @brief Most pixels one frame of a sprite a file may describe; 256 MB of ARGB.
+ */
+static const qint64 maxSpritePixels = qint64(1) << 26;
+
+/**
+ * @brief Validation stops collecting messages after this many problems.
+ */
+static const int maxReportedProblems = 50;
+
+/**
+ * @brief Checks a sprite size read from a file before anything is allocated for it.
+ *
+ * Bounding each side first keeps height * width and every size derived from it far from overflowing.
+ *
+ * @return true if the size is positive and within the limits; otherwise false, with the reason added to problems.
+ */
+static bool checkSpriteSize(qint64 height, qint64 width, QStringList& problems) {
+    if (height <= 0 || width <= 0) {
+        problems << QString("Invalid sprite size %1x%2.").arg(width).arg(height);
+        return false;
+    }
+
+    if (height > maxSpriteSide || width > maxSpriteSide || height * width > maxSpritePixels) {
+        problems << QString("Sprite size %1x%2 is larger than the supported %3 pixels per frame.").arg(width).arg(height).arg(maxSpritePixels);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks the size a JSON file claims before a frame is allocated for it.
+ *
+ * Each stored pixel is a JSON object of dozens of bytes, so a file cannot honestly describe more pixels
+ * than it has bytes. Capping on that keeps a small file from asking for gigabytes of blank frames.
+ *
+ * @return true if the size is plausible; otherwise false, with the reason added to problems.
+ */
+static bool checkJsonSpriteSize(qint64 height, qint64 width, qint64 frameCount, qint64 fileBytes, QStringList& problems) {
+    if (!checkSpriteSize(height, width, problems)) {
+        return false;
+    }
+
+    if (frameCount * height * width > fileBytes) {
+        problems << QString("%1 frames of %2x%3 are more pixels than the file's %4 bytes can describe.")
+                        .arg(frameCount).arg(width).arg(height).arg(fileBytes);
+        return false;
+    }
+    return true;
+}
+
+SaveLoadManager::SaveLoadManager(QObject* parent) : QObject{parent} {}
+
+bool SaveLoadManager::saveToFile(const FrameManager& manager, QString filePath) {
+    TRACE_SCOPE("SaveLoadManager::saveToFile");
+    QJsonArray framesArray;
+
+    if (manager.frames.empty()) {
+        qWarning() << "Nothing to save: the sprite has no frames.";
+        return false;
+    }
+
+    // Identical frames are written once and referenced from the frame-order table; the project itself is left as it is
+    vector<int> uniqueFrames;
+    vector<int> frameOrder = manager.findDuplicateFrames(uniqueFrames);
+
+    // Loop through each distinct frame in the FrameManager
+    for (size_t i = 0; i < uniqueFrames.size(); ++i) {
+        TRACE_SCOPE("save: serialize frame");
+        Frame frame = manager.frames[uniqueFrames[i]];
+        QJsonArray pixelArray;
+        vector<vector<QColor>> pixels = frame.getPixels();
+
+        // Loop through each row (y) of the frame
+        for (int y = 0; y < frame.getHeight(); ++y) {
+
+            // Loop through each column (x) in the row
+            for (int x = 0; x < frame.getWidth(); ++x) {
+
+                // Get the QColor at position (x, y)
+                QColor color = pixels[y][x];
+
+                // Create a JSON object for this pixel
+                QJsonObject pixelObj;
+                pixelObj["x"] = x;              // X-coordinate
+                pixelObj["y"] = y;              // Y-coordinate
+                pixelObj["r"] = color.red();    // Red component
+                pixelObj["g"] = color.green();  // Green component
+                pixelObj["b"] = color.blue();   // Blue component
+                pixelObj["a"] = color.alpha();  // Alpha (transparency)
+                pixelArray.append(pixelObj);
+            }
+        }
+
+        // Create a JSON object to represent the entire frame
+        QJsonObject frameObj;
+        frameObj["index"] = static_cast<int>(i);  // Add the position in the frames array
+        frameObj["pixels"] = pixelArray;        // Store all pixels in this frame
+
+        // Add the frame object to the top-level frames array
+        framesArray.append(frameObj);
+    }
+
+    // Create the root JSON object and assign the frames array to it
+    QJsonObject root;
+    root["height"] = manager.frames[0].getHeight();
+    root["width"] = manager.frames[0].getWidth();
+    root["frames"] = framesArray;
+
+    // For each frame of the animation, the position of its pixels in the frames array
+    QJsonArray orderArray;
+
+    for (int position : frameOrder) {
+        orderArray.append(position);
+    }
+    root["frameOrder"] = orderArray;
+
+    // For each frame of the animation, its duration in milliseconds; 0 follows the playback speed
+    QJsonArray durationsArray;
+
+    for (int duration : manager.frameDurations()) {
+        durationsArray.append(duration);
+    }
+    root["durations"] = durationsArray;
+
+    // Convert the root JSON object into a QJsonDocument
+    QJsonDocument doc(root);
+
+    // Open the output file in write-only mode
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open file for writing:" << filePath;
+        return false;   // Return false if file couldn't be opened
+    }
+
+    {
+        TRACE_SCOPE("save: encode and write");
+        file.write(doc.toJson());
+    }
+
+    file.close();
+    lastDedup.frameCount = static_cast<int>(frameOrder.size());
+    lastDedup.uniqueFrameCount = static_cast<int>(uniqueFrames.size());
+    return true;
+}
+
+bool SaveLoadManager::loadFromFile(FrameManager& manager, QString filePath) {
+    TRACE_SCOPE("SaveLoadManager::loadFromFile");
+    QFile file(filePath);
+
+    // If the file can't be opened, log an error and return false
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open file for reading:" << filePath;
+        return false;
+    }
+
+    QByteArray data;
+    {
+        TRACE_SCOPE("load: read file");
+        data = file.readAll();
+    }
+    file.close();
+
+    // Binary files are recognized by their magic bytes
+    if (data.startsWith(binaryMagic)) {
+        QStringList problems;
+        bool success = readBinary(manager, data, problems, true);
+
+        for (const QString& problem : problems) {
+            qWarning() << problem;
+        }
+        return success;
+    }
+
+    QJsonDocument doc;
+    {
+        TRACE_SCOPE("load: parse JSON");
+        doc = QJsonDocument::fromJson(data);
+    }
+
+    // If the top-level JSON is not an object, log an error and return false
+    if (!doc.isObject()) {
+        qWarning() << "Invalid JSON format.";
+        return false;
+    }
+
+    // Extract the root JSON object and the array of frames
+    QJsonObject root = doc.object();
+    QJsonArray framesArray = root["frames"].toArray();
+
+    int height = root["height"].toInt();
+    int width = root["width"].toInt();
+    QStringList sizeProblems;
+
+    if (!checkJsonSpriteSize(height, width, framesArray.size(), data.size(), sizeProblems)) {
+        qWarning() << sizeProblems.join(" ");
+        return false;
+    }
+
+    vector<Frame> storedFrames;
+    storedFrames.reserve(framesArray.size());
+
+    // Loop through each frame in the array
+    for (const QJsonValue& frameVal : framesArray) {
+        TRACE_SCOPE("load: build frame");
+        QJsonObject frameObj = frameVal.toObject();
+        QJsonArray pixelArray = frameObj["pixels"].toArray();
+        Frame newFrame(height, width);
+
+        // Loop through each pixel and update the new frame
+        for (const QJsonValue& pixelVal : pixelArray) {
+            QJsonObject pixelObj = pixelVal.toObject();
+
+            // Extract pixel properties
+            int x = pixelObj["x"].toInt();
+            int y = pixelObj["y"].toInt();
+            int r = pixelObj["r"].toInt();
+            int g = pixelObj["g"].toInt();
+            int b = pixelObj["b"].toInt();
+            int a = pixelObj["a"].toInt();
+
+            // Frame::updateFrame throws on pixels outside the frame, so a malformed file fails here instead
+            if (x < 0 || x >= width || y < 0 || y >= height) {
+                qWarning() << "Pixel" << x << y << "is outside the sprite.";
+                return false;
+            }
+
+            // Update the pixel in the new frame at (x, y) with the RGBA values
+            newFrame.updateFrame(y, x, r, g, b, a);
+        }
+
+        storedFrames.push_back(newFrame);
+    }
+
+    // Files without a frame-order table store every frame in order
+    bool hasFrameOrder = root.contains("frameOrder");
+    vector<Frame> orderedFrames;
+
+    if (!hasFrameOrder) {
+        orderedFrames = std::move(storedFrames);
+    }
+
+    else {
+        QJsonArray orderArray = root["frameOrder"].toArray();
+        orderedFrames.reserve(orderArray.size());
+
+        // Repeated frames share the stored frame's pixels
+        for (const QJsonValue& positionVal : orderArray) {
+            int position = positionVal.toInt(-1);
+
+            if (position < 0 || position >= static_cast<int>(storedFrames.size())) {
+                qWarning() << "Frame order refers to missing frame" << position;
+                return false;
+            }
+            orderedFrames.push_back(storedFrames[position]);
+        }
+    }
+
+    // The frames are only replaced once the whole file has been read
+    manager.clearFrames();
+    manager.height = height;
+    manager.width = width;
+
+    // One insert adds every row and checks the memory budget once, so opening stays linear in the frame count
+    if (!orderedFrames.empty()) {
+        manager.insertFrames(0, std::move(orderedFrames));
+    }
+
+    if (!hasFrameOrder) {
+        manager.deduplicateFrames();
+    }
+
+    // Files saved before frames had durations play every frame at the playback speed
+    QJsonArray durationsArray = root["durations"].toArray();
+
+    for (qsizetype i = 0; i < durationsArray.size() && i < static_cast<qsizetype>(manager.frames.size()); ++i) {
+        manager.setFrameDuration(static_cast<int>(i), durationsArray[i].toInt());
+    }
+
+    return true;
+}
+
+bool SaveLoadManager::saveToBinaryFile(const FrameManager& manager, QString filePath) {
+    TRACE_SCOPE("SaveLoadManager::saveToBinaryFile");
+    int height = manager.height;
+    int width = manager.width;
+    size_t frameBytes = static_cast<size_t>(height) * width * sizeof(quint32);
+
+    if (manager.frames.empty()) {
+        qWarning() << "Nothing to save: the sprite has no frames.";
+        return false;
+    }
+
+    // Identical frames are written once and referenced from the frame-order table; the project itself is left as it is
+    vector<int> uniqueFrames;
+    vector<int> frameOrder = manager.findDuplicateFrames(uniqueFrames);
+
+    QByteArray data;
+    data.reserve(binaryHeaderSize + static_cast<qsizetype>(2 * frameOrder.size() * sizeof(quint32) + frameBytes * uniqueFrames.size()));
+    data.append(binaryMagic, 4);
+
+    uchar header[20];
+    qToLittleEndian<quint32>(binaryVersion, header);
+    qToLittleEndian<qint32>(height, header + 4);
+    qToLittleEndian<qint32>(width, header + 8);
+    qToLittleEndian<quint32>(static_cast<quint32>(frameOrder.size()), header + 12);
+    qToLittleEndian<quint32>(static_cast<quint32>(uniqueFrames.size()), header + 16);
+    data.append(reinterpret_cast<const char*>(header), sizeof(header));
+
+    // Append the frame-order table: for each frame, which stored frame holds its pixels
+    QByteArray table(static_cast<qsizetype>(frameOrder.size() * sizeof(quint32)), Qt::Uninitialized);
+
+    for (size_t i = 0; i < frameOrder.size(); ++i) {
+        qToLittleEndian<quint32>(static_cast<quint32>(frameOrder[i]), table.data() + i * sizeof(quint32));
+    }
+    data.append(table);
+
+    // Append the durations table: for each frame, its duration in milliseconds
+    const vector<int>& durations = manager.frameDurations();
+
+    for (size_t i = 0; i < frameOrder.size(); ++i) {
+        qToLittleEndian<quint32>(static_cast<quint32>(durations[i]), table.data() + i * sizeof(quint32));
+    }
+    data.append(table);
+
+    // Append each distinct frame's pixels row by row as little-endian ARGB
+    QByteArray row(width * static_cast<int>(sizeof(quint32)), Qt::Uninitialized);
+
+    for (int frameIndex : uniqueFrames) {
+        const Frame& frame = manager.frames[frameIndex];
+
+        for (int y = 0; y < height; ++y) {
+            qToLittleEndian<quint32>(frame.constScanLine(y), width, row.data());
+            data.append(row);
+        }
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open file for writing:" << filePath;
+        return false;
+    }
+
+    file.write(data);
+    file.close();
+    lastDedup.frameCount = static_cast<int>(frameOrder.size());
+    lastDedup.uniqueFrameCount = static_cast<int>(uniqueFrames.size());
+    return true;
+}
+
+bool SaveLoadManager::readBinary(FrameManager& manager, const QByteArray& data, QStringList& problems, bool populate) {
+    if (data.size() < binaryHeaderSizeV1) {
+        problems << "Binary file is shorter than its header.";
+        return false;
+    }
+
+    const uchar* header = reinterpret_cast<const uchar*>(data.constData()) + 4;
+    quint32 version = qFromLittleEndian<quint32>(header);
+    qint32 height = qFromLittleEndian<qint32>(header + 4);
+    qint32 width = qFromLittleEndian<qint32>(header + 8);
+    quint32 frameCount = qFromLittleEndian<quint32>(header + 12);
+
+    if (version < 1 || version > binaryVersion) {
+        problems << QString("Unsupported binary version %1.").arg(version);
+        return false;
+    }
+
+    // Version 1 stores every frame in order, without a frame-order table
+    int headerSize = (version == 1) ? binaryHeaderSizeV1 : binaryHeaderSize;
+    quint32 uniqueCount = frameCount;
+
+    if (data.size() < headerSize) {
+        problems << "Binary file is shorter than its header.";
+        return false;
+    }
+
+    if (version != 1) {
+        uniqueCount = qFromLittleEndian<quint32>(header + 16);
+    }
+
+    if (!checkSpriteSize(height, width, problems)) {
+        return false;
+    }
+
+    if (frameCount == 0) {
+        problems << "File contains no frames.";
+        return false;
+    }
+
+    if (uniqueCount == 0 || uniqueCount > frameCount) {
+        problems << QString("Invalid number of distinct frames %1 for %2 frames.").arg(uniqueCount).arg(frameCount);
+        return false;
+    }
+
+    // Both factors are bounded, so neither size can overflow
+    qint64 frameBytes = static_cast<qint64>(height) * width * static_cast<qint64>(sizeof(quint32));
+    // Version 2 adds the frame-order table and version 3 the durations table, each one entry per frame
+    qint64 tableBytes = static_cast<qint64>(version - 1) * frameCount * static_cast<qint64>(sizeof(quint32));
+    qint64 pixelBytes = data.size() - headerSize - tableBytes;
+
+    // Dividing the pixel data by the frame size never overflows, whatever the header claims
+    if (pixelBytes < 0 || pixelBytes % frameBytes != 0 || pixelBytes / frameBytes != uniqueCount) {
+        problems << QString("Expected %1 frames of %2 bytes after the %3-byte tables but found %4 bytes.")
+                        .arg(uniqueCount).arg(frameBytes).arg(tableBytes).arg(data.size() - headerSize);
+        return false;
+    }
+
+    vector<quint32> frameOrder(frameCount);
+    const uchar* table = reinterpret_cast<const uchar*>(data.constData()) + headerSize;
+
+    for (quint32 i = 0; i < frameCount; ++i) {
+        frameOrder[i] = (version == 1) ? i : qFromLittleEndian<quint32>(table + i * sizeof(quint32));
+
+        if (frameOrder[i] >= uniqueCount) {
+            problems << QString("Frame %1 refers to missing stored frame %2.").arg(i).arg(frameOrder[i]);
+            return false;
+        }
+    }
+
+    vector<int> durations(frameCount, 0);
+
+    for (quint32 i = 0; i < frameCount && version >= 3; ++i) {
+        quint32 duration = qFromLittleEndian<quint32>(table + (frameCount + i) * sizeof(quint32));
+
+        if (duration > static_cast<quint32>(FrameManager::maximumFrameDuration)) {
+            problems << QString("Frame %1 has invalid duration %2 ms.").arg(i).arg(duration);
+            return false;
+        }
+        durations[i] = static_cast<int>(duration);
+    }
+
+    if (!populate) {
+        return true;
+    }
+
+    manager.clearFrames();
+    manager.height = height;
+    manager.width = width;
+
+    const char* pixelData = data.constData() + headerSize + tableBytes;
+    vector<Frame> storedFrames;
+    storedFrames.reserve(uniqueCount);
+
+    for (quint32 i = 0; i < uniqueCount; ++i) {
+        TRACE_SCOPE("load: build frame");
+        // Every pixel is read from the file, so the frame skips its transparent fill; rows are contiguous on both sides
+        Frame newFrame = Frame::allocate(height, width);
+        qsizetype pixelCount = static_cast<qsizetype>(width) * height;
+        qFromLittleEndian<quint32>(pixelData, pixelCount, newFrame.scanLine(0));
+        pixelData += pixelCount * sizeof(quint32);
+
+        storedFrames.push_back(newFrame);
+    }
+
+    // Repeated frames share the stored frame's pixels
+    vector<Frame> orderedFrames;
+    orderedFrames.reserve(frameCount);
+
+    for (quint32 position : frameOrder) {
+        orderedFrames.push_back(storedFrames[position]);
+    }
+
+    // One insert adds every row and checks the memory budget once, so opening stays linear in the frame count
+    manager.insertFrames(0, std::move(orderedFrames));
+
+    for (quint32 i = 0; i < frameCount; ++i) {
+        manager.setFrameDuration(static_cast<int>(i), durations[i]);
+    }
+
+    if (version == 1) {
+        manager.deduplicateFrames();
+    }
+    return true;
+}
+
+bool SaveLoadManager::validateFile(QString filePath, QStringList& problems) {
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        problems << "Failed to open file for reading.";
+        return false;
+    }
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    if (data.startsWith(binaryMagic)) {
+        FrameManager unused(0, 0);
+        return readBinary(unused, data, problems, false);
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+
+    if (parseError.error != QJsonParseError::NoError) {
+        problems << "Invalid JSON: " + parseError.errorString();
+        return false;
+    }
+
+    if (!doc.isObject()) {
+        problems << "Top-level JSON value is not an object.";
+        return false;
+    }
+
+    QJsonObject root = doc.object();
+    int height = root["height"].toInt();
+    int width = root["width"].toInt();
+    QJsonArray framesArray = root["frames"].toArray();
+
+    if (!checkJsonSpriteSize(height, width, framesArray.size(), data.size(), problems)) {
+        return false;
+    }
+
+    if (framesArray.isEmpty()) {
+        problems << "File contains no frames.";
+        return false;
+    }
+
+    for (qsizetype i = 0; i < framesArray.size() && problems.size() < maxReportedProblems; ++i) {
+        QJsonArray pixelArray = framesArray[i].toObject()["pixels"].toArray();
+        vector<bool> seen(static_cast<size_t>(height) * width, false);
+
+        for (const QJsonValue& pixelVal : pixelArray) {
+            QJsonObject pixelObj = pixelVal.toObject();
+            int x = pixelObj["x"].toInt(-1);
+            int y = pixelObj["y"].toInt(-1);
+
+            if (x < 0 || x >= width || y < 0 || y >= height) {
+                problems << QString("Frame %1: pixel (%2, %3) is outside the sprite.").arg(i).arg(x).arg(y);
+                break;
+            }
+
+            for (const char* channel : {"r", "g", "b", "a"}) {
+                int value = pixelObj[channel].toInt(-1);
+
+                if (value < 0 || value > 255) {
+                    problems << QString("Frame %1: pixel (%2, %3) has invalid %4 value.").arg(i).arg(x).arg(y).arg(channel);
+                    break;
+                }
+            }
+            seen[static_cast<size_t>(y) * width + x] = true;
+        }
+
+        qsizetype missing = std::count(seen.begin(), seen.end(), false);
+        if (missing > 0) {
+            problems << QString("Frame %1: %2 pixels are missing.").arg(i).arg(missing);
+        }
+    }
+
+    if (root.contains("frameOrder")) {
+        QJsonArray orderArray = root["frameOrder"].toArray();
+
+        if (orderArray.isEmpty()) {
+            problems << "Frame order is empty.";
+        }
+
+        for (qsizetype i = 0; i < orderArray.size() && problems.size() < maxReportedProblems; ++i) {
+            int position = orderArray[i].toInt(-1);
+
+            if (position < 0 || position >= framesArray.size()) {
+                problems << QString("Frame order entry %1 refers to missing frame %2.").arg(i).arg(position);
+            }
+        }
+    }
+
+    if (root.contains("durations")) {
+        QJsonArray durationsArray = root["durations"].toArray();
+        qsizetype frameCount = root.contains("frameOrder") ? root["frameOrder"].toArray().size() : framesArray.size();
+
+        if (durationsArray.size() != frameCount) {
+            problems << QString("Expected %1 frame durations but found %2.").arg(frameCount).arg(durationsArray.size());
+        }
+
+        for (qsizetype i = 0; i < durationsArray.size() && problems.size() < maxReportedProblems; ++i) {
+            int duration = durationsArray[i].toInt(-1);
+
+            if (duration < 0 || duration > FrameManager::maximumFrameDuration) {
+                problems << QString("Frame %1 has invalid duration %2 ms.").arg(i).arg(duration);
+            }
+        }
+    }
+
+    return problems.isEmpty();
+}
+
+DedupStatistics SaveLoadManager::lastSaveDedup() const {
+    return lastDedup;
+}
@@ -0,0 +1,131 @@
+#ifndef SAVELOADMANAGER_H
+#define SAVELOADMANAGER_H
+
+/**
+ * @file saveloadmanager.cpp
+ * @brief Declaration of the SaveLoadManager class used for saving and loading sprite data in the Sprite Editor.
+ * @date 03/31/2025
+ */
+
+#include "framemanager.h"
+
+#include <QByteArray>
+#include <QObject>
+#include <QStringList>
+
+/**
+ * @struct DedupStatistics
+ *
+ * @brief How much a save saved by storing identical frames only once.
+ */
+struct DedupStatistics {
+
+    /**
+     * @brief Number of frames in the sprite.
+     */
+    int frameCount = 0;
+
+    /**
+     * @brief Number of distinct frames written to the file.
+     */
+    int uniqueFrameCount = 0;
+
+    /**
+     * @brief Returns how many frames each stored frame stands for on average.
+     * @return frameCount / uniqueFrameCount, or 1 if nothing was saved.
+     */
+    double ratio() const {
+        return (uniqueFrameCount > 0) ? static_cast<double>(frameCount) / uniqueFrameCount : 1.0;
+    }
+
+};
+
+/**
+ * @class SaveLoadManager
+ *
+ * @brief Handles serialization and deserialization of sprite data from the FrameManager to and from .ssp files.
+ *
+ * This class is responsible for converting the internal frame data into a JSON-based format
+ * and writing it to disk, or for reading JSON sprite data from a file and updating the frame manager accordingly.
+ */
+class SaveLoadManager : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructs a SaveLoadManager instance.
+     * @param parent Optional parent QObject.
+     */
+    explicit SaveLoadManager(QObject* parent = nullptr);
+
+    /**
+     * @brief Saves all frames managed by the given FrameManager to a JSON-based .ssp file.
+     *
+     * Identical frames are written once. The "frames" array holds the distinct frames and "frameOrder"
+     * lists, for each frame of the animation, its position in that array. "durations" lists each frame's
+     * duration in milliseconds. The manager is not changed.
+     *
+     * @param manager Reference to the FrameManager containing all frame data to save.
+     * @param filePath The target file path where the .ssp file will be written.
+     * @return true if the file was saved successfully; false otherwise.
+     */
+    bool saveToFile(const FrameManager& manager, QString filePath);
+
+    /**
+     * @brief Loads sprite data from a JSON-based .ssp file and populates the given FrameManager.
+     * @param manager Reference to the FrameManager where loaded frames will be stored.
+     * @param filePath Path to the .ssp file to load.
+     * @return true if the file was loaded successfully; false otherwise.
+     */
+    bool loadFromFile(FrameManager& manager, QString filePath);
+
+    /**
+     * @brief Saves all frames to a compact binary .ssp file.
+     *
+     * The file starts with the "SSPB" magic, a format version, the sprite size, the frame count and the
+     * number of distinct frames. A frame-order table of one index per frame follows, then a table of each
+     * frame's duration in milliseconds, then the raw pixels of each distinct frame as little-endian ARGB
+     * values. loadFromFile recognizes the magic and reads these files, version 2 files without the
+     * durations and version 1 files without either table, as well as JSON ones.
+     *
+     * @param manager Reference to the FrameManager containing all frame data to save.
+     * @param filePath The target file path where the binary file will be written.
+     * @return true if the file was saved successfully; false otherwise.
+     */
+    bool saveToBinaryFile(const FrameManager& manager, QString filePath);
+
+    /**
+     * @brief Checks that a JSON or binary .ssp file is well formed without loading it into a FrameManager.
+     * @param filePath Path to the .ssp file to check.
+     * @param problems Receives a description of every problem found.
+     * @return true if no problems were found; false otherwise.
+     */
+    bool validateFile(QString filePath, QStringList& problems);
+
+    /**
+     * @brief Returns how many frames the most recent save wrote and how many of them were distinct.
+     * @return The statistics of the last successful save.
+     */
+    DedupStatistics lastSaveDedup() const;
+
+private:
+
+    /**
+     * @brief Statistics of the last successful save.
+     */
+    DedupStatistics lastDedup;
+
+    /**
+     * @brief Reads a binary .ssp file whose contents are already in memory.
+     * @param manager Reference to the FrameManager where loaded frames will be stored.
+     * @param data The complete file contents.
+     * @param problems Receives a description of every problem found.
+     * @param populate Whether to store the frames in the manager or only check the data.
+     * @return true if the data is a valid binary sprite; false otherwise.
+     */
+    bool readBinary(FrameManager& manager, const QByteArray& data, QStringList& problems, bool populate);
+
+};
+
+#endif // SAVELOADMANAGER_H
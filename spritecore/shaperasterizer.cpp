@@ -0,0 +1,223 @@
+/**
+ * @file shaperasterizer.cpp
+ * @brief Implementation of the ShapeRasterizer class.
+ * @date 03/31/2025
+ */
+
+#include "shaperasterizer.h"
+
+#include <QtDebug>
+
+#include <algorithm>
+#include <cstdlib>
+
+using std::abs;
+using std::max;
+using std::min;
+
+/**
+ * @brief Sorts plotted points by row and column and merges neighbours into spans.
+ */
+static vector<PixelSpan> spansFromPoints(vector<QPoint>& points) {
+    std::sort(points.begin(), points.end(), [](const QPoint& a, const QPoint& b) {
+        return (a.y() != b.y()) ? a.y() < b.y() : a.x() < b.x();
+    });
+
+    vector<PixelSpan> spans;
+
+    for (const QPoint& point : points) {
+        if (!spans.empty() && spans.back().y == point.y() && point.x() <= spans.back().right + 1) {
+            spans.back().right = max(spans.back().right, point.x());
+        }
+
+        else {
+            spans.push_back({point.y(), point.x(), point.x()});
+        }
+    }
+    return spans;
+}
+
+/**
+ * @brief Replaces the spans on each row with one span from the leftmost to the rightmost pixel.
+ */
+static vector<PixelSpan> fillRows(const vector<PixelSpan>& outline) {
+    vector<PixelSpan> filled;
+
+    for (const PixelSpan& span : outline) {
+        if (!filled.empty() && filled.back().y == span.y) {
+            filled.back().right = max(filled.back().right, span.right);
+        }
+
+        else {
+            filled.push_back(span);
+        }
+    }
+    return filled;
+}
+
+vector<PixelSpan> ShapeRasterizer::rasterize(Shape shape, QPoint start, QPoint end, bool filled) {
+    switch (shape) {
+    case Line:
+        return line(start, end);
+    case Rectangle:
+        return rectangle(start, end, filled);
+    case Ellipse:
+        return ellipse(start, end, filled);
+    }
+    return {};
+}
+
+vector<PixelSpan> ShapeRasterizer::line(QPoint from, QPoint to) {
+    int x = from.x(), y = from.y();
+    int dx = abs(to.x() - x), stepX = (x < to.x()) ? 1 : -1;
+    int dy = -abs(to.y() - y), stepY = (y < to.y()) ? 1 : -1;
+    int error = dx + dy;
+
+    vector<QPoint> points;
+    points.reserve(max(dx, -dy) + 1);
+
+    while (true) {
+        points.push_back(QPoint(x, y));
+
+        if (x == to.x() && y == to.y()) {
+            break;
+        }
+
+        int doubled = 2 * error;
+
+        if (doubled >= dy) {
+            error += dy;
+            x += stepX;
+        }
+
+        if (doubled <= dx) {
+            error += dx;
+            y += stepY;
+        }
+    }
+    return spansFromPoints(points);
+}
+
+vector<PixelSpan> ShapeRasterizer::rectangle(QPoint corner, QPoint oppositeCorner, bool filled) {
+    int left = min(corner.x(), oppositeCorner.x());
+    int right = max(corner.x(), oppositeCorner.x());
+    int top = min(corner.y(), oppositeCorner.y());
+    int bottom = max(corner.y(), oppositeCorner.y());
+
+    vector<PixelSpan> spans;
+    spans.reserve(bottom - top + 1);
+
+    for (int y = top; y <= bottom; ++y) {
+
+        // Filled rows, and the top and bottom edges, are one run; the sides are two single pixels
+        if (filled || y == top || y == bottom || right - left <= 1) {
+            spans.push_back({y, left, right});
+        }
+
+        else {
+            spans.push_back({y, left, left});
+            spans.push_back({y, right, right});
+        }
+    }
+    return spans;
+}
+
+vector<PixelSpan> ShapeRasterizer::ellipse(QPoint corner, QPoint oppositeCorner, bool filled) {
+    qint64 x0 = min(corner.x(), oppositeCorner.x());
+    qint64 x1 = max(corner.x(), oppositeCorner.x());
+    qint64 y0 = min(corner.y(), oppositeCorner.y());
+    qint64 y1 = max(corner.y(), oppositeCorner.y());
+
+    // Zingl's midpoint ellipse inside a bounding box; handles even and odd diameters
+    qint64 a = x1 - x0, b = y1 - y0, b1 = b & 1;
+    qint64 dx = 4 * (1 - a) * b * b, dy = 4 * (b1 + 1) * a * a;
+    qint64 error = dx + dy + b1 * a * a;
+
+    y0 += (b + 1) / 2;
+    y1 = y0 - b1;
+    a *= 8 * a;
+    b1 = 8 * b * b;
+
+    vector<QPoint> points;
+    points.reserve(static_cast<size_t>(4 * (x1 - x0 + y1 - y0 + 2)));
+
+    auto plot = [&points](qint64 x, qint64 y) {
+        points.push_back(QPoint(static_cast<int>(x), static_cast<int>(y)));
+    };
+
+    do {
+        plot(x1, y0);
+        plot(x0, y0);
+        plot(x0, y1);
+        plot(x1, y1);
+
+        qint64 doubled = 2 * error;
+
+        if (doubled <= dy) {
+            y0++;
+            y1--;
+            error += dy += a;
+        }
+
+        if (doubled >= dx || 2 * error > dy) {
+            x0++;
+            x1--;
+            error += dx += b1;
+        }
+    } while (x0 <= x1);
+
+    // Very flat ellipses stop early; finish their tips
+    while (y0 - y1 <= b) {
+        plot(x0 - 1, y0);
+        plot(x1 + 1, y0++);
+        plot(x0 - 1, y1);
+        plot(x1 + 1, y1--);
+    }
+
+    vector<PixelSpan> outline = spansFromPoints(points);
+    return filled ? fillRows(outline) : outline;
+}
+
+QRect ShapeRasterizer::bounds(const vector<PixelSpan>& spans) {
+    if (spans.empty()) {
+        return QRect();
+    }
+
+    int left = spans.front().left, right = spans.front().right;
+    int top = spans.front().y, bottom = spans.front().y;
+
+    for (const PixelSpan& span : spans) {
+        left = min(left, span.left);
+        right = max(right, span.right);
+        top = min(top, span.y);
+        bottom = max(bottom, span.y);
+    }
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+QRect ShapeRasterizer::paint(QImage& image, const vector<PixelSpan>& spans, QRgb color, PixelBlend::Mode mode) {
+    if (image.format() != QImage::Format_ARGB32) {
+        qWarning() << "ShapeRasterizer::paint: expected an ARGB32 image";
+        return QRect();
+    }
+
+    QRect changed;
+
+    for (const PixelSpan& span : spans) {
+        if (span.y < 0 || span.y >= image.height()) {
+            continue;
+        }
+
+        int left = max(span.left, 0);
+        int right = min(span.right, image.width() - 1);
+
+        if (left > right) {
+            continue;
+        }
+
+        QRgb* row = reinterpret_cast<QRgb*>(image.scanLine(span.y));
+        PixelBlend::blendSpan(row + left, right - left + 1, color, mode);
+        changed |= QRect(left, span.y, right - left + 1, 1);
+    }
+    return changed;
+}
@@ -0,0 +1,112 @@
+#ifndef SHAPERASTERIZER_H
+#define SHAPERASTERIZER_H
+
+/**
+ * @file shaperasterizer.h
+ * @brief Declares the ShapeRasterizer class, which turns lines, rectangles and ellipses into pixel spans.
+ *
+ * Shapes are rasterized with integer-only midpoint algorithms (Bresenham for lines, Zingl's midpoint
+ * ellipse for ellipses) and returned as horizontal runs of pixels, so painting a shape is one fill per
+ * run and its spans can be previewed and committed without touching any other pixel.
+ *
+ * @date 03/31/2025
+ */
+
+#include "pixelblend.h"
+
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+
+#include <vector>
+
+using std::vector;
+
+/**
+ * @struct PixelSpan
+ *
+ * @brief A horizontal run of pixels on one row, with inclusive ends.
+ */
+struct PixelSpan {
+    int y;
+    int left;
+    int right;
+};
+
+/**
+ * @class ShapeRasterizer
+ *
+ * @brief Rasterizes shapes into sorted, non-overlapping pixel spans.
+ */
+class ShapeRasterizer {
+
+public:
+
+    /**
+     * @brief The shapes the editor can draw.
+     */
+    enum Shape {
+        Line,
+        Rectangle,
+        Ellipse
+    };
+
+    /**
+     * @brief Rasterizes a shape dragged from one point to another.
+     * @param shape Which shape to draw.
+     * @param start Where the drag started, in sprite coordinates.
+     * @param end Where the drag is now, in sprite coordinates.
+     * @param filled Whether rectangles and ellipses are filled; ignored for lines.
+     * @return The shape's spans, sorted by row and then column.
+     */
+    static vector<PixelSpan> rasterize(Shape shape, QPoint start, QPoint end, bool filled);
+
+    /**
+     * @brief Rasterizes a one pixel wide line with Bresenham's algorithm.
+     * @param from First end point.
+     * @param to Second end point.
+     * @return The line's spans.
+     */
+    static vector<PixelSpan> line(QPoint from, QPoint to);
+
+    /**
+     * @brief Rasterizes an axis-aligned rectangle given two opposite corners.
+     * @param corner One corner, inclusive.
+     * @param oppositeCorner The opposite corner, inclusive.
+     * @param filled Whether to fill the inside or only draw the outline.
+     * @return The rectangle's spans.
+     */
+    static vector<PixelSpan> rectangle(QPoint corner, QPoint oppositeCorner, bool filled);
+
+    /**
+     * @brief Rasterizes the ellipse inscribed in the rectangle spanned by two corners.
+     * @param corner One corner of the bounding box, inclusive.
+     * @param oppositeCorner The opposite corner, inclusive.
+     * @param filled Whether to fill the inside or only draw the outline.
+     * @return The ellipse's spans.
+     */
+    static vector<PixelSpan> ellipse(QPoint corner, QPoint oppositeCorner, bool filled);
+
+    /**
+     * @brief Returns the bounding rectangle of a set of spans.
+     * @param spans The spans to measure.
+     * @return The smallest rectangle containing every span, or an empty rectangle.
+     */
+    static QRect bounds(const vector<PixelSpan>& spans);
+
+    /**
+     * @brief Paints a color onto every pixel covered by the spans, clipped to the image.
+     *
+     * The spans must not overlap, as rasterized shapes never do, so each pixel is blended once.
+     *
+     * @param image The ARGB32 image to paint.
+     * @param spans The pixels to paint.
+     * @param color The color to paint.
+     * @param mode How the color combines with the pixels underneath.
+     * @return The bounding rectangle of the pixels written, or an empty rectangle.
+     */
+    static QRect paint(QImage& image, const vector<PixelSpan>& spans, QRgb color, PixelBlend::Mode mode = PixelBlend::Replace);
+
+};
+
+#endif // SHAPERASTERIZER_H
@@ -0,0 +1,18 @@
+# Include this file from a project one directory below the top level to link against spritecore.
+
+QT += core gui concurrent
+
+CONFIG(debug, debug|release)|tracing: DEFINES += SPRITE_TRACING
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../spritecore/release/ -lspritecore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../spritecore/debug/ -lspritecore
+else:unix: LIBS += -L$$OUT_PWD/../spritecore/ -lspritecore
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../spritecore/release/libspritecore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../spritecore/debug/libspritecore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../spritecore/release/spritecore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../spritecore/debug/spritecore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../spritecore/libspritecore.a
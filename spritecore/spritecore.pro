@@ -0,0 +1,64 @@
+TEMPLATE = lib
+TARGET = spritecore
+
+# The model must stay usable without QtWidgets
+QT       = core gui concurrent
+
+CONFIG += staticlib c++17
+
+# Trace spans are compiled in for debug builds, or for any build configured with CONFIG+=tracing
+CONFIG(debug, debug|release)|tracing: DEFINES += SPRITE_TRACING
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    brushstamp.cpp \
+    canvasrenderer.cpp \
+    canvasview.cpp \
+    floodfill.cpp \
+    frame.cpp \
+    framebufferpool.cpp \
+    framebatchrunner.cpp \
+    framelistmodel.cpp \
+    framemanager.cpp \
+    gifexporter.cpp \
+    imageimporter.cpp \
+    inbetweengenerator.cpp \
+    latencyhistogram.cpp \
+    pixelblend.cpp \
+    pixelblit.cpp \
+    playbacktimeline.cpp \
+    saveloadmanager.cpp \
+    shaperasterizer.cpp \
+    spritemipmaps.cpp \
+    spriteresampler.cpp \
+    spritesheetexporter.cpp \
+    thumbnailcache.cpp \
+    tracer.cpp
+
+HEADERS += \
+    brushstamp.h \
+    canvasrenderer.h \
+    canvasview.h \
+    floodfill.h \
+    frame.h \
+    framebufferpool.h \
+    framebatchrunner.h \
+    framelistmodel.h \
+    framemanager.h \
+    gifexporter.h \
+    imageimporter.h \
+    inbetweengenerator.h \
+    latencyhistogram.h \
+    pixelblend.h \
+    pixelblit.h \
+    playbacktimeline.h \
+    saveloadmanager.h \
+    shaperasterizer.h \
+    spritemipmaps.h \
+    spriteresampler.h \
+    spritesheetexporter.h \
+    thumbnailcache.h \
+    tracer.h
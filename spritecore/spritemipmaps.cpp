@@ -0,0 +1,110 @@
+/**
+ * @file spritemipmaps.cpp
+ * @brief Implementation of the SpriteMipmaps class.
+ * @date 03/31/2025
+ */
+
+#include "spritemipmaps.h"
+
+#include <QtDebug>
+
+#include <algorithm>
+
+void SpriteMipmaps::update(const QImage& sprite, QRect dirty) {
+    if (sprite.format() != QImage::Format_ARGB32) {
+        qWarning() << "SpriteMipmaps::update: expected an ARGB32 image";
+        return;
+    }
+
+    // A new size invalidates every level, so rebuild the whole chain
+    if (sprite.size() != builtSize) {
+        levels.clear();
+        builtSize = sprite.size();
+
+        QSize size = builtSize;
+
+        while (size.width() > 1 || size.height() > 1) {
+            size = QSize((size.width() + 1) / 2, (size.height() + 1) / 2);
+            levels.emplace_back(size, QImage::Format_ARGB32_Premultiplied);
+        }
+        dirty = sprite.rect();
+    }
+
+    dirty &= sprite.rect();
+
+    for (size_t index = 0; index < levels.size() && !dirty.isEmpty(); ++index) {
+
+        // Each level pixel covers a 2x2 block, so halve the dirty edges
+        dirty = QRect(QPoint(dirty.left() / 2, dirty.top() / 2), QPoint(dirty.right() / 2, dirty.bottom() / 2));
+
+        if (index == 0) {
+            downsample(sprite, false, levels[0], dirty);
+        }
+
+        else {
+            downsample(levels[index - 1], true, levels[index], dirty);
+        }
+    }
+}
+
+void SpriteMipmaps::clear() {
+    levels.clear();
+    builtSize = QSize();
+}
+
+QSize SpriteMipmaps::spriteSize() const {
+    return builtSize;
+}
+
+int SpriteMipmaps::levelCount() const {
+    return static_cast<int>(levels.size());
+}
+
+const QImage& SpriteMipmaps::level(int level) const {
+    return levels[level - 1];
+}
+
+void SpriteMipmaps::downsample(const QImage& source, bool sourceIsPremultiplied, QImage& target, QRect region) {
+    const int sourceWidth = source.width();
+    const int sourceHeight = source.height();
+
+    for (int y = region.top(); y <= region.bottom(); ++y) {
+        const QRgb* upper = reinterpret_cast<const QRgb*>(source.constScanLine(2 * y));
+        const QRgb* lower = (2 * y + 1 < sourceHeight) ? reinterpret_cast<const QRgb*>(source.constScanLine(2 * y + 1)) : nullptr;
+        QRgb* row = reinterpret_cast<QRgb*>(target.scanLine(y));
+
+        for (int x = region.left(); x <= region.right(); ++x) {
+            int alpha = 0, red = 0, green = 0, blue = 0, count = 0;
+
+            // Sum the premultiplied block; blocks on an odd edge have fewer than four pixels
+            auto add = [&](QRgb color) {
+                QRgb premultiplied = sourceIsPremultiplied ? color : qPremultiply(color);
+                alpha += qAlpha(premultiplied);
+                red += qRed(premultiplied);
+                green += qGreen(premultiplied);
+                blue += qBlue(premultiplied);
+                count++;
+            };
+
+            const int left = 2 * x;
+            const bool hasRight = left + 1 < sourceWidth;
+
+            add(upper[left]);
+
+            if (hasRight) {
+                add(upper[left + 1]);
+            }
+
+            if (lower) {
+                add(lower[left]);
+
+                if (hasRight) {
+                    add(lower[left + 1]);
+                }
+            }
+
+            const int half = count / 2;
+            row[x] = qRgba((red + half) / count, (green + half) / count, (blue + half) / count, (alpha + half) / count);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef SPRITEMIPMAPS_H
+#define SPRITEMIPMAPS_H
+
+/**
+ * @file spritemipmaps.h
+ * @brief Declares the SpriteMipmaps class, a chain of halved copies of the sprite for zoomed-out drawing.
+ *
+ * When the canvas shows several sprite pixels per screen pixel, sampling the full-size sprite both
+ * aliases and touches memory far apart. The renderer reads the level whose pixels are closest to one
+ * screen pixel instead, so drawing costs the same whatever the sprite size.
+ *
+ * @date 03/31/2025
+ */
+
+#include <QImage>
+#include <QRect>
+
+#include <vector>
+
+/**
+ * @class SpriteMipmaps
+ *
+ * @brief Keeps downsampled copies of an ARGB32 sprite up to date.
+ *
+ * Level n is 2^n times smaller than the sprite in each direction, rounded up, down to a single pixel.
+ * Each pixel is the alpha-weighted average of the 2x2 block below it, stored premultiplied so the
+ * renderer can blend it without converting. Level 0 is the sprite itself and is not stored.
+ */
+class SpriteMipmaps {
+
+public:
+
+    /**
+     * @brief Brings the levels in line with the sprite.
+     *
+     * Only the part of every level above the dirty rectangle is recomputed. A sprite of a different
+     * size rebuilds every level.
+     *
+     * @param sprite The current ARGB32 sprite.
+     * @param dirty The sprite pixels changed since the last update.
+     */
+    void update(const QImage& sprite, QRect dirty);
+
+    /**
+     * @brief Drops every level.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the size of the sprite the levels were built from.
+     * @return The sprite size, or an empty size before the first update.
+     */
+    QSize spriteSize() const;
+
+    /**
+     * @brief Returns the number of stored levels, not counting the sprite itself.
+     * @return The deepest level available.
+     */
+    int levelCount() const;
+
+    /**
+     * @brief Returns one downsampled level.
+     * @param level The level, from 1 to levelCount().
+     * @return The premultiplied ARGB32 image of that level.
+     */
+    const QImage& level(int level) const;
+
+private:
+
+    /**
+     * @brief Recomputes part of one level from the level below it.
+     * @param source The next larger level, or the sprite.
+     * @param sourceIsPremultiplied Whether the source is already premultiplied.
+     * @param target The level to write.
+     * @param region The target pixels to recompute.
+     */
+    static void downsample(const QImage& source, bool sourceIsPremultiplied, QImage& target, QRect region);
+
+    /**
+     * @brief Levels 1 to levelCount(), smallest last.
+     */
+    std::vector<QImage> levels;
+
+    /**
+     * @brief Size of the sprite the levels were built from.
+     */
+    QSize builtSize;
+
+};
+
+#endif // SPRITEMIPMAPS_H
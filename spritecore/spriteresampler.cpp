@@ -0,0 +1,314 @@
+/**
+ * @file spriteresampler.cpp
+ * @brief Implementation of the SpriteResampler class.
+ *
+ * A frame's pixels are one packed row-major buffer, so a whole frame is read through a single
+ * constScanLine(0) pointer and written through a single scanLine(0) pointer of an uninitialized frame.
+ *
+ * @date 03/31/2025
+ */
+
+#include "spriteresampler.h"
+
+#include <QRect>
+#include <QtDebug>
+
+#include <algorithm>
+#include <cstring>
+
+using std::vector;
+
+/**
+ * @brief Color of the area a larger canvas adds, matching a new blank frame.
+ */
+static const QRgb clearPixel = qRgba(255, 255, 255, 0);
+
+/**
+ * @brief Returns, for each of `to` target pixels along an axis, the source pixel under its center.
+ */
+static vector<int> sampleIndices(int from, int to) {
+    vector<int> indices(to);
+
+    for (int i = 0; i < to; ++i) {
+        indices[i] = static_cast<int>((static_cast<qint64>(2 * i + 1) * from) / (2 * to));
+    }
+    return indices;
+}
+
+static Frame scaleNearest(const Frame& frame, int height, int width) {
+    const int sourceWidth = frame.getWidth();
+    vector<int> columns = sampleIndices(sourceWidth, width);
+    vector<int> rows = sampleIndices(frame.getHeight(), height);
+
+    Frame result = Frame::allocate(height, width);
+    const QRgb* source = frame.constScanLine(0);
+    QRgb* target = result.scanLine(0);
+
+    for (int y = 0; y < height; ++y) {
+        QRgb* row = target + static_cast<size_t>(y) * width;
+
+        // Rows sampling the same source row are the same, so enlarging copies whole rows
+        if (y > 0 && rows[y] == rows[y - 1]) {
+            memcpy(row, row - width, static_cast<size_t>(width) * sizeof(QRgb));
+            continue;
+        }
+
+        const QRgb* sourceRow = source + static_cast<size_t>(rows[y]) * sourceWidth;
+
+        for (int x = 0; x < width; ++x) {
+            row[x] = sourceRow[columns[x]];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Doubles a frame with Scale2x, which gives the same pixels as EPX.
+ *
+ * Each pixel E becomes a 2x2 block. A corner takes the color of the two edge neighbors meeting there
+ * when they match, unless the pixel sits in a straight run, which keeps lines and fills untouched.
+ */
+static Frame scale2x(const Frame& frame) {
+    const int width = frame.getWidth();
+    const int height = frame.getHeight();
+    const size_t targetWidth = static_cast<size_t>(width) * 2;
+
+    Frame result = Frame::allocate(height * 2, width * 2);
+    const QRgb* source = frame.constScanLine(0);
+    QRgb* target = result.scanLine(0);
+
+    for (int y = 0; y < height; ++y) {
+        const QRgb* above = source + static_cast<size_t>(std::max(y - 1, 0)) * width;
+        const QRgb* row = source + static_cast<size_t>(y) * width;
+        const QRgb* below = source + static_cast<size_t>(std::min(y + 1, height - 1)) * width;
+        QRgb* top = target + static_cast<size_t>(2 * y) * targetWidth;
+        QRgb* bottom = top + targetWidth;
+
+        for (int x = 0; x < width; ++x) {
+            const QRgb b = above[x];
+            const QRgb d = row[std::max(x - 1, 0)];
+            const QRgb e = row[x];
+            const QRgb f = row[std::min(x + 1, width - 1)];
+            const QRgb h = below[x];
+
+            if (b != h && d != f) {
+                top[2 * x] = (d == b) ? d : e;
+                top[2 * x + 1] = (b == f) ? f : e;
+                bottom[2 * x] = (d == h) ? d : e;
+                bottom[2 * x + 1] = (h == f) ? f : e;
+            }
+
+            else {
+                top[2 * x] = top[2 * x + 1] = bottom[2 * x] = bottom[2 * x + 1] = e;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Triples a frame with Scale3x, the 3x3 form of scale2x() that also checks the diagonal neighbors.
+ */
+static Frame scale3x(const Frame& frame) {
+    const int width = frame.getWidth();
+    const int height = frame.getHeight();
+    const size_t targetWidth = static_cast<size_t>(width) * 3;
+
+    Frame result = Frame::allocate(height * 3, width * 3);
+    const QRgb* source = frame.constScanLine(0);
+    QRgb* target = result.scanLine(0);
+
+    for (int y = 0; y < height; ++y) {
+        const QRgb* above = source + static_cast<size_t>(std::max(y - 1, 0)) * width;
+        const QRgb* row = source + static_cast<size_t>(y) * width;
+        const QRgb* below = source + static_cast<size_t>(std::min(y + 1, height - 1)) * width;
+        QRgb* top = target + static_cast<size_t>(3 * y) * targetWidth;
+        QRgb* middle = top + targetWidth;
+        QRgb* bottom = middle + targetWidth;
+
+        for (int x = 0; x < width; ++x) {
+            const int left = std::max(x - 1, 0);
+            const int right = std::min(x + 1, width - 1);
+            const QRgb a = above[left], b = above[x], c = above[right];
+            const QRgb d = row[left], e = row[x], f = row[right];
+            const QRgb g = below[left], h = below[x], i = below[right];
+            QRgb* out[3] = {top + 3 * x, middle + 3 * x, bottom + 3 * x};
+
+            if (b != h && d != f) {
+                out[0][0] = (d == b) ? d : e;
+                out[0][1] = ((d == b && e != c) || (b == f && e != a)) ? b : e;
+                out[0][2] = (b == f) ? f : e;
+                out[1][0] = ((d == b && e != g) || (d == h && e != a)) ? d : e;
+                out[1][1] = e;
+                out[1][2] = ((b == f && e != i) || (h == f && e != c)) ? f : e;
+                out[2][0] = (d == h) ? d : e;
+                out[2][1] = ((d == h && e != i) || (h == f && e != g)) ? h : e;
+                out[2][2] = (h == f) ? f : e;
+            }
+
+            else {
+                std::fill_n(out[0], 3, e);
+                std::fill_n(out[1], 3, e);
+                std::fill_n(out[2], 3, e);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Applies an EPX-style upscaler while the result fits, then samples the nearest pixels for the rest.
+ */
+static Frame scalePixelArt(const Frame& frame, int height, int width, int factor) {
+    Frame scaled = frame;
+
+    while (scaled.getHeight() * factor <= height && scaled.getWidth() * factor <= width) {
+        scaled = (factor == 2) ? scale2x(scaled) : scale3x(scaled);
+    }
+
+    if (scaled.getHeight() == height && scaled.getWidth() == width) {
+        return scaled;
+    }
+    return scaleNearest(scaled, height, width);
+}
+
+/**
+ * @brief Finds the source pixels each target pixel covers along an axis, as [start, end) ranges.
+ *
+ * A shrinking axis covers every source pixel exactly once; a growing one takes the pixel under each center.
+ */
+static void boxRanges(int from, int to, vector<int>& starts, vector<int>& ends) {
+    if (to >= from) {
+        starts = sampleIndices(from, to);
+        ends = starts;
+
+        for (int& end : ends) {
+            end++;
+        }
+        return;
+    }
+
+    starts.resize(to);
+    ends.resize(to);
+
+    for (int i = 0; i < to; ++i) {
+        starts[i] = static_cast<int>(static_cast<qint64>(i) * from / to);
+        ends[i] = static_cast<int>(static_cast<qint64>(i + 1) * from / to);
+    }
+}
+
+static Frame scaleBox(const Frame& frame, int height, int width) {
+    const int sourceWidth = frame.getWidth();
+    vector<int> columnStarts, columnEnds, rowStarts, rowEnds;
+    boxRanges(sourceWidth, width, columnStarts, columnEnds);
+    boxRanges(frame.getHeight(), height, rowStarts, rowEnds);
+
+    Frame result = Frame::allocate(height, width);
+    const QRgb* source = frame.constScanLine(0);
+    QRgb* target = result.scanLine(0);
+
+    for (int y = 0; y < height; ++y) {
+        QRgb* row = target + static_cast<size_t>(y) * width;
+
+        for (int x = 0; x < width; ++x) {
+            quint64 alpha = 0, red = 0, green = 0, blue = 0;
+
+            // Colors are weighted by alpha, which averages them premultiplied
+            for (int sourceY = rowStarts[y]; sourceY < rowEnds[y]; ++sourceY) {
+                const QRgb* sourceRow = source + static_cast<size_t>(sourceY) * sourceWidth;
+
+                for (int sourceX = columnStarts[x]; sourceX < columnEnds[x]; ++sourceX) {
+                    const QRgb pixel = sourceRow[sourceX];
+                    const quint64 weight = qAlpha(pixel);
+                    alpha += weight;
+                    red += qRed(pixel) * weight;
+                    green += qGreen(pixel) * weight;
+                    blue += qBlue(pixel) * weight;
+                }
+            }
+
+            if (alpha == 0) {
+                row[x] = clearPixel;
+                continue;
+            }
+
+            const quint64 count = static_cast<quint64>(rowEnds[y] - rowStarts[y]) * (columnEnds[x] - columnStarts[x]);
+            row[x] = qRgba(static_cast<int>((red + alpha / 2) / alpha),
+                           static_cast<int>((green + alpha / 2) / alpha),
+                           static_cast<int>((blue + alpha / 2) / alpha),
+                           static_cast<int>((alpha + count / 2) / count));
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Copies a frame onto a transparent canvas of another size with its top-left pixel at an offset.
+ */
+static Frame placeFrame(const Frame& frame, int height, int width, QPoint offset) {
+    const int sourceWidth = frame.getWidth();
+    const QRect kept = QRect(offset, QSize(sourceWidth, frame.getHeight())) & QRect(0, 0, width, height);
+
+    Frame result = Frame::allocate(height, width);
+    const QRgb* source = frame.constScanLine(0);
+    QRgb* target = result.scanLine(0);
+
+    // Every target pixel is written once: either cleared or copied from the kept area
+    for (int y = 0; y < height; ++y) {
+        QRgb* row = target + static_cast<size_t>(y) * width;
+
+        if (kept.isEmpty() || y < kept.top() || y > kept.bottom()) {
+            std::fill_n(row, width, clearPixel);
+            continue;
+        }
+
+        const QRgb* sourceRow = source + static_cast<size_t>(y - offset.y()) * sourceWidth + (kept.left() - offset.x());
+        std::fill_n(row, kept.left(), clearPixel);
+        memcpy(row + kept.left(), sourceRow, static_cast<size_t>(kept.width()) * sizeof(QRgb));
+        std::fill_n(row + kept.right() + 1, width - kept.right() - 1, clearPixel);
+    }
+    return result;
+}
+
+QPoint SpriteResampler::anchorOffset(QSize from, QSize to, Anchor anchor) {
+    const int column = anchor % 3;
+    const int row = anchor / 3;
+    return QPoint((to.width() - from.width()) * column / 2, (to.height() - from.height()) * row / 2);
+}
+
+Frame SpriteResampler::resizeCanvas(const Frame& frame, int height, int width, Anchor anchor) {
+    if (height <= 0 || width <= 0) {
+        qWarning() << "SpriteResampler::resizeCanvas: invalid size" << width << "x" << height;
+        return frame;
+    }
+
+    const QPoint offset = anchorOffset(QSize(frame.getWidth(), frame.getHeight()), QSize(width, height), anchor);
+    return placeFrame(frame, height, width, offset);
+}
+
+Frame SpriteResampler::translate(const Frame& frame, QPoint offset) {
+    return placeFrame(frame, frame.getHeight(), frame.getWidth(), offset);
+}
+
+Frame SpriteResampler::scale(const Frame& frame, int height, int width, Method method) {
+    if (height <= 0 || width <= 0) {
+        qWarning() << "SpriteResampler::scale: invalid size" << width << "x" << height;
+        return frame;
+    }
+
+    if (frame.getHeight() <= 0 || frame.getWidth() <= 0) {
+        return Frame(height, width);
+    }
+
+    switch (method) {
+    case Scale2x:
+        return scalePixelArt(frame, height, width, 2);
+    case Scale3x:
+        return scalePixelArt(frame, height, width, 3);
+    case Box:
+        return scaleBox(frame, height, width);
+    case Nearest:
+        break;
+    }
+    return scaleNearest(frame, height, width);
+}
@@ -0,0 +1,101 @@
+#ifndef SPRITERESAMPLER_H
+#define SPRITERESAMPLER_H
+
+/**
+ * @file spriteresampler.h
+ * @brief Declares the SpriteResampler class, which resizes the canvas of a frame, moves or scales its pixels.
+ *
+ * Every operation reads the frame's packed row-major buffer directly and writes a newly allocated
+ * frame exactly once per pixel, so nothing is cleared first and no QImage is involved.
+ *
+ * @date 03/31/2025
+ */
+
+#include "frame.h"
+
+#include <QPoint>
+#include <QSize>
+
+/**
+ * @class SpriteResampler
+ *
+ * @brief Canvas resizing and pixel-art aware scaling of single frames.
+ *
+ * The functions are reentrant, so FrameManager runs them on many frames at once.
+ */
+class SpriteResampler {
+
+public:
+
+    /**
+     * @brief Which part of the old canvas stays in place when the canvas is resized.
+     *
+     * Listed row by row, so the anchor's column is anchor % 3 and its row anchor / 3.
+     */
+    enum Anchor {
+        TopLeft,
+        Top,
+        TopRight,
+        Left,
+        Center,
+        Right,
+        BottomLeft,
+        Bottom,
+        BottomRight
+    };
+
+    /**
+     * @brief How pixels are resampled when a frame is scaled.
+     */
+    enum Method {
+        Nearest,    ///< Repeat or drop whole pixels; keeps hard edges at any size.
+        Scale2x,    ///< The EPX / Scale2x upscaler, which rounds off diagonal staircases, applied while it fits.
+        Scale3x,    ///< The Scale3x upscaler, applied while it fits.
+        Box         ///< Average the pixels each target pixel covers; for shrinking.
+    };
+
+    /**
+     * @brief Returns where the old canvas lands on the new one.
+     * @param from The old canvas size.
+     * @param to The new canvas size.
+     * @param anchor The part of the old canvas that stays in place.
+     * @return The position of the old canvas's top-left pixel; negative where it is cropped.
+     */
+    static QPoint anchorOffset(QSize from, QSize to, Anchor anchor);
+
+    /**
+     * @brief Changes the canvas size without scaling the pixels.
+     * @param frame The frame to resize.
+     * @param height The new height.
+     * @param width The new width.
+     * @param anchor The part of the old canvas that stays in place. Added area is transparent.
+     * @return The resized frame.
+     */
+    static Frame resizeCanvas(const Frame& frame, int height, int width, Anchor anchor);
+
+    /**
+     * @brief Moves the pixels within the canvas.
+     * @param frame The frame to move.
+     * @param offset How far to move the pixels. Pixels moved off the canvas are lost; uncovered area is transparent.
+     * @return The moved frame.
+     */
+    static Frame translate(const Frame& frame, QPoint offset);
+
+    /**
+     * @brief Scales the pixels to a new size.
+     *
+     * Scale2x and Scale3x are applied as many times as the result still fits the new size, and
+     * nearest-neighbor sampling covers the rest. Box averages premultiplied colors, so transparent
+     * pixels do not darken their neighbors, and samples the nearest pixel along a growing axis.
+     *
+     * @param frame The frame to scale.
+     * @param height The new height.
+     * @param width The new width.
+     * @param method The resampling method.
+     * @return The scaled frame.
+     */
+    static Frame scale(const Frame& frame, int height, int width, Method method);
+
+};
+
+#endif // SPRITERESAMPLER_H
@@ -0,0 +1,372 @@
+/**
+ * @file spritesheetexporter.cpp
+ * @brief Implementation of the SpriteSheetExporter class for exporting frames as a packed PNG atlas.
+ *
+ * Export runs in four passes: trim and hash every frame in parallel, drop duplicate trimmed images,
+ * pack the unique images with a bottom-left skyline packer, then blit them into the atlas row by row.
+ *
+ * @date 03/31/2025
+ */
+
+#include "spritesheetexporter.h"
+
+#include <QtConcurrent>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QDebug>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+using std::max;
+using std::sort;
+using std::unordered_multimap;
+using std::vector;
+
+/**
+ * @brief Per-frame result of the trimming pass.
+ */
+struct TrimmedFrame {
+    int frameIndex = 0;     // Index of the frame in the FrameManager
+    QRect bounds;           // Opaque bounding box inside the frame
+    quint64 hash = 0;       // Hash of the trimmed pixels, used to find duplicates
+    int uniqueIndex = -1;   // Frame index whose pixels are actually stored in the atlas
+    QPoint atlasPosition;   // Top-left corner of the trimmed image inside the atlas
+};
+
+/**
+ * @brief Bottom-left skyline packer for a bin of fixed width and unbounded height.
+ *
+ * The skyline is a list of horizontal segments describing the current top edge of the packed area.
+ * Each insertion picks the position where the rectangle rests lowest, so packing never fails as long
+ * as the rectangle is no wider than the bin.
+ */
+class SkylinePacker {
+
+public:
+
+    explicit SkylinePacker(int binWidth) : binWidth(binWidth), usedHeight(0) {
+        skyline.push_back({0, 0, binWidth});
+    }
+
+    QPoint insert(int rectWidth, int rectHeight) {
+        int bestIndex = -1;
+        int bestTop = 0;
+        int bestY = 0;
+
+        for (size_t i = 0; i < skyline.size(); ++i) {
+            int y = fit(i, rectWidth);
+
+            if (y >= 0 && (bestIndex < 0 || y + rectHeight < bestTop)) {
+                bestIndex = static_cast<int>(i);
+                bestTop = y + rectHeight;
+                bestY = y;
+            }
+        }
+
+        QPoint position(skyline[bestIndex].x, bestY);
+        addLevel(bestIndex, position.x(), bestY + rectHeight, rectWidth);
+        usedHeight = max(usedHeight, bestTop);
+        return position;
+    }
+
+    int height() const {
+        return usedHeight;
+    }
+
+private:
+
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    vector<Segment> skyline;
+    int binWidth;
+    int usedHeight;
+
+    // Returns the y at which a rectangle starting at segment i would rest, or -1 if it does not fit.
+    int fit(size_t i, int rectWidth) const {
+        if (skyline[i].x + rectWidth > binWidth) {
+            return -1;
+        }
+
+        int y = skyline[i].y;
+        int widthLeft = rectWidth;
+
+        while (widthLeft > 0) {
+            y = max(y, skyline[i].y);
+            widthLeft -= skyline[i].width;
+            ++i;
+        }
+        return y;
+    }
+
+    void addLevel(int index, int x, int top, int rectWidth) {
+        skyline.insert(skyline.begin() + index, {x, top, rectWidth});
+
+        // Shrink or remove the segments now covered by the new one
+        for (size_t i = index + 1; i < skyline.size(); ) {
+            int previousEnd = skyline[i - 1].x + skyline[i - 1].width;
+
+            if (skyline[i].x >= previousEnd) {
+                break;
+            }
+
+            int shrink = previousEnd - skyline[i].x;
+            skyline[i].x += shrink;
+            skyline[i].width -= shrink;
+
+            if (skyline[i].width > 0) {
+                break;
+            }
+            skyline.erase(skyline.begin() + i);
+        }
+
+        // Merge neighbouring segments at the same height
+        for (size_t i = 0; i + 1 < skyline.size(); ) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + i + 1);
+            }
+
+            else {
+                ++i;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Returns true if the trimmed pixels of two frames are identical.
+ */
+static bool sameTrimmedPixels(const Frame& first, const QRect& firstBounds, const Frame& second, const QRect& secondBounds) {
+    if (firstBounds.size() != secondBounds.size()) {
+        return false;
+    }
+
+    size_t rowBytes = static_cast<size_t>(firstBounds.width()) * sizeof(QRgb);
+
+    for (int y = 0; y < firstBounds.height(); ++y) {
+        const QRgb* firstRow = first.constScanLine(firstBounds.top() + y) + firstBounds.left();
+        const QRgb* secondRow = second.constScanLine(secondBounds.top() + y) + secondBounds.left();
+
+        if (memcmp(firstRow, secondRow, rowBytes) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SpriteSheetExporter::SpriteSheetExporter(QObject* parent) : QObject{parent} {}
+
+QRect SpriteSheetExporter::opaqueBounds(const Frame& frame) {
+    int height = frame.getHeight();
+    int width = frame.getWidth();
+    int top = -1;
+    int bottom = -1;
+    int left = width;
+    int right = -1;
+
+    for (int y = 0; y < height; ++y) {
+        const QRgb* row = frame.constScanLine(y);
+
+        // OR the alpha bytes of the whole row together; this branch-free loop vectorizes
+        QRgb alphaBits = 0;
+        for (int x = 0; x < width; ++x) {
+            alphaBits |= row[x];
+        }
+
+        if ((alphaBits & 0xff000000u) == 0) {
+            continue;
+        }
+
+        if (top < 0) {
+            top = y;
+        }
+        bottom = y;
+
+        // Only the columns outside the current box need to be checked
+        for (int x = 0; x < left; ++x) {
+            if (qAlpha(row[x]) != 0) {
+                left = x;
+                break;
+            }
+        }
+
+        for (int x = width - 1; x > right; --x) {
+            if (qAlpha(row[x]) != 0) {
+                right = x;
+                break;
+            }
+        }
+    }
+
+    if (top < 0) {
+        return QRect();
+    }
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+bool SpriteSheetExporter::exportToFile(FrameManager& manager, QString imagePath, QString metadataPath, int padding) {
+    const vector<Frame>& frames = manager.frames;
+
+    if (frames.empty()) {
+        qWarning() << "No frames to export.";
+        return false;
+    }
+
+    vector<TrimmedFrame> trimmed(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        trimmed[i].frameIndex = static_cast<int>(i);
+    }
+
+    // Pass 1: trim and hash every frame on the thread pool
+    QtConcurrent::blockingMap(trimmed, [&frames](TrimmedFrame& entry) {
+        const Frame& frame = frames[entry.frameIndex];
+        entry.bounds = opaqueBounds(frame);
+
+        // Fully transparent frames still need a rectangle, so keep a single pixel
+        if (entry.bounds.isEmpty()) {
+            entry.bounds = QRect(0, 0, 1, 1);
+        }
+
+        size_t seed = qHash(entry.bounds.width()) ^ (qHash(entry.bounds.height()) << 1);
+        size_t rowBytes = static_cast<size_t>(entry.bounds.width()) * sizeof(QRgb);
+
+        for (int y = entry.bounds.top(); y <= entry.bounds.bottom(); ++y) {
+            seed = qHashBits(frame.constScanLine(y) + entry.bounds.left(), rowBytes, seed);
+        }
+        entry.hash = seed;
+    });
+
+    // Pass 2: point every duplicate at the first frame with the same trimmed pixels
+    unordered_multimap<quint64, int> seen;
+    vector<int> uniqueFrames;
+
+    for (TrimmedFrame& entry : trimmed) {
+        auto range = seen.equal_range(entry.hash);
+
+        for (auto it = range.first; it != range.second; ++it) {
+            const TrimmedFrame& candidate = trimmed[it->second];
+
+            if (sameTrimmedPixels(frames[entry.frameIndex], entry.bounds, frames[candidate.frameIndex], candidate.bounds)) {
+                entry.uniqueIndex = candidate.frameIndex;
+                break;
+            }
+        }
+
+        if (entry.uniqueIndex < 0) {
+            entry.uniqueIndex = entry.frameIndex;
+            seen.emplace(entry.hash, entry.frameIndex);
+            uniqueFrames.push_back(entry.frameIndex);
+        }
+    }
+
+    // Pass 3: pack the unique images, tallest first, into a roughly square atlas
+    qint64 totalArea = 0;
+    int widestFrame = 0;
+
+    for (int index : uniqueFrames) {
+        const QRect& bounds = trimmed[index].bounds;
+        totalArea += static_cast<qint64>(bounds.width() + padding) * (bounds.height() + padding);
+        widestFrame = max(widestFrame, bounds.width() + padding);
+    }
+
+    sort(uniqueFrames.begin(), uniqueFrames.end(), [&trimmed](int a, int b) {
+        return trimmed[a].bounds.height() > trimmed[b].bounds.height();
+    });
+
+    int binWidth = max(widestFrame, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(totalArea)))));
+    SkylinePacker packer(binWidth);
+
+    for (int index : uniqueFrames) {
+        const QRect& bounds = trimmed[index].bounds;
+        trimmed[index].atlasPosition = packer.insert(bounds.width() + padding, bounds.height() + padding);
+    }
+
+    for (TrimmedFrame& entry : trimmed) {
+        entry.atlasPosition = trimmed[entry.uniqueIndex].atlasPosition;
+    }
+
+    // Pass 4: copy the trimmed rows into the atlas
+    QImage atlas(binWidth, max(1, packer.height()), QImage::Format_ARGB32);
+    atlas.fill(Qt::transparent);
+
+    for (int index : uniqueFrames) {
+        const Frame& frame = frames[index];
+        const TrimmedFrame& entry = trimmed[index];
+        size_t rowBytes = static_cast<size_t>(entry.bounds.width()) * sizeof(QRgb);
+
+        for (int y = 0; y < entry.bounds.height(); ++y) {
+            QRgb* target = reinterpret_cast<QRgb*>(atlas.scanLine(entry.atlasPosition.y() + y)) + entry.atlasPosition.x();
+            memcpy(target, frame.constScanLine(entry.bounds.top() + y) + entry.bounds.left(), rowBytes);
+        }
+    }
+
+    // Encode the PNG on a worker thread while the metadata is written here
+    QFuture<bool> imageSaved = QtConcurrent::run([atlas, imagePath]() {
+        return atlas.save(imagePath, "PNG");
+    });
+
+    QFile metadataFile(metadataPath);
+    bool metadataSaved = metadataFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+    if (!metadataSaved) {
+        qWarning() << "Failed to open file for writing:" << metadataPath;
+    }
+
+    else if (metadataPath.endsWith(".csv", Qt::CaseInsensitive)) {
+        QTextStream out(&metadataFile);
+        out << "index,x,y,w,h,offsetX,offsetY,sourceW,sourceH,duplicateOf\n";
+
+        for (const TrimmedFrame& entry : trimmed) {
+            out << entry.frameIndex << ','
+                << entry.atlasPosition.x() << ',' << entry.atlasPosition.y() << ','
+                << entry.bounds.width() << ',' << entry.bounds.height() << ','
+                << entry.bounds.left() << ',' << entry.bounds.top() << ','
+                << manager.width << ',' << manager.height << ','
+                << entry.uniqueIndex << '\n';
+        }
+    }
+
+    else {
+        QJsonArray framesArray;
+
+        for (const TrimmedFrame& entry : trimmed) {
+            QJsonObject frameObj;
+            frameObj["index"] = entry.frameIndex;
+            frameObj["x"] = entry.atlasPosition.x();
+            frameObj["y"] = entry.atlasPosition.y();
+            frameObj["w"] = entry.bounds.width();
+            frameObj["h"] = entry.bounds.height();
+            frameObj["offsetX"] = entry.bounds.left();
+            frameObj["offsetY"] = entry.bounds.top();
+            frameObj["duplicateOf"] = entry.uniqueIndex;
+            framesArray.append(frameObj);
+        }
+
+        QJsonObject root;
+        root["image"] = QFileInfo(imagePath).fileName();
+        root["width"] = atlas.width();
+        root["height"] = atlas.height();
+        root["sourceWidth"] = manager.width;
+        root["sourceHeight"] = manager.height;
+        root["frames"] = framesArray;
+        metadataFile.write(QJsonDocument(root).toJson());
+    }
+    metadataFile.close();
+
+    if (!imageSaved.result()) {
+        qWarning() << "Failed to write sprite sheet image:" << imagePath;
+        return false;
+    }
+    return metadataSaved;
+}
@@ -0,0 +1,61 @@
+#ifndef SPRITESHEETEXPORTER_H
+#define SPRITESHEETEXPORTER_H
+
+/**
+ * @file spritesheetexporter.h
+ * @brief Declaration of the SpriteSheetExporter class, which packs every frame into a single PNG atlas.
+ *
+ * Each frame is trimmed to its opaque bounding box, identical trimmed frames are stored once, and the
+ * remaining images are packed with a skyline packer. A JSON or CSV file describes where every frame
+ * landed so a game engine can slice the atlas back into frames.
+ *
+ * @date 03/31/2025
+ */
+
+#include "framemanager.h"
+
+#include <QObject>
+#include <QRect>
+#include <QString>
+
+/**
+ * @class SpriteSheetExporter
+ *
+ * @brief Exports all frames of a FrameManager as a trimmed, packed sprite-sheet atlas plus metadata.
+ */
+class SpriteSheetExporter : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructs a SpriteSheetExporter instance.
+     * @param parent Optional parent QObject.
+     */
+    explicit SpriteSheetExporter(QObject* parent = nullptr);
+
+    /**
+     * @brief Writes the atlas image and its frame metadata to disk.
+     *
+     * The metadata format is chosen from the extension of metadataPath: ".csv" writes one row per
+     * frame, anything else writes JSON. Trimming and hashing run on the global thread pool and the
+     * PNG is encoded on a worker thread while the metadata is being written.
+     *
+     * @param manager Reference to the FrameManager containing the frames to export.
+     * @param imagePath Target path of the PNG atlas.
+     * @param metadataPath Target path of the JSON or CSV metadata file.
+     * @param padding Number of transparent pixels left between packed frames.
+     * @return true if both files were written successfully; false otherwise.
+     */
+    bool exportToFile(FrameManager& manager, QString imagePath, QString metadataPath, int padding = 1);
+
+    /**
+     * @brief Finds the smallest rectangle containing every pixel with a non-zero alpha.
+     * @param frame The frame to scan.
+     * @return The opaque bounding box, or an empty QRect if the frame is fully transparent.
+     */
+    static QRect opaqueBounds(const Frame& frame);
+
+};
+
+#endif // SPRITESHEETEXPORTER_H
@@ -0,0 +1,246 @@
+/**
+ * @file thumbnailcache.cpp
+ * @brief Implementation of the ThumbnailCache class.
+ *
+ * The worker gets shared copies of the frames it visits and of the cache, so it never touches state the
+ * GUI thread changes. Its results come back as queued calls, which Qt drops if the cache is destroyed.
+ * A new refresh never waits for the old one: it is started from the worker's finished signal instead.
+ *
+ * @date 03/31/2025
+ */
+
+#include "thumbnailcache.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+
+ThumbnailCache::ThumbnailCache(FrameManager* frameManager, QSize thumbnailSize, QObject* parent) :
+    QObject(parent),
+    frameManager(frameManager),
+    thumbnailSize(thumbnailSize)
+{
+    // Give back memory before the frame manager starts compressing frames. Checked on this thread the call is
+    // immediate; checked on another it is queued, so entries are only ever touched here
+    connect(frameManager,
+            &FrameManager::memoryBudgetExceeded,
+            this,
+            &ThumbnailCache::trim
+    );
+
+    // Start the refresh requested while the worker was busy once it has stopped
+    connect(&worker,
+            &QFutureWatcher<void>::finished,
+            this,
+            &ThumbnailCache::startPendingRefresh
+    );
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    currentRefresh++;
+    worker.waitForFinished();
+}
+
+qint64 ThumbnailCache::memoryBytes() const {
+    return cachedBytes;
+}
+
+QImage ThumbnailCache::render(const Frame& frame, QSize size) {
+    int width = frame.getWidth();
+    int height = frame.getHeight();
+
+    if (width <= 0 || height <= 0 || size.isEmpty()) {
+        return QImage();
+    }
+
+    double scale = std::min(static_cast<double>(size.width()) / width, static_cast<double>(size.height()) / height);
+    int thumbnailWidth = std::max(1, static_cast<int>(std::lround(width * scale)));
+    int thumbnailHeight = std::max(1, static_cast<int>(std::lround(height * scale)));
+    QImage thumbnail(thumbnailWidth, thumbnailHeight, QImage::Format_ARGB32);
+
+    for (int y = 0; y < thumbnailHeight; ++y) {
+        const QRgb* source = frame.constScanLine(static_cast<int>(static_cast<qint64>(y) * height / thumbnailHeight));
+        QRgb* target = reinterpret_cast<QRgb*>(thumbnail.scanLine(y));
+
+        for (int x = 0; x < thumbnailWidth; ++x) {
+            target[x] = source[static_cast<qint64>(x) * width / thumbnailWidth];
+        }
+    }
+    return thumbnail;
+}
+
+void ThumbnailCache::refresh(int firstFrame, int lastFrame) {
+
+    // The running worker stops after the frame it is on; only the latest request is kept
+    currentRefresh++;
+    pendingFirst = firstFrame;
+    pendingLast = lastFrame;
+    refreshPending = true;
+    startPendingRefresh();
+}
+
+void ThumbnailCache::startPendingRefresh() {
+    if (!refreshPending || worker.isRunning()) {
+        return;
+    }
+
+    refreshPending = false;
+    int refreshId = currentRefresh.load();
+
+    const vector<Frame>& allFrames = frameManager->frames;
+    int frameCount = static_cast<int>(allFrames.size());
+    int firstFrame = (pendingFirst >= 0 && pendingFirst < frameCount) ? pendingFirst : 0;
+    int visitCount = (pendingLast >= firstFrame) ? qMin(pendingLast, frameCount - 1) - firstFrame + 1 : frameCount;
+
+    // Only the frames to visit are copied, in visiting order; the cache and the shown hashes are shared
+    vector<Frame> frames;
+    vector<FrameManager::FrameId> ids;
+    frames.reserve(visitCount);
+    ids.reserve(visitCount);
+
+    for (int step = 0; step < visitCount; ++step) {
+        int frameIndex = (firstFrame + step) % frameCount;
+        frames.push_back(allFrames[frameIndex]);
+        ids.push_back(frameManager->frameId(frameIndex));
+    }
+
+    worker.setFuture(QtConcurrent::run([this, refreshId, frames, ids, cached = entries, shown = shown, size = thumbnailSize]() {
+        vector<quint64> hashes;
+        hashes.reserve(frames.size());
+
+        for (size_t i = 0; i < frames.size(); ++i) {
+            if (currentRefresh.load() != refreshId) {
+                return;
+            }
+
+            FrameManager::FrameId frameId = ids[i];
+            quint64 hash = frames[i].contentHash();
+            hashes.push_back(hash);
+
+            // The thumbnail on show is already of this content
+            if (shown.value(frameId) == hash) {
+                continue;
+            }
+
+            QImage thumbnail = cached.value(hash).image;
+
+            if (thumbnail.isNull()) {
+                thumbnail = render(frames[i], size);
+            }
+
+            QMetaObject::invokeMethod(this, [this, refreshId, frameId, hash, thumbnail]() {
+                deliver(refreshId, frameId, hash, thumbnail);
+            }, Qt::QueuedConnection);
+        }
+
+        QMetaObject::invokeMethod(this, [this, refreshId, hashes]() {
+            finishRefresh(refreshId, hashes);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void ThumbnailCache::forgetShown() {
+    shown.clear();
+}
+
+void ThumbnailCache::trim(qint64 bytes) {
+    vector<std::pair<int, quint64>> order;
+    order.reserve(entries.size());
+
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+        order.emplace_back(it->lastUsed, it.key());
+    }
+    std::sort(order.begin(), order.end());
+
+    // Thumbnails already shown stay on screen; the cache only forgets them
+    qint64 freed = 0;
+
+    for (const std::pair<int, quint64>& entry : order) {
+        if (freed >= bytes) {
+            break;
+        }
+
+        qint64 size = entries.value(entry.second).image.sizeInBytes();
+        entries.remove(entry.second);
+        freed += size;
+        cachedBytes -= size;
+    }
+    reportUsage();
+}
+
+void ThumbnailCache::deliver(int refreshId, FrameManager::FrameId frameId, quint64 hash, const QImage& thumbnail) {
+    Entry& entry = entries[hash];
+
+    if (entry.image.isNull()) {
+        entry.image = thumbnail;
+        cachedBytes += thumbnail.sizeInBytes();
+        reportUsage();
+    }
+    entry.lastUsed = refreshId;
+
+    // An abandoned refresh may have rendered content that has changed since
+    if (refreshId != currentRefresh.load()) {
+        return;
+    }
+
+    // The frame may have moved since the refresh started, or been deleted
+    int frameIndex = frameManager->indexOfFrame(frameId);
+
+    if (frameIndex < 0) {
+        return;
+    }
+    shown.insert(frameId, hash);
+
+    emit thumbnailReady(frameIndex, thumbnail);
+}
+
+void ThumbnailCache::finishRefresh(int refreshId, const vector<quint64>& hashes) {
+    for (quint64 hash : hashes) {
+        auto it = entries.find(hash);
+
+        if (it != entries.end()) {
+            it->lastUsed = refreshId;
+        }
+    }
+
+    if (refreshId != currentRefresh.load()) {
+        return;
+    }
+
+    // Forget deleted frames
+    QHash<FrameManager::FrameId, quint64> current;
+
+    for (FrameManager::FrameId frameId : frameManager->frameOrder()) {
+        auto it = shown.constFind(frameId);
+
+        if (it != shown.constEnd()) {
+            current.insert(frameId, it.value());
+        }
+    }
+    shown = current;
+
+    // Keep a few recent thumbnails for undo, but not one per stroke forever
+    if (entries.size() > static_cast<qsizetype>(hashes.size()) + maximumStaleEntries) {
+        vector<std::pair<int, quint64>> stale;
+
+        for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+            if (it->lastUsed != refreshId) {
+                stale.emplace_back(it->lastUsed, it.key());
+            }
+        }
+        std::sort(stale.begin(), stale.end());
+
+        size_t excess = stale.size() > static_cast<size_t>(maximumStaleEntries) ? stale.size() - maximumStaleEntries : 0;
+
+        for (size_t i = 0; i < excess; ++i) {
+            cachedBytes -= entries.value(stale[i].second).image.sizeInBytes();
+            entries.remove(stale[i].second);
+        }
+    }
+    reportUsage();
+}
+
+void ThumbnailCache::reportUsage() {
+    frameManager->reportCacheUsage("thumbnails", cachedBytes);
+}
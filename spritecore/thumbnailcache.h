@@ -0,0 +1,195 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+/**
+ * @file thumbnailcache.h
+ * @brief Declaration of the ThumbnailCache class, which renders small previews of frames in the background.
+ * @date 03/31/2025
+ */
+
+#include "frame.h"
+#include "framemanager.h"
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+
+#include <atomic>
+
+using std::vector;
+
+/**
+ * @class ThumbnailCache
+ *
+ * @brief Renders a thumbnail per frame on a worker thread and caches it by the frame's content.
+ *
+ * Frame::contentHash() serves as the frame's version: a thumbnail is only rendered for content that
+ * has not been seen before, and identical frames share one. Thumbnails are delivered one at a time
+ * through thumbnailReady() as they are done, for all frames or a range of them such as the visible rows,
+ * and only for frames whose shown thumbnail is out of date.
+ *
+ * The cache reports its size to the FrameManager and drops the least recently used thumbnails when
+ * the memory budget is exceeded.
+ */
+class ThumbnailCache : public QObject {
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Thumbnails no current frame uses that are kept for undo and redo.
+     */
+    static constexpr int maximumStaleEntries = 256;
+
+    /**
+     * @brief Constructs a ThumbnailCache for the frames of a sprite.
+     * @param frameManager The frames to render.
+     * @param thumbnailSize The box thumbnails are scaled to fit, keeping the aspect ratio.
+     * @param parent Optional parent QObject.
+     */
+    ThumbnailCache(FrameManager* frameManager, QSize thumbnailSize, QObject* parent = nullptr);
+
+    /**
+     * @brief Stops the worker and waits for it.
+     */
+    ~ThumbnailCache();
+
+    /**
+     * @brief Returns the memory held by cached thumbnails.
+     * @return The size of all cached images in bytes.
+     */
+    qint64 memoryBytes() const;
+
+    /**
+     * @brief Scales a frame down or up to fit a box, sampling the nearest pixel.
+     *
+     * Only the pixels that end up in the thumbnail are read, so the cost does not depend on the frame size.
+     *
+     * @param frame The frame to render.
+     * @param size The box to fit.
+     * @return An ARGB32 image no larger than size.
+     */
+    static QImage render(const Frame& frame, QSize size);
+
+public slots:
+
+    /**
+     * @brief Brings the thumbnails of a range of frames, or of all frames, up to date in the background.
+     *
+     * A refresh still running is abandoned without waiting for it; this one starts once the worker has
+     * stopped, with the frames as they are then. Without a last frame, frames are visited from firstFrame to
+     * the end, then from the start, so passing the first visible row shows those thumbnails first.
+     * Passing the last visible row as well renders only the rows on screen, which keeps long
+     * animations cheap to scroll through.
+     *
+     * @param firstFrame Index of the frame to start with.
+     * @param lastFrame Index of the last frame to visit, or -1 for all frames.
+     */
+    void refresh(int firstFrame = 0, int lastFrame = -1);
+
+    /**
+     * @brief Forgets which thumbnails are shown, so the next refresh delivers every frame again.
+     */
+    void forgetShown();
+
+    /**
+     * @brief Drops the least recently used thumbnails.
+     * @param bytes How many bytes to free.
+     */
+    void trim(qint64 bytes);
+
+signals:
+
+    /**
+     * @brief Signal emitted when a frame's thumbnail is ready or has changed.
+     * @param frameIndex The index of the frame.
+     * @param thumbnail The frame's thumbnail.
+     */
+    void thumbnailReady(int frameIndex, const QImage& thumbnail);
+
+private:
+
+    /**
+     * @brief A cached thumbnail.
+     */
+    struct Entry {
+        QImage image;
+        int lastUsed = 0;
+    };
+
+    /**
+     * @brief Starts the latest requested refresh on the worker, unless the worker is still busy.
+     */
+    void startPendingRefresh();
+
+    /**
+     * @brief Stores a thumbnail from the worker and emits it if its refresh is still current.
+     */
+    void deliver(int refreshId, FrameManager::FrameId frameId, quint64 hash, const QImage& thumbnail);
+
+    /**
+     * @brief Marks the thumbnails used by a finished refresh and drops old unused ones.
+     */
+    void finishRefresh(int refreshId, const vector<quint64>& hashes);
+
+    /**
+     * @brief Tells the FrameManager how much memory the cache holds.
+     */
+    void reportUsage();
+
+    /**
+     * @brief The frames rendered.
+     */
+    FrameManager* frameManager;
+
+    /**
+     * @brief The box thumbnails fit in.
+     */
+    QSize thumbnailSize;
+
+    /**
+     * @brief Thumbnails by frame content hash.
+     */
+    QHash<quint64, Entry> entries;
+
+    /**
+     * @brief Content hash of the thumbnail last delivered for each frame, by frame ID.
+     *
+     * Keyed by ID rather than position, so moving, inserting or deleting frames keeps it valid.
+     */
+    QHash<FrameManager::FrameId, quint64> shown;
+
+    /**
+     * @brief Identifies the current refresh; the worker stops once it changes.
+     */
+    std::atomic<int> currentRefresh{0};
+
+    /**
+     * @brief The running or last refresh; only one runs at a time.
+     */
+    QFutureWatcher<void> worker;
+
+    /**
+     * @brief Whether a refresh was requested that has not started yet.
+     */
+    bool refreshPending = false;
+
+    /**
+     * @brief The first frame of the requested refresh.
+     */
+    int pendingFirst = 0;
+
+    /**
+     * @brief The last frame of the requested refresh, or -1 for all frames.
+     */
+    int pendingLast = -1;
+
+    /**
+     * @brief Size of all cached images in bytes.
+     */
+    qint64 cachedBytes = 0;
+};
+
+#endif // THUMBNAILCACHE_H
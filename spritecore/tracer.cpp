@@ -0,0 +1,136 @@
+/**
+ * @file tracer.cpp
+ * @brief Implementation of the Tracer class: per-thread ring buffers and Chrome trace export.
+ *
+ * Each thread lazily creates its own buffer the first time it records a span. Only that first
+ * registration takes a lock; recording afterwards is a plain store plus an atomic index update.
+ * Buffers are never freed, so exporting stays safe after worker threads exit.
+ *
+ * @date 03/31/2025
+ */
+
+#include "tracer.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using std::vector;
+
+/**
+ * @brief Number of spans each thread keeps before overwriting the oldest.
+ */
+static const quint64 ringCapacity = 16384;
+
+/**
+ * @brief One recorded span.
+ */
+struct TraceEvent {
+    const char* name;
+    qint64 start;
+    qint64 duration;
+};
+
+/**
+ * @brief Ring buffer of spans written by a single thread.
+ */
+struct ThreadTraceBuffer {
+    int threadId = 0;
+    std::atomic<quint64> written{0};
+    vector<TraceEvent> events = vector<TraceEvent>(ringCapacity);
+};
+
+/**
+ * @brief Every buffer ever created, guarded by registryMutex.
+ */
+static QMutex registryMutex;
+static vector<std::unique_ptr<ThreadTraceBuffer>> registry;
+
+/**
+ * @brief The calling thread's buffer, registered on first use.
+ */
+static ThreadTraceBuffer* threadBuffer() {
+    thread_local ThreadTraceBuffer* buffer = nullptr;
+
+    if (!buffer) {
+        QMutexLocker locker(&registryMutex);
+        registry.push_back(std::make_unique<ThreadTraceBuffer>());
+        buffer = registry.back().get();
+        buffer->threadId = static_cast<int>(registry.size());
+    }
+    return buffer;
+}
+
+/**
+ * @brief Time origin of the trace clock.
+ */
+static const std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
+
+bool Tracer::isEnabled() {
+#ifdef SPRITE_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+qint64 Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - clockStart).count();
+}
+
+void Tracer::record(const char* name, qint64 startNanoseconds, qint64 endNanoseconds) {
+    ThreadTraceBuffer* buffer = threadBuffer();
+    quint64 index = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[index % ringCapacity] = {name, startNanoseconds, endNanoseconds - startNanoseconds};
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+bool Tracer::exportChromeTrace(QString filePath) {
+    QJsonArray traceEvents;
+
+    {
+        QMutexLocker locker(&registryMutex);
+
+        for (const std::unique_ptr<ThreadTraceBuffer>& buffer : registry) {
+            quint64 written = buffer->written.load(std::memory_order_acquire);
+            quint64 first = (written > ringCapacity) ? written - ringCapacity : 0;
+
+            for (quint64 i = first; i < written; ++i) {
+                const TraceEvent& event = buffer->events[i % ringCapacity];
+
+                // Complete ("X") events use microseconds
+                QJsonObject eventObj;
+                eventObj["name"] = QString::fromLatin1(event.name);
+                eventObj["ph"] = "X";
+                eventObj["ts"] = event.start / 1000.0;
+                eventObj["dur"] = event.duration / 1000.0;
+                eventObj["pid"] = 1;
+                eventObj["tid"] = buffer->threadId;
+                traceEvents.append(eventObj);
+            }
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open file for writing:" << filePath;
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.close();
+    return true;
+}
@@ -0,0 +1,114 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+/**
+ * @file tracer.h
+ * @brief Declares the Tracer class and TRACE_SCOPE macro for lightweight hot-path tracing.
+ *
+ * A TRACE_SCOPE("name") statement records how long the rest of the enclosing block takes. Spans go
+ * into a fixed-size ring buffer owned by the recording thread, so recording never takes a lock, and
+ * can be exported as Chrome trace_event JSON (open it in chrome://tracing or Perfetto).
+ *
+ * Tracing is compiled in when SPRITE_TRACING is defined: always in debug builds, and in release
+ * builds configured with "qmake CONFIG+=tracing". Otherwise TRACE_SCOPE expands to nothing.
+ *
+ * @date 03/31/2025
+ */
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @class Tracer
+ *
+ * @brief Collects timed spans from every thread and writes them out as a Chrome trace.
+ */
+class Tracer {
+
+public:
+
+    /**
+     * @brief Returns whether tracing was compiled into this build.
+     * @return true if SPRITE_TRACING is defined.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Returns the current time on the trace clock.
+     * @return Nanoseconds since the trace clock started.
+     */
+    static qint64 now();
+
+    /**
+     * @brief Appends a finished span to the calling thread's ring buffer.
+     *
+     * When the buffer is full the oldest span is overwritten.
+     *
+     * @param name Span name; must be a string literal or otherwise outlive the tracer.
+     * @param startNanoseconds Start time from now().
+     * @param endNanoseconds End time from now().
+     */
+    static void record(const char* name, qint64 startNanoseconds, qint64 endNanoseconds);
+
+    /**
+     * @brief Writes every recorded span as Chrome trace_event JSON.
+     *
+     * Spans still being recorded by other threads while exporting may be missing or torn, so export
+     * when the editor is idle.
+     *
+     * @param filePath Target path of the .json file.
+     * @return true if the file was written successfully; false otherwise.
+     */
+    static bool exportChromeTrace(QString filePath);
+
+};
+
+/**
+ * @class TraceScope
+ *
+ * @brief Records a span from its construction to its destruction. Use through TRACE_SCOPE.
+ */
+class TraceScope {
+
+public:
+
+    /**
+     * @brief Starts a span.
+     * @param name Span name; must be a string literal.
+     */
+    explicit TraceScope(const char* name) : name(name), start(Tracer::now()) {}
+
+    /**
+     * @brief Ends the span and records it.
+     */
+    ~TraceScope() {
+        Tracer::record(name, start, Tracer::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+
+    /**
+     * @brief Name of the span.
+     */
+    const char* name;
+
+    /**
+     * @brief Start time of the span on the trace clock.
+     */
+    qint64 start;
+
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef SPRITE_TRACING
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) do {} while (false)
+#endif
+
+#endif // TRACER_H
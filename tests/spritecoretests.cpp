@@ -0,0 +1,845 @@
+/**
+ * @file spritecoretests.cpp
+ * @brief QTest checks of spritecore behavior: shared frames, undo by frame ID, save/load round trips, playback timing,
+ * the drawing tools, resampling, in-betweens, and GIF, sprite-sheet and image import/export.
+ *
+ * Run with `make check` from the build directory, or run spritecoretests directly.
+ *
+ * @date 03/31/2025
+ */
+
+#include "brushstamp.h"
+#include "floodfill.h"
+#include "frame.h"
+#include "framelistmodel.h"
+#include "framemanager.h"
+#include "gifexporter.h"
+#include "imageimporter.h"
+#include "inbetweengenerator.h"
+#include "pixelblend.h"
+#include "pixelblit.h"
+#include "playbacktimeline.h"
+#include "saveloadmanager.h"
+#include "shaperasterizer.h"
+#include "spriteresampler.h"
+#include "spritesheetexporter.h"
+
+#include <QAbstractItemModelTester>
+#include <QFile>
+#include <QImageReader>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <QtTest>
+
+#include <algorithm>
+
+/**
+ * @brief Builds a small project of three frames where the last repeats the first and two have their own duration.
+ */
+static void fillProject(FrameManager& manager) {
+    Frame first(manager.height, manager.width);
+    first.updateFrame(0, 0, 255, 0, 0, 255);
+    first.updateFrame(manager.height - 1, manager.width - 1, 0, 0, 255, 128);
+
+    Frame second(manager.height, manager.width);
+    second.updateFrame(1, 2, 0, 255, 0, 255);
+
+    manager.addFrameJson(first);
+    manager.addFrameJson(second);
+    manager.addFrameJson(first);
+    manager.setFrameDuration(0, 120);
+    manager.setFrameDuration(2, 40);
+}
+
+/**
+ * @brief Checks that a loaded project matches the one fillProject() builds, down to the shared repeat.
+ */
+static void verifyProject(const FrameManager& original, const FrameManager& loaded) {
+    QCOMPARE(loaded.height, original.height);
+    QCOMPARE(loaded.width, original.width);
+    QCOMPARE(loaded.frames.size(), original.frames.size());
+
+    for (size_t i = 0; i < original.frames.size(); ++i) {
+        QVERIFY2(loaded.frames[i].hasSamePixels(original.frames[i]), qPrintable(QString("frame %1").arg(i)));
+    }
+
+    QVERIFY(loaded.frameDurations() == original.frameDurations());
+    QCOMPARE(loaded.frames[2].storageKey(), loaded.frames[0].storageKey());
+}
+
+/**
+ * @brief Builds a version 3 binary .ssp header followed by some pixel bytes, for files that lie about their size.
+ */
+static QByteArray binaryHeader(qint32 height, qint32 width, quint32 frameCount, quint32 uniqueCount, int trailingBytes) {
+    QByteArray data("SSPB");
+    uchar header[20];
+    qToLittleEndian<quint32>(3, header);
+    qToLittleEndian<qint32>(height, header + 4);
+    qToLittleEndian<qint32>(width, header + 8);
+    qToLittleEndian<quint32>(frameCount, header + 12);
+    qToLittleEndian<quint32>(uniqueCount, header + 16);
+    data.append(reinterpret_cast<const char*>(header), sizeof(header));
+    data.append(QByteArray(trailingBytes, '\0'));
+    return data;
+}
+
+/**
+ * @brief Makes an ARGB32 image filled with one color.
+ */
+static QImage filledImage(int width, int height, QRgb color) {
+    QImage image(width, height, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+/**
+ * @brief Builds a frame from rows of pixels, top to bottom.
+ */
+static Frame frameFromRows(const vector<vector<QRgb>>& rows) {
+    Frame frame = Frame::allocate(static_cast<int>(rows.size()), static_cast<int>(rows.front().size()));
+
+    for (size_t y = 0; y < rows.size(); ++y) {
+        std::copy(rows[y].begin(), rows[y].end(), frame.scanLine(static_cast<int>(y)));
+    }
+    return frame;
+}
+
+/**
+ * @brief Counts the pixels covered by a list of spans.
+ */
+static int spanPixels(const vector<PixelSpan>& spans) {
+    int count = 0;
+
+    for (const PixelSpan& span : spans) {
+        count += span.right - span.left + 1;
+    }
+    return count;
+}
+
+/**
+ * @class SpriteCoreTests
+ *
+ * @brief Behavior checks for the spritecore classes.
+ */
+class SpriteCoreTests : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void frameCopyOnWrite() {
+        Frame original(4, 4);
+        Frame copy = original;
+        QVERIFY(copy.isShared());
+        QCOMPARE(copy.storageKey(), original.storageKey());
+
+        // Writing to the copy detaches it and leaves the original untouched
+        copy.updateFrame(1, 1, 10, 20, 30, 255);
+        QVERIFY(!original.isShared());
+        QCOMPARE(copy.constScanLine(1)[1], qRgba(10, 20, 30, 255));
+        QCOMPARE(original.constScanLine(1)[1], qRgba(255, 255, 255, 0));
+    }
+
+    void undoFollowsMovedFrame() {
+        FrameManager manager(4, 4);
+        manager.addFrame();
+        manager.addFrame();
+        FrameManager::FrameId edited = manager.frameId(0);
+
+        manager.beginUndoStep("Draw");
+        manager.updateFrame(0, 2, 3, 1, 2, 3, 255);
+        manager.endUndoStep();
+
+        // The step is kept by frame ID, so it still applies after the frame moved to the end
+        QVERIFY(manager.moveFrames(0, 0, 2));
+        QCOMPARE(manager.indexOfFrame(edited), 1);
+
+        manager.undo();
+        QCOMPARE(manager.frames[1].constScanLine(2)[3], qRgba(255, 255, 255, 0));
+
+        manager.redo();
+        QCOMPARE(manager.frames[1].constScanLine(2)[3], qRgba(1, 2, 3, 255));
+    }
+
+    void frameListModelFollowsManager() {
+        FrameManager manager(4, 4);
+        manager.addFrame();
+        FrameListModel model(&manager);
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+
+        // Row changes begin before the frames change, so the tester sees the old rows until each one ends
+        manager.addFrame();
+        manager.insertFrame(0);
+        QCOMPARE(model.rowCount(), 3);
+        QCOMPARE(inserted.count(), 2);
+
+        QVERIFY(manager.moveFrames(0, 0, 3));
+        QCOMPARE(moved.count(), 1);
+
+        manager.deleteFrame(1);
+        QCOMPARE(model.rowCount(), 2);
+
+        manager.clearFrames();
+        QCOMPARE(model.rowCount(), 0);
+    }
+
+    void binaryRoundTrip() {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("project.ssp");
+
+        FrameManager original(5, 7);
+        fillProject(original);
+        SaveLoadManager saveLoadManager;
+        QVERIFY(saveLoadManager.saveToBinaryFile(original, path));
+        QCOMPARE(saveLoadManager.lastSaveDedup().uniqueFrameCount, 2);
+
+        QStringList problems;
+        QVERIFY2(saveLoadManager.validateFile(path, problems), qPrintable(problems.join("; ")));
+
+        FrameManager loaded(0, 0);
+        QVERIFY(saveLoadManager.loadFromFile(loaded, path));
+        verifyProject(original, loaded);
+    }
+
+    void jsonRoundTrip() {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("project.ssp");
+
+        FrameManager original(5, 7);
+        fillProject(original);
+        SaveLoadManager saveLoadManager;
+        QVERIFY(saveLoadManager.saveToFile(original, path));
+
+        QStringList problems;
+        QVERIFY2(saveLoadManager.validateFile(path, problems), qPrintable(problems.join("; ")));
+
+        FrameManager loaded(0, 0);
+        QVERIFY(saveLoadManager.loadFromFile(loaded, path));
+        verifyProject(original, loaded);
+    }
+
+    void saveLeavesProjectUnchanged() {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+
+        // Two identical frames with their own buffers are stored once but stay separate in the project
+        FrameManager manager(4, 4);
+        manager.addFrame();
+        manager.addFrame();
+        QVERIFY(manager.frames[0].storageKey() != manager.frames[1].storageKey());
+
+        SaveLoadManager saveLoadManager;
+        QVERIFY(saveLoadManager.saveToFile(manager, directory.filePath("project.ssp")));
+        QVERIFY(saveLoadManager.saveToBinaryFile(manager, directory.filePath("project.bin.ssp")));
+        QCOMPARE(saveLoadManager.lastSaveDedup().uniqueFrameCount, 1);
+        QVERIFY(manager.frames[0].storageKey() != manager.frames[1].storageKey());
+
+        FrameManager empty(4, 4);
+        QVERIFY(!saveLoadManager.saveToFile(empty, directory.filePath("empty.ssp")));
+        QVERIFY(!saveLoadManager.saveToBinaryFile(empty, directory.filePath("empty.bin.ssp")));
+    }
+
+    void binaryHostileHeader_data() {
+        QTest::addColumn<QByteArray>("data");
+
+        QTest::newRow("huge sides") << binaryHeader(0x7fffffff, 0x7fffffff, 1, 1, 64);
+        QTest::newRow("negative side") << binaryHeader(-4, 4, 1, 1, 64);
+        QTest::newRow("too many pixels") << binaryHeader(16384, 16384, 1, 1, 64);
+        QTest::newRow("frame count past the data") << binaryHeader(4, 4, 0xffffffffu, 0xffffffffu, 64);
+        QTest::newRow("distinct frames past the data") << binaryHeader(4, 4, 1000, 1000, 2 * 1000 * 4 + 64);
+        QTest::newRow("partial frame") << binaryHeader(4, 4, 1, 1, 2 * 4 + 63);
+    }
+
+    void binaryHostileHeader() {
+        QFETCH(QByteArray, data);
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("hostile.ssp");
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(data);
+        file.close();
+
+        SaveLoadManager saveLoadManager;
+        QStringList problems;
+        QVERIFY(!saveLoadManager.validateFile(path, problems));
+        QVERIFY(!problems.isEmpty());
+
+        // A rejected file leaves the loaded frames alone
+        FrameManager manager(3, 3);
+        manager.addFrame();
+        QVERIFY(!saveLoadManager.loadFromFile(manager, path));
+        QCOMPARE(manager.frames.size(), size_t(1));
+        QCOMPARE(manager.height, 3);
+    }
+
+    void jsonPixelOutsideSpriteFailsToLoad() {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("broken.ssp");
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(R"({"height": 2, "width": 2, "frames": [{"pixels": [{"x": 5, "y": 0, "r": 0, "g": 0, "b": 0, "a": 255}]}]})");
+        file.close();
+
+        // The file is reported as failed rather than throwing, and the frames already loaded stay
+        FrameManager manager(3, 3);
+        manager.addFrame();
+        SaveLoadManager saveLoadManager;
+        QVERIFY(!saveLoadManager.loadFromFile(manager, path));
+        QCOMPARE(manager.frames.size(), size_t(1));
+        QCOMPARE(manager.height, 3);
+    }
+
+    void jsonOversizedSpriteFailsToLoad_data() {
+        QTest::addColumn<QByteArray>("json");
+
+        QTest::newRow("huge sides") << QByteArray(R"({"height": 100000, "width": 100000, "frames": [{"pixels": []}]})");
+        QTest::newRow("many blank frames") << QByteArray(R"({"height": 4096, "width": 4096, "frames": [{}, {}, {}, {}]})");
+    }
+
+    void jsonOversizedSpriteFailsToLoad() {
+        QFETCH(QByteArray, json);
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("oversized.ssp");
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(json);
+        file.close();
+
+        // Rejected before any frame is allocated
+        SaveLoadManager saveLoadManager;
+        QStringList problems;
+        QVERIFY(!saveLoadManager.validateFile(path, problems));
+
+        FrameManager manager(3, 3);
+        manager.addFrame();
+        QVERIFY(!saveLoadManager.loadFromFile(manager, path));
+        QCOMPARE(manager.frames.size(), size_t(1));
+    }
+
+    void blendSpanMatchesScalar_data() {
+        QTest::addColumn<int>("mode");
+
+        const char* names[] = {"Replace", "Normal", "Multiply", "Screen", "Add", "AlphaLock"};
+
+        for (int mode = PixelBlend::Replace; mode <= PixelBlend::AlphaLock; ++mode) {
+            QTest::newRow(names[mode]) << mode;
+        }
+    }
+
+    void blendSpanMatchesScalar() {
+        QFETCH(int, mode);
+        PixelBlend::Mode blendMode = static_cast<PixelBlend::Mode>(mode);
+        vector<QRgb> pixels(1027);
+        QRandomGenerator(1).fillRange(pixels.data(), static_cast<qsizetype>(pixels.size()));
+
+        // The vector kernel must match the scalar reference bit for bit, for every tail length and paint alpha
+        for (int count : {0, 1, 3, 4, 7, 1027}) {
+            for (QRgb paint : {qRgba(200, 120, 40, 160), qRgba(0, 0, 0, 0), qRgba(255, 255, 255, 255), qRgba(13, 250, 77, 1)}) {
+                vector<QRgb> expected = pixels;
+                vector<QRgb> actual = pixels;
+                PixelBlend::blendSpanScalar(expected.data(), count, paint, blendMode);
+                PixelBlend::blendSpan(actual.data(), count, paint, blendMode);
+                QVERIFY2(expected == actual, qPrintable(QString("%1 pixels of %2").arg(count).arg(paint, 8, 16)));
+            }
+        }
+
+        // Replace writes the paint as it is; normal blending of an opaque paint covers the pixel
+        QCOMPARE(PixelBlend::blend(qRgba(1, 2, 3, 4), qRgba(10, 20, 30, 0), PixelBlend::Replace), qRgba(10, 20, 30, 0));
+        QCOMPARE(PixelBlend::blend(qRgba(1, 2, 3, 255), qRgba(10, 20, 30, 255), PixelBlend::Normal), qRgba(10, 20, 30, 255));
+    }
+
+    void interpolateSpanMatchesScalar() {
+        vector<QRgb> first(1027);
+        vector<QRgb> second(1027);
+        QRandomGenerator(1).fillRange(first.data(), static_cast<qsizetype>(first.size()));
+        QRandomGenerator(2).fillRange(second.data(), static_cast<qsizetype>(second.size()));
+
+        // The vector cross-fade must match the scalar reference bit for bit, including the tail
+        for (int count : {1, 3, 4, 7, 1027}) {
+            for (int weight : {0, 1, 100, 128, 255, 256}) {
+                vector<QRgb> expected(count);
+                vector<QRgb> actual(count);
+                PixelBlend::interpolateSpanScalar(expected.data(), first.data(), second.data(), count, weight);
+                PixelBlend::interpolateSpan(actual.data(), first.data(), second.data(), count, weight);
+                QVERIFY2(expected == actual, qPrintable(QString("%1 pixels at weight %2").arg(count).arg(weight)));
+            }
+        }
+
+        // The ends of the range take one run entirely; fully transparent results are transparent white
+        QRgb opaque = qRgba(10, 20, 30, 255);
+        QRgb clear = qRgba(0, 0, 0, 0);
+        QRgb mixed;
+        PixelBlend::interpolateSpan(&mixed, &opaque, &clear, 1, 0);
+        QCOMPARE(mixed, opaque);
+        PixelBlend::interpolateSpan(&mixed, &opaque, &clear, 1, 256);
+        QCOMPARE(mixed, qRgba(255, 255, 255, 0));
+    }
+
+    void ditherSpanPicksEitherRun() {
+        vector<QRgb> first(16, qRgba(255, 0, 0, 255));
+        vector<QRgb> second(16, qRgba(0, 0, 255, 255));
+        vector<QRgb> target(16);
+        int fromSecond = 0;
+
+        // Half weight over a 4x4 tile takes exactly half of the pixels from each run, never a mix
+        for (int y = 0; y < 4; ++y) {
+            PixelBlend::ditherSpan(target.data(), first.data(), second.data(), 4, 128, 0, y);
+
+            for (int x = 0; x < 4; ++x) {
+                QVERIFY(target[x] == first[x] || target[x] == second[x]);
+                fromSecond += (target[x] == second[x]) ? 1 : 0;
+            }
+        }
+        QCOMPARE(fromSecond, 8);
+
+        PixelBlend::ditherSpan(target.data(), first.data(), second.data(), 16, 0, 0, 0);
+        QVERIFY(target == first);
+        PixelBlend::ditherSpan(target.data(), first.data(), second.data(), 16, 256, 0, 0);
+        QVERIFY(target == second);
+    }
+
+    void playbackTimeline() {
+        PlaybackTimeline timeline({0, 100, 0, 5}, 50);
+        QCOMPARE(timeline.frameCount(), 4);
+        QCOMPARE(timeline.totalDuration(), qint64(205));
+
+        for (int i = 0; i < timeline.frameCount(); ++i) {
+            QCOMPARE(timeline.frameAt(timeline.frameStart(i)), i);
+            QCOMPARE(timeline.frameAt(timeline.frameEnd(i) - 1), i);
+        }
+
+        // Times before and after the animation clamp; looped times wrap in both directions
+        QCOMPARE(timeline.frameAt(-3), 0);
+        QCOMPARE(timeline.frameAt(9999), 3);
+        QCOMPARE(timeline.frameAtLooped(205 * 7 + 50), 1);
+        QCOMPARE(timeline.frameAtLooped(-1), 3);
+        QCOMPARE(PlaybackTimeline().frameAt(0), -1);
+    }
+
+    void playbackTimelineSeeksLongAnimations() {
+        vector<int> durations(10000);
+
+        for (int i = 0; i < 10000; ++i) {
+            durations[i] = (i % 3 == 0) ? 0 : 40 + i % 7;
+        }
+
+        PlaybackTimeline timeline(durations, 83);
+
+        // Every seek must land in the frame whose span holds the time, across any number of loops
+        for (int i = 0; i < timeline.frameCount(); ++i) {
+            QCOMPARE(timeline.frameAt(timeline.frameStart(i)), i);
+            QCOMPARE(timeline.frameAt(timeline.frameEnd(i) - 1), i);
+            QCOMPARE(timeline.frameAtLooped(timeline.frameStart(i) + 1000 * timeline.totalDuration()), i);
+        }
+    }
+
+    void floodFillStopsAtBorders() {
+        QImage image = filledImage(8, 8, qRgb(255, 255, 255));
+        PixelBlit::fill(image, QRect(4, 0, 1, 8), qRgb(0, 0, 0));
+        image.setPixel(2, 2, qRgb(250, 255, 255));
+
+        // A contiguous fill stays left of the wall and skips the off-white pixel without tolerance
+        QCOMPARE(FloodFill::fill(image, QPoint(1, 1), qRgb(255, 0, 0), 0, FloodFill::Contiguous), QRect(0, 0, 4, 8));
+        QCOMPARE(image.pixel(0, 7), qRgb(255, 0, 0));
+        QCOMPARE(image.pixel(2, 2), qRgb(250, 255, 255));
+        QCOMPARE(image.pixel(4, 3), qRgb(0, 0, 0));
+        QCOMPARE(image.pixel(5, 3), qRgb(255, 255, 255));
+
+        // A global fill reaches every white pixel past the wall; seeds outside the image change nothing
+        QCOMPARE(FloodFill::fill(image, QPoint(7, 7), qRgb(0, 0, 255), 0, FloodFill::Global), QRect(5, 0, 3, 8));
+        QCOMPARE(image.pixel(5, 0), qRgb(0, 0, 255));
+        QCOMPARE(image.pixel(2, 2), qRgb(250, 255, 255));
+        QCOMPARE(FloodFill::fill(image, QPoint(8, 0), qRgb(0, 0, 255), 0, FloodFill::Global), QRect());
+
+        // Within the tolerance the off-white pixel is part of the region
+        QImage soft = filledImage(4, 4, qRgb(255, 255, 255));
+        soft.setPixel(2, 2, qRgb(250, 255, 255));
+        QCOMPARE(FloodFill::fill(soft, QPoint(0, 0), qRgb(0, 255, 0), 5, FloodFill::Contiguous), soft.rect());
+        QCOMPARE(soft.pixel(2, 2), qRgb(0, 255, 0));
+    }
+
+    void floodFillBlendsEachPixelOnce() {
+        QImage image = filledImage(8, 8, qRgb(255, 255, 255));
+        QRgb paint = qRgba(0, 0, 0, 128);
+        QRgb blended = PixelBlend::blend(qRgb(255, 255, 255), paint, PixelBlend::Normal);
+
+        // Every blended result still matches at full tolerance, so the fill must remember what it painted
+        QCOMPARE(FloodFill::fill(image, QPoint(3, 3), paint, 255, FloodFill::Contiguous, PixelBlend::Normal), image.rect());
+
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                QCOMPARE(image.pixel(x, y), blended);
+            }
+        }
+    }
+
+    void shapeRasterizerOutlines() {
+        // A shallow line has one pixel per column, from end to end
+        vector<PixelSpan> line = ShapeRasterizer::line(QPoint(0, 0), QPoint(6, 2));
+        QCOMPARE(ShapeRasterizer::bounds(line), QRect(0, 0, 7, 3));
+        QCOMPARE(spanPixels(line), 7);
+
+        vector<PixelSpan> outline = ShapeRasterizer::rectangle(QPoint(5, 4), QPoint(1, 1), false);
+        QCOMPARE(ShapeRasterizer::bounds(outline), QRect(1, 1, 5, 4));
+        QCOMPARE(spanPixels(outline), 14);
+        QCOMPARE(spanPixels(ShapeRasterizer::rectangle(QPoint(1, 1), QPoint(5, 4), true)), 20);
+
+        // Ellipses fill their box exactly and are mirror images across both center lines
+        for (QRect box : {QRect(QPoint(2, 1), QPoint(12, 8)), QRect(QPoint(0, 0), QPoint(9, 5))}) {
+            QCOMPARE(ShapeRasterizer::bounds(ShapeRasterizer::ellipse(box.topLeft(), box.bottomRight(), false)), box);
+
+            vector<PixelSpan> filled = ShapeRasterizer::ellipse(box.bottomRight(), box.topLeft(), true);
+            QCOMPARE(ShapeRasterizer::bounds(filled), box);
+            QCOMPARE(filled.size(), size_t(box.height()));
+
+            for (size_t i = 0; i < filled.size(); ++i) {
+                const PixelSpan& mirrored = filled[filled.size() - 1 - i];
+                QCOMPARE(filled[i].left + filled[i].right, box.left() + box.right());
+                QCOMPARE(filled[i].left, mirrored.left);
+                QCOMPARE(filled[i].right, mirrored.right);
+            }
+        }
+    }
+
+    void shapeRasterizerPaintClips() {
+        QImage image = filledImage(4, 4, qRgba(0, 0, 0, 0));
+        vector<PixelSpan> spans = ShapeRasterizer::rectangle(QPoint(-2, -2), QPoint(3, 1), true);
+
+        QCOMPARE(ShapeRasterizer::paint(image, spans, qRgb(9, 8, 7)), QRect(0, 0, 4, 2));
+        QCOMPARE(image.pixel(3, 1), qRgb(9, 8, 7));
+        QCOMPARE(image.pixel(3, 2), qRgba(0, 0, 0, 0));
+    }
+
+    void pixelBlitClipsToImages() {
+        QImage source = filledImage(4, 4, qRgba(0, 0, 0, 0));
+        source.setPixel(0, 0, qRgb(1, 2, 3));
+        source.setPixel(1, 1, qRgb(4, 5, 6));
+
+        // Parts of the region outside the source come back transparent
+        QImage copy = PixelBlit::copy(source, QRect(-1, -1, 3, 3));
+        QCOMPARE(copy.size(), QSize(3, 3));
+        QCOMPARE(copy.pixel(0, 0), qRgba(0, 0, 0, 0));
+        QCOMPARE(copy.pixel(1, 1), qRgb(1, 2, 3));
+        QCOMPARE(copy.pixel(2, 2), qRgb(4, 5, 6));
+
+        QImage target = filledImage(4, 4, qRgb(255, 255, 255));
+        QCOMPARE(PixelBlit::paste(target, copy, QPoint(2, 2)), QRect(2, 2, 2, 2));
+        QCOMPARE(target.pixel(3, 3), qRgb(1, 2, 3));
+        QCOMPARE(target.pixel(2, 2), qRgba(0, 0, 0, 0));
+        QCOMPARE(PixelBlit::paste(target, copy, QPoint(4, 0)), QRect());
+
+        QCOMPARE(PixelBlit::fill(target, QRect(-5, 1, 100, 1), qRgb(7, 7, 7)), QRect(0, 1, 4, 1));
+        QCOMPARE(target.pixel(0, 1), qRgb(7, 7, 7));
+        QCOMPARE(target.pixel(3, 1), qRgb(7, 7, 7));
+    }
+
+    void brushStampMasks() {
+        BrushStamp roundBrush(BrushStamp::Round, 5);
+        QCOMPARE(roundBrush.spans().size(), size_t(5));
+        QCOMPARE(spanPixels(roundBrush.spans()), 21);
+
+        // Even sizes reach one pixel further right and down
+        BrushStamp squareBrush(BrushStamp::Square, 4);
+        QCOMPARE(ShapeRasterizer::bounds(squareBrush.spans()), QRect(-1, -1, 4, 4));
+        QCOMPARE(BrushStamp(BrushStamp::Square, 100).size(), BrushStamp::maximumSize);
+    }
+
+    void brushStampMirrorsAndCovers() {
+        QImage image = filledImage(8, 6, qRgba(0, 0, 0, 0));
+        QRegion region = BrushStamp(BrushStamp::Square, 1).stamp(image, QPoint(1, 1), qRgb(255, 0, 0), BrushStamp::BothAxes);
+        QCOMPARE(region.rectCount(), 4);
+        QCOMPARE(image.pixel(1, 1), qRgb(255, 0, 0));
+        QCOMPARE(image.pixel(6, 1), qRgb(255, 0, 0));
+        QCOMPARE(image.pixel(1, 4), qRgb(255, 0, 0));
+        QCOMPARE(image.pixel(6, 4), qRgb(255, 0, 0));
+
+        // Overlapping stamps of a stroke blend each pixel once when the covered flags are passed
+        QImage canvas = filledImage(10, 6, qRgb(255, 255, 255));
+        QRgb paint = qRgba(0, 0, 0, 128);
+        vector<quint8> covered(static_cast<size_t>(canvas.width()) * canvas.height(), 0);
+        region = BrushStamp(BrushStamp::Square, 3).stroke(canvas, QPoint(2, 2), QPoint(5, 2), paint, BrushStamp::NoSymmetry,
+                                                          PixelBlend::Normal, &covered);
+        QCOMPARE(region.boundingRect(), QRect(1, 1, 6, 3));
+
+        QRgb blended = PixelBlend::blend(qRgb(255, 255, 255), paint, PixelBlend::Normal);
+
+        for (int y = 1; y <= 3; ++y) {
+            for (int x = 1; x <= 6; ++x) {
+                QCOMPARE(canvas.pixel(x, y), blended);
+            }
+        }
+        QCOMPARE(canvas.pixel(7, 2), qRgb(255, 255, 255));
+    }
+
+    void resamplerScalesPixelArt() {
+        const QRgb a = qRgb(200, 0, 0);
+        const QRgb b = qRgb(0, 0, 200);
+        Frame checker = frameFromRows({{a, b}, {b, a}});
+
+        // Nearest repeats whole pixels; Scale2x rounds off the diagonal staircase
+        Frame nearest = SpriteResampler::scale(checker, 4, 4, SpriteResampler::Nearest);
+        QVERIFY(nearest.hasSamePixels(frameFromRows({{a, a, b, b}, {a, a, b, b}, {b, b, a, a}, {b, b, a, a}})));
+
+        Frame smoothed = SpriteResampler::scale(checker, 4, 4, SpriteResampler::Scale2x);
+        QVERIFY(smoothed.hasSamePixels(frameFromRows({{a, a, b, b}, {a, b, a, b}, {b, a, b, a}, {b, b, a, a}})));
+
+        // Scale3x runs while it fits and nearest sampling covers the rest of the size
+        Frame larger = SpriteResampler::scale(checker, 7, 7, SpriteResampler::Scale3x);
+        QCOMPARE(larger.getHeight(), 7);
+        QCOMPARE(larger.getWidth(), 7);
+        QCOMPARE(larger.constScanLine(0)[0], a);
+
+        // Box shrinking averages premultiplied, so transparent pixels do not darken the result
+        const QRgb clear = qRgba(255, 255, 255, 0);
+        Frame shrunk = SpriteResampler::scale(frameFromRows({{qRgb(255, 0, 0), clear}, {clear, qRgb(0, 0, 255)}}), 1, 1,
+                                              SpriteResampler::Box);
+        QCOMPARE(shrunk.constScanLine(0)[0], qRgba(128, 0, 128, 128));
+    }
+
+    void resamplerMovesCanvas() {
+        const QRgb a = qRgb(1, 2, 3);
+        const QRgb b = qRgb(4, 5, 6);
+        const QRgb clear = qRgba(255, 255, 255, 0);
+        Frame frame = frameFromRows({{a, b}, {b, a}});
+
+        QCOMPARE(SpriteResampler::anchorOffset(QSize(2, 2), QSize(5, 4), SpriteResampler::BottomRight), QPoint(3, 2));
+        QVERIFY(SpriteResampler::resizeCanvas(frame, 4, 4, SpriteResampler::Center).hasSamePixels(
+            frameFromRows({{clear, clear, clear, clear}, {clear, a, b, clear}, {clear, b, a, clear}, {clear, clear, clear, clear}})));
+        QVERIFY(SpriteResampler::resizeCanvas(frame, 1, 1, SpriteResampler::TopLeft).hasSamePixels(frameFromRows({{a}})));
+        QVERIFY(SpriteResampler::translate(frame, QPoint(1, -1)).hasSamePixels(frameFromRows({{clear, b}, {clear, clear}})));
+    }
+
+    void inbetweensBlendKeyFrames() {
+        Frame first(4, 8);
+        Frame second(4, 8);
+        QRandomGenerator(4).fillRange(first.scanLine(0), 4 * 8);
+        QRandomGenerator(5).fillRange(second.scanLine(0), 4 * 8);
+
+        // Three in-betweens take a quarter, half and three quarters of the second key frame
+        vector<Frame> faded = InbetweenGenerator::generate(first, second, 3, InbetweenGenerator::CrossFade);
+        QCOMPARE(faded.size(), size_t(3));
+        Frame half = Frame::allocate(4, 8);
+        PixelBlend::interpolateSpanScalar(half.scanLine(0), first.constScanLine(0), second.constScanLine(0), 4 * 8, 128);
+        QVERIFY(faded[1].hasSamePixels(half));
+
+        // Dithering only ever picks whole pixels from a key frame
+        vector<Frame> dithered = InbetweenGenerator::generate(first, second, 3, InbetweenGenerator::Dither);
+        QCOMPARE(dithered.size(), size_t(3));
+
+        for (const Frame& frame : dithered) {
+            for (int i = 0; i < 4 * 8; ++i) {
+                QRgb pixel = frame.constScanLine(0)[i];
+                QVERIFY(pixel == first.constScanLine(0)[i] || pixel == second.constScanLine(0)[i]);
+            }
+        }
+
+        QVERIFY(InbetweenGenerator::generate(first, Frame(4, 7), 3, InbetweenGenerator::CrossFade).empty());
+    }
+
+    void inbetweensTranslate() {
+        Frame key(4, 8);
+        key.updateFrame(0, 0, 10, 20, 30, 255);
+
+        // Each of three in-betweens moves a quarter of the way towards the offset
+        vector<Frame> moved = InbetweenGenerator::generate(key, Frame(4, 8), 3, InbetweenGenerator::Translate, QPoint(8, 0));
+        QCOMPARE(moved.size(), size_t(3));
+        QCOMPARE(moved[0].constScanLine(0)[2], qRgba(10, 20, 30, 255));
+        QCOMPARE(moved[2].constScanLine(0)[6], qRgba(10, 20, 30, 255));
+        QCOMPARE(moved[2].constScanLine(0)[0], qRgba(255, 255, 255, 0));
+    }
+
+    void gifExportDecodes() {
+        if (!QImageReader::supportedImageFormats().contains("gif")) {
+            QSKIP("Qt was built without the GIF reader");
+        }
+
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("animation.gif");
+
+        // Random pixels from 40 colors and transparency fill the LZW code table more than once per frame
+        FrameManager manager(64, 96);
+        QRandomGenerator random(6);
+
+        for (int i = 0; i < 3; ++i) {
+            Frame frame(manager.height, manager.width);
+            QRgb* pixels = frame.scanLine(0);
+
+            for (int p = 0; p < manager.height * manager.width; ++p) {
+                int color = random.bounded(41);
+                pixels[p] = (color == 40) ? qRgba(255, 255, 255, 0) : qRgb(color * 6, 255 - color * 6, color * 37 % 256);
+            }
+            manager.addFrameJson(frame);
+        }
+
+        GifExporter exporter;
+        QVERIFY(exporter.exportToFile(manager, path, 10));
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QByteArray data = file.readAll();
+        file.close();
+        QVERIFY(data.startsWith("GIF89a"));
+        QVERIFY(data.endsWith(';'));
+
+        // Qt's own decoder checks the LZW stream, the frame differences and the disposal methods together
+        QImageReader reader(path);
+
+        for (size_t i = 0; i < manager.frames.size(); ++i) {
+            QImage decoded = reader.read();
+            QVERIFY2(!decoded.isNull(), qPrintable(reader.errorString()));
+            decoded = decoded.convertToFormat(QImage::Format_ARGB32);
+            QCOMPARE(decoded.size(), QSize(manager.width, manager.height));
+
+            int wrongPixels = 0;
+
+            for (int y = 0; y < manager.height; ++y) {
+                for (int x = 0; x < manager.width; ++x) {
+                    QRgb expected = manager.frames[i].constScanLine(y)[x];
+                    QRgb actual = decoded.pixel(x, y);
+                    bool same = (qAlpha(expected) == 0) ? qAlpha(actual) == 0 : actual == expected;
+                    wrongPixels += same ? 0 : 1;
+                }
+            }
+            QVERIFY2(wrongPixels == 0, qPrintable(QString("%1 wrong pixels in frame %2").arg(wrongPixels).arg(i)));
+        }
+    }
+
+    void spriteSheetPacksTrimmedFrames() {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString imagePath = directory.filePath("sheet.png");
+        QString metadataPath = directory.filePath("sheet.json");
+
+        // Trimmed sizes differ, frame 2 repeats frame 0 elsewhere on the canvas and frame 3 is blank
+        const QRect areas[] = {QRect(2, 3, 5, 4), QRect(0, 0, 16, 12), QRect(9, 6, 5, 4), QRect(), QRect(1, 1, 3, 9)};
+        const int patterns[] = {1, 2, 1, 0, 3};
+        FrameManager manager(12, 16);
+
+        for (int i = 0; i < 5; ++i) {
+            Frame frame(manager.height, manager.width);
+
+            for (int y = 0; y < areas[i].height(); ++y) {
+                for (int x = 0; x < areas[i].width(); ++x) {
+                    frame.scanLine(areas[i].top() + y)[areas[i].left() + x] = qRgb(x * 15, y * 20, patterns[i] * 60);
+                }
+            }
+            manager.addFrameJson(frame);
+        }
+
+        SpriteSheetExporter exporter;
+        QVERIFY(exporter.exportToFile(manager, imagePath, metadataPath, 1));
+
+        QFile metadataFile(metadataPath);
+        QVERIFY(metadataFile.open(QIODevice::ReadOnly));
+        QJsonObject root = QJsonDocument::fromJson(metadataFile.readAll()).object();
+        QJsonArray frames = root["frames"].toArray();
+        QCOMPARE(frames.size(), qsizetype(5));
+
+        QImage atlas = QImage(imagePath).convertToFormat(QImage::Format_ARGB32);
+        QCOMPARE(atlas.width(), root["width"].toInt());
+        QCOMPARE(atlas.height(), root["height"].toInt());
+
+        vector<QRect> packed;
+
+        for (int i = 0; i < 5; ++i) {
+            QJsonObject entry = frames[i].toObject();
+            QRect bounds(entry["offsetX"].toInt(), entry["offsetY"].toInt(), entry["w"].toInt(), entry["h"].toInt());
+            QPoint position(entry["x"].toInt(), entry["y"].toInt());
+            QCOMPARE(bounds, areas[i].isEmpty() ? QRect(0, 0, 1, 1) : areas[i]);
+
+            if (i == 2) {
+                QCOMPARE(entry["duplicateOf"].toInt(), 0);
+                QCOMPARE(position, QPoint(frames[0].toObject()["x"].toInt(), frames[0].toObject()["y"].toInt()));
+                continue;
+            }
+
+            QCOMPARE(entry["duplicateOf"].toInt(), i);
+
+            // Unique frames lie inside the atlas without overlapping, padding included
+            QRect padded(position, bounds.size() + QSize(1, 1));
+            QVERIFY(atlas.rect().contains(QRect(position, bounds.size())));
+
+            for (const QRect& other : packed) {
+                QVERIFY2(!padded.intersects(other), qPrintable(QString("frame %1 overlaps another").arg(i)));
+            }
+            packed.push_back(padded);
+
+            for (int y = 0; y < bounds.height(); ++y) {
+                for (int x = 0; x < bounds.width(); ++x) {
+                    QRgb expected = manager.frames[i].constScanLine(bounds.top() + y)[bounds.left() + x];
+                    QRgb actual = atlas.pixel(position.x() + x, position.y() + y);
+                    QVERIFY(actual == expected || (qAlpha(actual) == 0 && qAlpha(expected) == 0));
+                }
+            }
+        }
+    }
+
+    void importerFindsGutterCells() {
+        QImage sheet = filledImage(20, 14, qRgba(0, 0, 0, 0));
+        PixelBlit::fill(sheet, QRect(1, 1, 4, 5), qRgb(255, 0, 0));
+        PixelBlit::fill(sheet, QRect(8, 2, 6, 3), qRgb(0, 255, 0));
+        PixelBlit::fill(sheet, QRect(2, 9, 3, 4), qRgb(0, 0, 255));
+
+        // The empty cell where the last row and column cross is skipped
+        vector<QRect> expected = {QRect(1, 1, 4, 5), QRect(8, 1, 6, 5), QRect(1, 9, 4, 4)};
+        QVERIFY(ImageImporter::detectCells(sheet) == expected);
+
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("sheet.png");
+        QVERIFY(sheet.save(path, "PNG"));
+
+        // Every frame takes the largest cell's size, with smaller cells centered in it
+        ImageImporter importer;
+        vector<Frame> frames;
+        QVERIFY(importer.importSheet(path, ImageImporter::Gutters, 0, 0, frames));
+        QCOMPARE(frames.size(), size_t(3));
+        QCOMPARE(frames[0].getHeight(), 5);
+        QCOMPARE(frames[0].getWidth(), 6);
+        QCOMPARE(frames[0].constScanLine(0)[1], qRgb(255, 0, 0));
+        QCOMPARE(qAlpha(frames[0].constScanLine(0)[0]), 0);
+        QCOMPARE(frames[2].constScanLine(3)[2], qRgb(0, 0, 255));
+        QCOMPARE(qAlpha(frames[2].constScanLine(3)[1]), 0);
+        QCOMPARE(qAlpha(frames[2].constScanLine(4)[2]), 0);
+    }
+
+    void importerSlicesGrid() {
+        QImage sheet = filledImage(12, 8, qRgba(0, 0, 0, 0));
+        PixelBlit::fill(sheet, QRect(0, 0, 4, 4), qRgb(255, 0, 0));
+        PixelBlit::fill(sheet, QRect(5, 1, 2, 2), qRgb(0, 255, 0));
+        PixelBlit::fill(sheet, QRect(0, 4, 4, 4), qRgb(0, 0, 255));
+
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QString path = directory.filePath("grid.png");
+        QVERIFY(sheet.save(path, "PNG"));
+
+        // Blank cells keep their place inside the sheet but are dropped from its end
+        ImageImporter importer;
+        vector<Frame> frames;
+        QVERIFY(importer.importSheet(path, ImageImporter::Grid, 4, 4, frames));
+        QCOMPARE(frames.size(), size_t(4));
+        QCOMPARE(frames[1].constScanLine(1)[1], qRgb(0, 255, 0));
+        QCOMPARE(qAlpha(frames[2].constScanLine(0)[0]), 0);
+        QCOMPARE(frames[3].constScanLine(3)[3], qRgb(0, 0, 255));
+    }
+};
+
+QTEST_GUILESS_MAIN(SpriteCoreTests)
+
+#include "spritecoretests.moc"
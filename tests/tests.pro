@@ -0,0 +1,13 @@
+TEMPLATE = app
+TARGET = spritecoretests
+
+QT       += testlib
+
+# testcase lets "make check" from the top level run the suite
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../spritecore/spritecore.pri)
+
+SOURCES += \
+    spritecoretests.cpp